@@ -81,6 +81,8 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
   ("SEIpictureDigest", m_decodedPictureHashSEIEnabled, 1, "deprecated alias for SEIDecodedPictureHash")
   ("TarDecLayerIdSetFile,l", cfg_TargetDecLayerIdSetFile, string(""), "targetDecLayerIdSet file name. The file should include white space separated LayerId values to be decoded. Omitting the option or a value of -1 in the file decodes all layers.")
   ("RespectDefDispWindow,w", m_respectDefDispWindow, 0, "Only output content inside the default display window\n")
+  ("FrameParallel", m_bFrameParallel, false, "run the loop filters of a decoded picture on a thread while the next pictures are decoded")
+  ("ReconThread", m_bReconThread, false, "reconstruct the parsed LCUs on a thread while the next LCUs are parsed")
   ;
   po::setDefaults(opts);
   const list<const Char*>& argv_unhandled = po::scanArgv(opts, argc, (const Char**) argv);
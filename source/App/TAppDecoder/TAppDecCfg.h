@@ -67,6 +67,8 @@ protected:
 
   std::vector<Int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
   Int           m_respectDefDispWindow;               ///< Only output content inside the default display window 
+  Bool          m_bFrameParallel;                     ///< filter the decoded pictures on a thread while the next ones are decoded
+  Bool          m_bReconThread;                       ///< reconstruct the parsed LCUs on a thread while the next ones are parsed
 
 public:
   TAppDecCfg()
@@ -78,6 +80,8 @@ public:
   , m_iMaxTemporalLayer(-1)
   , m_decodedPictureHashSEIEnabled(0)
   , m_respectDefDispWindow(0)
+  , m_bFrameParallel(false)
+  , m_bReconThread(false)
   {}
   virtual ~TAppDecCfg() {}
   
@@ -100,6 +100,8 @@ Void TAppDecTop::decode()
   }
 
   InputByteStream bytestream(bitstreamFile);
+  // locate the NAL units directly in the mapped file, unless it cannot be mapped (e.g. a pipe)
+  bytestream.map(m_pchBitstreamFile);
 
   // create & initialize internal classes
   xCreateDecLib();
@@ -109,53 +111,49 @@ Void TAppDecTop::decode()
   // main decoder loop
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
 
-  while (!!bitstreamFile)
+  Bool bEof = false;
+  while (!bEof || m_cTDecTop.hasLookaheadNalu())
   {
-    /* location serves to work around a design fault in the decoder, whereby
-     * the process of reading a new slice that is the first slice of a new frame
-     * requires the TDecTop::decode() method to be called again with the same
-     * nal unit. */
-    streampos location = bitstreamFile.tellg();
     AnnexBStats stats = AnnexBStats();
 
     vector<uint8_t> nalUnit;
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalUnit, stats);
 
     // call actual decoding function
     Bool bNewPicture = false;
-    if (nalUnit.empty())
+    if (m_cTDecTop.hasLookaheadNalu())
     {
-      /* this can happen if the following occur:
-       *  - empty input file
-       *  - two back-to-back start_code_prefixes
-       *  - start_code_prefix immediately followed by EOF
-       */
-      fprintf(stderr, "Warning: Attempt to decode an empty NAL unit\n");
+      /* the first slice of a picture is found by the decoder while the previous picture
+       * is incomplete, it is kept by the decoder and decoded once the previous picture
+       * has been completed, without reading it again from the bitstream */
+      bNewPicture = m_cTDecTop.decodeLookaheadNalu(m_iSkipFrame, m_iPOCLastDisplay);
     }
     else
     {
-      read(nalu, nalUnit);
-      if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
+      bEof = byteStreamNALUnit(bytestream, nalUnit, stats);
+      if (nalUnit.empty())
       {
-        bNewPicture = false;
+        /* this can happen if the following occur:
+         *  - empty input file
+         *  - two back-to-back start_code_prefixes
+         *  - start_code_prefix immediately followed by EOF
+         */
+        fprintf(stderr, "Warning: Attempt to decode an empty NAL unit\n");
       }
       else
       {
-        bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
-        if (bNewPicture)
+        read(nalu, nalUnit);
+        if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
+          bNewPicture = false;
+        }
+        else
+        {
+          bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         }
       }
     }
-    if (bNewPicture || !bitstreamFile)
+    if (bNewPicture || bEof)
     {
       m_cTDecTop.executeLoopFilters(poc, pcListPic);
     }
@@ -221,6 +219,8 @@ Void TAppDecTop::xInitDecLib()
   // initialize decoder class
   m_cTDecTop.init();
   m_cTDecTop.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cTDecTop.setFrameParallel(m_bFrameParallel);
+  m_cTDecTop.setReconThread(m_bReconThread);
 }
 
 /** \param pcListPic list of pictures to be written to file
@@ -261,6 +261,11 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
       if ( pcPicTop->getOutputMark() && (numPicsNotYetDisplayed >  pcPicTop->getNumReorderPics(tId) && !(pcPicTop->getPOC()%2) && pcPicBottom->getPOC() == pcPicTop->getPOC()+1)
           && pcPicBottom->getOutputMark() && (numPicsNotYetDisplayed >  pcPicBottom->getNumReorderPics(tId) && (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay<0)))
       {
+        // with frame-parallel decoding the loop filters may still run, the pictures are written by a later call
+        if ( !pcPicTop->getPicYuvRec()->isReconComplete() || !pcPicBottom->getPicYuvRec()->isReconComplete() )
+        {
+          break;
+        }
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
         if ( m_pchReconFile )
@@ -323,6 +328,11 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
       
       if ( pcPic->getOutputMark() && (numPicsNotYetDisplayed >  pcPic->getNumReorderPics(tId) && pcPic->getPOC() > m_iPOCLastDisplay))
       {
+        // with frame-parallel decoding the loop filters may still run, the picture is written by a later call
+        if ( !pcPic->getPicYuvRec()->isReconComplete() )
+        {
+          break;
+        }
         // write to file
         numPicsNotYetDisplayed--;
         if ( m_pchReconFile )
@@ -374,6 +384,12 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
   }
   TComList<TComPic*>::iterator iterPic   = pcListPic->begin();
   
+  // the pictures are written and destroyed below, wait for the loop filters still running with frame-parallel decoding
+  while (iterPic != pcListPic->end())
+  {
+    (*(iterPic++))->getPicYuvRec()->waitReadyLines( MAX_INT );
+  }
+
   iterPic   = pcListPic->begin();
   TComPic* pcPic = *(iterPic);
   
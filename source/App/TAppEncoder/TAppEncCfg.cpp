@@ -402,6 +402,13 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   ("RowHeightArray",              cfg_RowHeight,                   string(""), "Array containing RowHeight values in units of LCU")
   ("LFCrossTileBoundaryFlag",      m_bLFCrossTileBoundaryFlag,             true,          "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",            m_iWaveFrontSynchro,             0,          "0: no synchro; 1 synchro with TR; 2 TRR etc")
+  ("FrameParallelism",            m_iFrameParallelism,             1,          "Max. number of pictures whose references are complete compressed concurrently, 1: off")
+  ("ParallelSplitDepth",          m_iParallelSplitDepth,           0,          "Number of CU depths, from the LCU down, whose split subtree is compressed concurrently with the unsplit modes, 0: off")
+  ("ParallelRefME",               m_bParallelRefME,                false,      "Run the uni-directional motion estimation of the reference pictures of a PU concurrently")
+  ("ParallelIntraModes",          m_bParallelIntraModes,           false,      "Check the intra luma mode candidates of a PU concurrently")
+  ("LookaheadDepth",              m_iLookaheadDepth,               0,          "Number of source pictures analyzed ahead of encoding on a background thread, 0: analyzed inline")
+  ("ReadAheadFrames",             m_iReadAheadFrames,              0,          "Number of source frames read and converted ahead of encoding on a background thread, 0: read synchronously")
+  ("WriteQueueSize",              m_iWriteQueueSize,               0,          "Number of access units queued for writing on a background thread, 0: written synchronously")
   ("ScalingList",                 m_useScalingListId,              0,          "0: no scaling list, 1: default scaling lists, 2: scaling lists specified in ScalingListFile")
   ("ScalingListFile",             cfg_ScalingListFile,             string(""), "Scaling list file name")
   ("SignHideFlag,-SBH",                m_signHideFlag, 1)
@@ -1332,6 +1339,12 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_iWaveFrontSynchro < 0, "WaveFrontSynchro cannot be negative" );
   xConfirmPara( m_iWaveFrontSubstreams <= 0, "WaveFrontSubstreams must be positive" );
   xConfirmPara( m_iWaveFrontSubstreams > 1 && !m_iWaveFrontSynchro, "Must have WaveFrontSynchro > 0 in order to have WaveFrontSubstreams > 1" );
+  xConfirmPara( m_iFrameParallelism < 1, "FrameParallelism must be positive" );
+  xConfirmPara( m_iFrameParallelism > 1 && m_uiDeltaQpRD > 0, "FrameParallelism cannot be used together with slice level multiple-QP optimization" );
+  xConfirmPara( m_iParallelSplitDepth < 0 || m_iParallelSplitDepth >= (Int)m_uiMaxCUDepth, "ParallelSplitDepth must be in the range of 0 to MaxPartitionDepth-1" );
+  xConfirmPara( m_iLookaheadDepth < 0, "LookaheadDepth must not be negative" );
+  xConfirmPara( m_iReadAheadFrames < 0, "ReadAheadFrames must not be negative" );
+  xConfirmPara( m_iWriteQueueSize < 0, "WriteQueueSize must not be negative" );
 
   xConfirmPara( m_decodedPictureHashSEIEnabled<0 || m_decodedPictureHashSEIEnabled>3, "this hash type is not correct!\n");
 
@@ -1358,6 +1371,7 @@ Void TAppEncCfg::xCheckParameter()
       }
     }
     xConfirmPara( m_uiDeltaQpRD > 0, "Rate control cannot be used together with slice level multiple-QP optimization!\n" );
+    xConfirmPara( m_iFrameParallelism > 1, "Rate control cannot be used together with FrameParallelism" );
   }
 #else
   if(m_enableRateCtrl)
@@ -1367,6 +1381,7 @@ Void TAppEncCfg::xCheckParameter()
     Int numLCUInPic    =  numLCUInWidth * numLCUInHeight;
 
     xConfirmPara( (numLCUInPic % m_numLCUInUnit) != 0, "total number of LCUs in a frame should be completely divided by NumLCUInUnit" );
+    xConfirmPara( m_iFrameParallelism > 1, "Rate control cannot be used together with FrameParallelism" );
 
     m_iMaxDeltaQP       = MAX_DELTA_QP;
     m_iMaxCuDQPDepth    = MAX_CUDQP_DEPTH;
@@ -1516,6 +1531,13 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d",
           m_iWaveFrontSynchro, m_iWaveFrontSubstreams);
+  printf(" FrameParallelism:%d", m_iFrameParallelism);
+  printf(" ParallelSplitDepth:%d", m_iParallelSplitDepth);
+  printf(" ParallelRefME:%d", m_bParallelRefME);
+  printf(" ParallelIntraModes:%d", m_bParallelIntraModes);
+  printf(" LookaheadDepth:%d", m_iLookaheadDepth);
+  printf(" ReadAheadFrames:%d", m_iReadAheadFrames);
+  printf(" WriteQueueSize:%d", m_iWriteQueueSize);
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
@@ -194,6 +194,13 @@ protected:
   UInt*     m_pRowHeight;
   Int       m_iWaveFrontSynchro; //< 0: no WPP. >= 1: WPP is enabled, the "Top right" from which inheritance occurs is this LCU offset in the line above the current.
   Int       m_iWaveFrontSubstreams; //< If iWaveFrontSynchro, this is the number of substreams per frame (dependent tiles) or per tile (independent tiles).
+  Int       m_iFrameParallelism;                              ///< max. number of pictures compressed concurrently, 1: one picture at a time
+  Int       m_iParallelSplitDepth;                            ///< number of CU depths whose split subtree is compressed concurrently, 0: off
+  Bool      m_bParallelRefME;                                 ///< uni-directional ME of the reference pictures of a PU runs concurrently
+  Bool      m_bParallelIntraModes;                            ///< intra luma mode candidates of a PU are checked concurrently
+  Int       m_iLookaheadDepth;                                ///< number of source pictures analyzed ahead of encoding on a background thread, 0: inline
+  Int       m_iReadAheadFrames;                               ///< number of source frames read ahead of encoding on a background thread, 0: read synchronously
+  Int       m_iWriteQueueSize;                                ///< number of access units waiting for the bitstream writer thread, 0: written synchronously
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   
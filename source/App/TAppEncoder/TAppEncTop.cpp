@@ -59,6 +59,8 @@ TAppEncTop::TAppEncTop()
   m_iFrameRcvd = 0;
   m_totalBytes = 0;
   m_essentialBytes = 0;
+  m_pcWriterFile = NULL;
+  m_bWriterExit = false;
 }
 
 TAppEncTop::~TAppEncTop()
@@ -280,6 +282,11 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setLFCrossTileBoundaryFlag( m_bLFCrossTileBoundaryFlag );
   m_cTEncTop.setWaveFrontSynchro           ( m_iWaveFrontSynchro );
   m_cTEncTop.setWaveFrontSubstreams        ( m_iWaveFrontSubstreams );
+  m_cTEncTop.setFrameParallelism           ( m_iFrameParallelism );
+  m_cTEncTop.setParallelSplitDepth         ( m_iParallelSplitDepth );
+  m_cTEncTop.setParallelRefME              ( m_bParallelRefME );
+  m_cTEncTop.setParallelIntraModes         ( m_bParallelIntraModes );
+  m_cTEncTop.setLookaheadDepth             ( m_iLookaheadDepth );
   m_cTEncTop.setTMVPModeId ( m_TMVPModeId );
   m_cTEncTop.setUseScalingListId           ( m_useScalingListId  );
   m_cTEncTop.setScalingListFile            ( m_scalingListFile   );
@@ -390,6 +397,12 @@ Void TAppEncTop::encode()
   xCreateLib();
   xInitLib(m_isField);
   
+  // write the access units on a background thread
+  if ( m_iWriteQueueSize > 0 )
+  {
+    xStartWriter(bitstreamFile);
+  }
+  
   // main encoder loop
   Int   iNumEncoded = 0;
   Bool  bEos = false;
@@ -406,13 +419,30 @@ Void TAppEncTop::encode()
     pcPicYuvOrg->create( m_iSourceWidth, m_iSourceHeight, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxCUDepth );
   }
   
+  // read and convert the input frames on a background thread
+  if ( m_iReadAheadFrames > 0 )
+  {
+    m_cTVideoIOYuvInputReader.create( &m_cTVideoIOYuvInputFile, m_iReadAheadFrames, m_isField ? m_framesToBeEncoded >> 1 : m_framesToBeEncoded,
+                                      pcPicYuvOrg->getWidth(), pcPicYuvOrg->getHeight(), m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxCUDepth, m_aiPad );
+  }
+  
   while ( !bEos )
   {
     // get buffers
     xGetBuffer(pcPicYuvRec);
 
     // read input YUV file
-    m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, m_aiPad );
+    TComPicYuv* pcPicYuvIn = pcPicYuvOrg;
+    Bool        bEof;
+    if ( m_iReadAheadFrames > 0 )
+    {
+      pcPicYuvIn = m_cTVideoIOYuvInputReader.pop( bEof );
+    }
+    else
+    {
+      m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, m_aiPad );
+      bEof = m_cTVideoIOYuvInputFile.isEof();
+    }
     
     // increase number of received frames
     m_iFrameRcvd++;
@@ -420,7 +450,7 @@ Void TAppEncTop::encode()
     bEos = (m_isField && (m_iFrameRcvd == (m_framesToBeEncoded >> 1) )) || ( !m_isField && (m_iFrameRcvd == m_framesToBeEncoded) );
     Bool flush = 0;
     // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-    if (m_cTVideoIOYuvInputFile.isEof())
+    if (bEof)
     {
       flush = true;
       bEos = true;
@@ -431,11 +461,17 @@ Void TAppEncTop::encode()
     // call encoding function for one frame
     if ( m_isField )
     {
-      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, m_cListPicYuvRec, outputAccessUnits, iNumEncoded, m_isTopFieldFirst);
+      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvIn, m_cListPicYuvRec, outputAccessUnits, iNumEncoded, m_isTopFieldFirst);
     }
     else
     {
-      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, m_cListPicYuvRec, outputAccessUnits, iNumEncoded );
+      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvIn, m_cListPicYuvRec, outputAccessUnits, iNumEncoded );
+    }
+    
+    // the encoder has copied the frame, its buffer can be read again
+    if ( m_iReadAheadFrames > 0 )
+    {
+      m_cTVideoIOYuvInputReader.release();
     }
     
     // write bistream to file if necessary
@@ -448,6 +484,15 @@ Void TAppEncTop::encode()
 
   m_cTEncTop.printSummary(m_isField);
 
+  // write the remaining access units
+  if ( m_iWriteQueueSize > 0 )
+  {
+    xStopWriter();
+  }
+  
+  // stop the reader thread and delete its buffers
+  m_cTVideoIOYuvInputReader.destroy();
+  
   // delete original YUV buffer
   pcPicYuvOrg->destroy();
   delete pcPicYuvOrg;
@@ -512,14 +557,13 @@ Void TAppEncTop::xDeleteBuffer( )
 
 /** \param iNumEncoded  number of encoded frames
  */
-Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, const std::list<AccessUnit>& accessUnits)
+Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, std::list<AccessUnit>& accessUnits)
 {
   if (m_isField)
   {
     //Reinterlace fields
     Int i;
     TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
-    list<AccessUnit>::const_iterator iterBitstream = accessUnits.begin();
     
     for ( i = 0; i < iNumEncoded; i++ )
     {
@@ -536,20 +580,14 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
         m_cTVideoIOYuvReconFile.write( pcPicYuvRecTop, pcPicYuvRecBottom, m_confLeft, m_confRight, m_confTop, m_confBottom, m_isTopFieldFirst );
       }
       
-      const AccessUnit& auTop = *(iterBitstream++);
-      const vector<UInt>& statsTop = writeAnnexB(bitstreamFile, auTop);
-      rateStatsAccum(auTop, statsTop);
-      
-      const AccessUnit& auBottom = *(iterBitstream++);
-      const vector<UInt>& statsBottom = writeAnnexB(bitstreamFile, auBottom);
-      rateStatsAccum(auBottom, statsBottom);
+      xWriteAccessUnit(bitstreamFile, accessUnits);
+      xWriteAccessUnit(bitstreamFile, accessUnits);
     }
   }
   else
   {
     Int i;
     TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
-    list<AccessUnit>::const_iterator iterBitstream = accessUnits.begin();
     
     for ( i = 0; i < iNumEncoded; i++ )
     {
@@ -564,11 +602,101 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
         m_cTVideoIOYuvReconFile.write( pcPicYuvRec, m_confLeft, m_confRight, m_confTop, m_confBottom );
       }
       
-      const AccessUnit& au = *(iterBitstream++);
-      const vector<UInt>& stats = writeAnnexB(bitstreamFile, au);
-      rateStatsAccum(au, stats);
+      xWriteAccessUnit(bitstreamFile, accessUnits);
+    }
+  }
+}
+
+/** write the first access unit of a list and remove it, with the writer thread it is moved to the write queue
+ * \param bitstreamFile bitstream file
+ * \param accessUnits   list of access units in decoding order
+ */
+Void TAppEncTop::xWriteAccessUnit(std::ostream& bitstreamFile, std::list<AccessUnit>& accessUnits)
+{
+  if ( m_iWriteQueueSize > 0 )
+  {
+    // moving the list node hands the NAL units over without copying them
+    pthread_mutex_lock( &m_writerMutex );
+    while ( m_cWriteQueue.size() >= (size_t)m_iWriteQueueSize )
+    {
+      pthread_cond_wait( &m_writerCondTaken, &m_writerMutex );
     }
+    m_cWriteQueue.splice( m_cWriteQueue.end(), accessUnits, accessUnits.begin() );
+    pthread_cond_signal( &m_writerCondQueued );
+    pthread_mutex_unlock( &m_writerMutex );
+  }
+  else
+  {
+    const vector<UInt>& stats = writeAnnexB(bitstreamFile, accessUnits.front());
+    rateStatsAccum(accessUnits.front(), stats);
+    accessUnits.pop_front();
+  }
+}
+
+/** start the thread writing the queued access units
+ * \param bitstreamFile bitstream file, only written by the thread until xStopWriter() returns
+ */
+Void TAppEncTop::xStartWriter(std::ostream& bitstreamFile)
+{
+  m_pcWriterFile = &bitstreamFile;
+  m_bWriterExit  = false;
+  pthread_mutex_init( &m_writerMutex, NULL );
+  pthread_cond_init( &m_writerCondQueued, NULL );
+  pthread_cond_init( &m_writerCondTaken, NULL );
+  if ( pthread_create( &m_writerThread, NULL, xWriterThreadMain, this ) != 0 )
+  {
+    fprintf(stderr, "\nfailed to start the bitstream writer thread\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/** wait until the queued access units are written and stop the writer thread
+ */
+Void TAppEncTop::xStopWriter()
+{
+  pthread_mutex_lock( &m_writerMutex );
+  m_bWriterExit = true;
+  pthread_cond_signal( &m_writerCondQueued );
+  pthread_mutex_unlock( &m_writerMutex );
+  pthread_join( m_writerThread, NULL );
+
+  pthread_cond_destroy( &m_writerCondTaken );
+  pthread_cond_destroy( &m_writerCondQueued );
+  pthread_mutex_destroy( &m_writerMutex );
+}
+
+Void* TAppEncTop::xWriterThreadMain(Void* pArg)
+{
+  static_cast<TAppEncTop*>( pArg )->xRunWriter();
+  return NULL;
+}
+
+/** write loop, takes the access units from the queue in order until it is asked to terminate and the queue is empty
+ */
+Void TAppEncTop::xRunWriter()
+{
+  pthread_mutex_lock( &m_writerMutex );
+  while ( true )
+  {
+    while ( m_cWriteQueue.empty() && !m_bWriterExit )
+    {
+      pthread_cond_wait( &m_writerCondQueued, &m_writerMutex );
+    }
+    if ( m_cWriteQueue.empty() )
+    {
+      break;
+    }
+    list<AccessUnit> accessUnit;
+    accessUnit.splice( accessUnit.end(), m_cWriteQueue, m_cWriteQueue.begin() );
+    pthread_cond_signal( &m_writerCondTaken );
+    pthread_mutex_unlock( &m_writerMutex );
+
+    const vector<UInt>& stats = writeAnnexB(*m_pcWriterFile, accessUnit.front());
+    rateStatsAccum(accessUnit.front(), stats);
+
+    pthread_mutex_lock( &m_writerMutex );
   }
+  pthread_mutex_unlock( &m_writerMutex );
 }
 
 /**
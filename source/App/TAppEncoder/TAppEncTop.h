@@ -40,9 +40,11 @@
 
 #include <list>
 #include <ostream>
+#include <pthread.h>
 
 #include "TLibEncoder/TEncTop.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
+#include "TLibVideoIO/TVideoIOYuvReader.h"
 #include "TLibCommon/AccessUnit.h"
 #include "TAppEncCfg.h"
 
@@ -60,6 +62,7 @@ private:
   // class interface
   TEncTop                    m_cTEncTop;                    ///< encoder class
   TVideoIOYuv                m_cTVideoIOYuvInputFile;       ///< input YUV file
+  TVideoIOYuvReader          m_cTVideoIOYuvInputReader;     ///< reads the input YUV file ahead of encoding, used if ReadAheadFrames > 0
   TVideoIOYuv                m_cTVideoIOYuvReconFile;       ///< output reconstruction file
   
   TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV files
@@ -68,6 +71,15 @@ private:
   
   UInt m_essentialBytes;
   UInt m_totalBytes;
+  
+  // bitstream writer thread, used if WriteQueueSize > 0
+  std::list<AccessUnit>      m_cWriteQueue;                 ///< access units waiting to be written, in decoding order
+  std::ostream*              m_pcWriterFile;                ///< bitstream file written by the writer thread
+  Bool                       m_bWriterExit;                 ///< writer thread is asked to terminate once the queue is empty
+  pthread_t                  m_writerThread;
+  pthread_mutex_t            m_writerMutex;
+  pthread_cond_t             m_writerCondQueued;            ///< an access unit was queued or the thread is asked to terminate
+  pthread_cond_t             m_writerCondTaken;             ///< the writer thread took an access unit from the queue
 protected:
   // initialization
   Void  xCreateLib        ();                               ///< create files & encoder class
@@ -82,7 +94,12 @@ protected:
   Void  xDeleteBuffer     ();
   
   // file I/O
-  Void xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, const std::list<AccessUnit>& accessUnits); ///< write bitstream to file
+  Void xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, std::list<AccessUnit>& accessUnits); ///< write bitstream to file
+  Void xWriteAccessUnit(std::ostream& bitstreamFile, std::list<AccessUnit>& accessUnits);            ///< write or queue the first access unit
+  Void xStartWriter(std::ostream& bitstreamFile);                                                     ///< start the bitstream writer thread
+  Void xStopWriter();                                                                                 ///< write the queued access units and stop the thread
+  static Void* xWriterThreadMain(Void* pArg);
+  Void xRunWriter();
   void rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& stats);
   void printRateSummary();
   
@@ -609,6 +609,35 @@ Void TComDataCU::initEstData( UInt uiDepth, Int qp )
 }
 
 
+/** initialize prediction data of a CU at the position of another CU of the same size
+*\param  pcCU     CU whose position, neighbours and slice information are taken
+*\param  uiDepth  depth of the current CU
+*\param  qp     qp for the current CU
+*- lets a second CU encoder evaluate the same CU, e.g. its split subtree
+*/
+Void TComDataCU::initEstData( TComDataCU* pcCU, UInt uiDepth, Int qp )
+{
+  m_pcPic              = pcCU->getPic();
+  m_pcSlice            = pcCU->getSlice();
+  m_uiCUAddr           = pcCU->getAddr();
+  m_uiAbsIdxInLCU      = pcCU->getZorderIdxInCU();
+  m_uiCUPelX           = pcCU->getCUPelX();
+  m_uiCUPelY           = pcCU->getCUPelY();
+  m_uiNumPartition     = pcCU->getTotalNumPart();
+
+  m_pcCULeft        = pcCU->getCULeft();
+  m_pcCUAbove       = pcCU->getCUAbove();
+  m_pcCUAboveLeft   = pcCU->getCUAboveLeft();
+  m_pcCUAboveRight  = pcCU->getCUAboveRight();
+
+  m_apcCUColocated[0] = pcCU->getCUColocated(REF_PIC_LIST_0);
+  m_apcCUColocated[1] = pcCU->getCUColocated(REF_PIC_LIST_1);
+  memcpy(m_sliceStartCU,pcCU->m_sliceStartCU,sizeof(UInt)*m_uiNumPartition);
+  memcpy(m_sliceSegmentStartCU,pcCU->m_sliceSegmentStartCU,sizeof(UInt)*m_uiNumPartition);
+
+  initEstData( uiDepth, qp );
+}
+
 // initialize Sub partition
 Void TComDataCU::initSubCU( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth, Int qp )
 {
@@ -3259,6 +3288,8 @@ Bool TComDataCU::xGetColMVP( RefPicList eRefPicList, Int uiCUAddr, Int uiPartUni
 
   // use coldir.
   TComPic *pColPic = getSlice()->getRefPic( RefPicList(getSlice()->isInterB() ? 1-getSlice()->getColFromL0Flag() : 0), getSlice()->getColRefIdx());
+  // frame-parallel decoding: the motion of the collocated picture is compressed by its loop filter stage
+  pColPic->getPicYuvRec()->waitReadyLines( ( uiCUAddr / pColPic->getFrameWidthInCU() + 1 ) * g_uiMaxCUHeight );
   TComDataCU *pColCU = pColPic->getCU( uiCUAddr );
   if(pColCU->getPic()==0||pColCU->getPartitionSize(uiPartUnitIdx)==SIZE_NONE)
   {
@@ -38,6 +38,7 @@
 #include "TComLoopFilter.h"
 #include "TComSlice.h"
 #include "TComMv.h"
+#include <cilk/cilk.h>
 
 //! \ingroup TLibCommon
 //! \{
@@ -73,6 +74,9 @@ const UChar TComLoopFilter::sm_betaTable[52] =
 TComLoopFilter::TComLoopFilter()
 : m_uiNumPartitions(0)
 , m_bLFCrossTileBoundary(true)
+, m_uiMaxCUDepth(0)
+, m_pcRowFilters(NULL)
+, m_uiNumRowFilters(0)
 {
   for( UInt uiDir = 0; uiDir < 2; uiDir++ )
   {
@@ -96,6 +100,7 @@ Void TComLoopFilter::setCfg( Bool bLFCrossTileBoundary )
 Void TComLoopFilter::create( UInt uiMaxCUDepth )
 {
   destroy();
+  m_uiMaxCUDepth    = uiMaxCUDepth;
   m_uiNumPartitions = 1 << ( uiMaxCUDepth<<1 );
   for( UInt uiDir = 0; uiDir < 2; uiDir++ )
   {
@@ -119,37 +124,84 @@ Void TComLoopFilter::destroy()
       m_aapbEdgeFilter[uiDir] = NULL;
     }
   }
+  if (m_pcRowFilters)
+  {
+    for ( UInt ui = 0; ui < m_uiNumRowFilters; ui++ )
+    {
+      m_pcRowFilters[ui].destroy();
+    }
+    delete [] m_pcRowFilters;
+    m_pcRowFilters = NULL;
+  }
+  m_uiNumRowFilters = 0;
 }
 
 /**
- - call deblocking function for every CU
+ - call deblocking function for every CU, the LCU rows are deblocked concurrently.
+ - Edges are 8 samples apart and a filter reads 4 samples on each side: the edges of one direction never read the
+   samples another edge of that direction changes, the top edges of a row only change the last three lines of the row
+   above. Each pass gives the samples of the serial CU order, with one private filter per row.
  .
  \param  pcPic   picture class (TComPic) pointer
  */
 Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 {
+  UInt uiHeightInCU = pcPic->getFrameHeightInCU();
+  xCreateRowFilters( uiHeightInCU );
+
   // Horizontal filtering
-  for ( UInt uiCUAddr = 0; uiCUAddr < pcPic->getNumCUsInFrame(); uiCUAddr++ )
+  cilk_for ( UInt uiRow = 0; uiRow < uiHeightInCU; uiRow++ )
   {
-    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
-
-    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
-
-    // CU-based deblocking
-    xDeblockCU( pcCU, 0, 0, EDGE_VER );
+    m_pcRowFilters[uiRow].xDeblockRow( pcPic, uiRow, EDGE_VER );
   }
 
   // Vertical filtering
-  for ( UInt uiCUAddr = 0; uiCUAddr < pcPic->getNumCUsInFrame(); uiCUAddr++ )
+  cilk_for ( UInt uiRow = 0; uiRow < uiHeightInCU; uiRow++ )
   {
-    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+    m_pcRowFilters[uiRow].xDeblockRow( pcPic, uiRow, EDGE_HOR );
+  }
+}
 
-    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
+/**
+ - call deblocking function for every CU of an LCU row, the vertical edges of the row and then its horizontal edges.
+ - Vertical edges only change the samples of their row, the top horizontal edges of the row change the last lines of
+   the row above: deblocking the rows from the top gives the samples of loopFilterPic(), as long as the row below is
+   not deblocked before the samples it reads are reconstructed
+ .
+ \param  pcPic   picture class (TComPic) pointer
+ \param  uiRow   LCU row
+ */
+Void TComLoopFilter::loopFilterRow( TComPic* pcPic, UInt uiRow )
+{
+  xDeblockRow( pcPic, uiRow, EDGE_VER );
+  xDeblockRow( pcPic, uiRow, EDGE_HOR );
+}
 
-    // CU-based deblocking
-    xDeblockCU( pcCU, 0, 0, EDGE_HOR );
+/** allocate the private filters of the LCU rows, with the configuration of this filter
+ * \param uiNumRows number of LCU rows of the picture
+ */
+Void TComLoopFilter::xCreateRowFilters( UInt uiNumRows )
+{
+  if ( uiNumRows > m_uiNumRowFilters )
+  {
+    if (m_pcRowFilters)
+    {
+      for ( UInt ui = 0; ui < m_uiNumRowFilters; ui++ )
+      {
+        m_pcRowFilters[ui].destroy();
+      }
+      delete [] m_pcRowFilters;
+    }
+    m_pcRowFilters    = new TComLoopFilter[uiNumRows];
+    m_uiNumRowFilters = uiNumRows;
+    for ( UInt ui = 0; ui < uiNumRows; ui++ )
+    {
+      m_pcRowFilters[ui].create( m_uiMaxCUDepth );
+    }
+  }
+  for ( UInt ui = 0; ui < uiNumRows; ui++ )
+  {
+    m_pcRowFilters[ui].setCfg( m_bLFCrossTileBoundary );
   }
 }
 
@@ -158,6 +210,30 @@ Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 // Protected member functions
 // ====================================================================================================================
 
+/**
+ - call deblocking function for every CU of an LCU row, for the edges of one direction
+ .
+ \param  pcPic   picture class (TComPic) pointer
+ \param  uiRow   LCU row
+ \param  Edge    the direction of the edges
+ */
+Void TComLoopFilter::xDeblockRow( TComPic* pcPic, UInt uiRow, Int Edge )
+{
+  UInt uiFirstCUAddr = uiRow * pcPic->getFrameWidthInCU();
+  UInt uiEndCUAddr   = uiFirstCUAddr + pcPic->getFrameWidthInCU();
+
+  for ( UInt uiCUAddr = uiFirstCUAddr; uiCUAddr < uiEndCUAddr; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    ::memset( m_aapucBS       [Edge], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[Edge], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+    xDeblockCU( pcCU, 0, 0, Edge );
+  }
+}
+
 /**
  - Deblocking filter process in CU-based (the same function as conventional's)
  .
@@ -61,9 +61,17 @@ private:
   
   Bool      m_bLFCrossTileBoundary;
 
+  UInt            m_uiMaxCUDepth;
+  TComLoopFilter* m_pcRowFilters;           ///< private filters of the LCU rows deblocked concurrently
+  UInt            m_uiNumRowFilters;
+
+  Void xCreateRowFilters          ( UInt uiNumRows );
+
 protected:
   /// CU-level deblocking function
   Void xDeblockCU                 ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, Int Edge );
+  /// edges of one direction in the CUs of an LCU row
+  Void xDeblockRow                ( TComPic* pcPic, UInt uiRow, Int Edge );
 
   // set / get functions
   Void xSetLoopfilterParam        ( TComDataCU* pcCU, UInt uiAbsZorderIdx );
@@ -113,6 +121,8 @@ public:
   
   /// picture-level deblocking filter
   Void loopFilterPic( TComPic* pcPic );
+  /// deblocking filter of one LCU row, once the row above is deblocked
+  Void loopFilterRow( TComPic* pcPic, UInt uiRow );
 
   static Int getBeta( Int qp )
   {
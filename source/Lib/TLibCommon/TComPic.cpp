@@ -62,13 +62,19 @@ TComPic::TComPic()
 , m_bIndependentTileBoundaryForNDBFilter  (false)
 , m_pNDBFilterYuvTmp                      (NULL)
 , m_bCheckLTMSB                           (false)
+, m_puiNumReconCUsInRow                   (NULL)
+, m_iNumReconRows                         (0)
 {
   m_apcPicYuv[0]      = NULL;
   m_apcPicYuv[1]      = NULL;
+  pthread_mutex_init( &m_cReconMutex, NULL );
+  pthread_cond_init ( &m_cReconCond,  NULL );
 }
 
 TComPic::~TComPic()
 {
+  pthread_cond_destroy ( &m_cReconCond  );
+  pthread_mutex_destroy( &m_cReconMutex );
 }
 
 Void TComPic::create( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Window &conformanceWindow, Window &defaultDisplayWindow,
@@ -125,6 +131,35 @@ Void TComPic::destroy()
   }
   
   deleteSEIs(m_SEIs);
+
+  delete [] m_puiNumReconCUsInRow;
+  m_puiNumReconCUsInRow = NULL;
+}
+
+/** Reuse the storage of a picture that is no longer needed for another picture, as create() would set it up.
+ * \returns false, the picture being unchanged, if its size or CU partitioning differ and it has to be created again
+ */
+Bool TComPic::recycle( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Window &conformanceWindow, Window &defaultDisplayWindow,
+                       Int *numReorderPics )
+{
+  if ( m_apcPicSym == NULL || m_apcPicYuv[1] == NULL || m_apcPicYuv[1]->getWidth() != iWidth || m_apcPicYuv[1]->getHeight() != iHeight )
+  {
+    return false;
+  }
+  if ( !m_apcPicSym->recycle( uiMaxWidth, uiMaxHeight, uiMaxDepth ) )
+  {
+    return false;
+  }
+
+  if (m_SEIs.size() > 0)
+  {
+    deleteSEIs (m_SEIs);
+  }
+  m_bUsedByCurr = false;
+  m_conformanceWindow = conformanceWindow;
+  m_defaultDisplayWindow = defaultDisplayWindow;
+  memcpy(m_numReorderPics, numReorderPics, MAX_TLAYER*sizeof(Int));
+  return true;
 }
 
 Void TComPic::compressMotion()
@@ -137,6 +172,71 @@ Void TComPic::compressMotion()
   } 
 }
 
+/** start tracking the reconstruction of the LCU rows of a picture about to be decoded, no row is reconstructed
+ */
+Void TComPic::initReconRows()
+{
+  pthread_mutex_lock( &m_cReconMutex );
+  if ( m_puiNumReconCUsInRow == NULL )
+  {
+    m_puiNumReconCUsInRow = new UInt[ getFrameHeightInCU() ];
+  }
+  ::memset( m_puiNumReconCUsInRow, 0, sizeof(UInt)*getFrameHeightInCU() );
+  m_iNumReconRows = 0;
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
+/** count a reconstructed LCU. LCUs may be reconstructed concurrently and out of raster order, a row is published
+ *  once all its LCUs and the rows above are reconstructed
+ * \param uiCUAddr raster address of the reconstructed LCU
+ */
+Void TComPic::reportReconCU( UInt uiCUAddr )
+{
+  if ( m_puiNumReconCUsInRow == NULL )
+  {
+    return;
+  }
+  UInt uiWidthInCU  = getFrameWidthInCU();
+  Int  iHeightInCU  = getFrameHeightInCU();
+  pthread_mutex_lock( &m_cReconMutex );
+  m_puiNumReconCUsInRow[ uiCUAddr / uiWidthInCU ]++;
+  Int iNumRows = m_iNumReconRows;
+  while ( iNumRows < iHeightInCU && m_puiNumReconCUsInRow[iNumRows] == uiWidthInCU )
+  {
+    iNumRows++;
+  }
+  if ( iNumRows != m_iNumReconRows )
+  {
+    m_iNumReconRows = iNumRows;
+    pthread_cond_broadcast( &m_cReconCond );
+  }
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
+/** publish the reconstruction of the LCU rows at once, e.g. all rows when the decoding of the picture is over
+ * \param iRows number of reconstructed LCU rows from the top
+ */
+Void TComPic::setReconRows( Int iRows )
+{
+  pthread_mutex_lock( &m_cReconMutex );
+  m_iNumReconRows = iRows;
+  pthread_cond_broadcast( &m_cReconCond );
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
+/** block until the given number of LCU rows is reconstructed
+ * \param iRows number of LCU rows from the top that are read
+ */
+Void TComPic::waitReconRows( Int iRows )
+{
+  pthread_mutex_lock( &m_cReconMutex );
+  while ( m_iNumReconRows < iRows )
+  {
+    pthread_cond_wait( &m_cReconCond, &m_cReconMutex );
+  }
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
 /** Create non-deblocked filter information
  * \param pSliceStartAddress array for storing slice start addresses
  * \param numSlices number of slices in picture
@@ -460,6 +560,8 @@ Void TComPic::destroyNonDBFilterInfo()
     delete m_pNDBFilterYuvTmp;
     m_pNDBFilterYuvTmp = NULL;
   }
+  m_bIndependentSliceBoundaryForNDBFilter = false;
+  m_bIndependentTileBoundaryForNDBFilter  = false;
 
 }
 
@@ -87,6 +87,11 @@ private:
 
   SEIMessages  m_SEIs; ///< Any SEI messages that have been received.  If !NULL we own the object.
 
+  UInt*                 m_puiNumReconCUsInRow;    ///< # of reconstructed LCUs in each LCU row, NULL if not tracked
+  Int                   m_iNumReconRows;          ///< # of LCU rows reconstructed from the top
+  pthread_mutex_t       m_cReconMutex;
+  pthread_cond_t        m_cReconCond;
+
 public:
   TComPic();
   virtual ~TComPic();
@@ -95,6 +100,8 @@ public:
                         Int *numReorderPics, Bool bIsVirtual = false );
                         
   virtual Void  destroy();
+  Bool          recycle( Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth, Window &conformanceWindow, Window &defaultDisplayWindow,
+                         Int *numReorderPics );
   
   UInt          getTLayer()                { return m_uiTLayer;   }
   Void          setTLayer( UInt uiTLayer ) { m_uiTLayer = uiTLayer; }
@@ -143,6 +150,11 @@ public:
   Int           getNumReorderPics(UInt tlayer)        { return m_numReorderPics[tlayer]; }
 
   Void          compressMotion(); 
+
+  Void          initReconRows ();
+  Void          reportReconCU ( UInt uiCUAddr );
+  Void          setReconRows  ( Int iRows );
+  Void          waitReconRows ( Int iRows );
   UInt          getCurrSliceIdx()            { return m_uiCurrSliceIdx;                }
   Void          setCurrSliceIdx(UInt i)      { m_uiCurrSliceIdx = i;                   }
   UInt          getNumAllocatedSlice()       {return m_apcPicSym->getNumAllocatedSlice();}
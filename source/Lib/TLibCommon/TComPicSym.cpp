@@ -190,6 +190,36 @@ Void TComPicSym::clearSliceBuffer()
   m_uiNumAllocatedSlice = 1;
 }
 
+/** Prepare the storage of a picture that is no longer needed for another picture with the same number of LCUs.
+ *  The CU data are kept, the tiles and the SAO parameters, set up again for each picture, are released.
+ * \param uiMaxWidth  LCU width of the other picture
+ * \param uiMaxHeight LCU height of the other picture
+ * \param uiMaxDepth  maximum CU depth of the other picture
+ * \returns false, nothing being released, if the CU partitioning differs
+ */
+Bool TComPicSym::recycle( UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth )
+{
+  if ( uiMaxWidth != m_uiMaxCUWidth || uiMaxHeight != m_uiMaxCUHeight || uiMaxDepth != m_uhTotalDepth )
+  {
+    return false;
+  }
+
+  for(Int i = 0; i < (m_iNumColumnsMinus1+1)*(m_iNumRowsMinus1+1); i++ )
+  {
+    delete m_apcTComTile[i];
+  }
+  delete [] m_apcTComTile;
+  m_apcTComTile = NULL;
+
+  if (m_saoParam)
+  {
+    TComSampleAdaptiveOffset::freeSaoParam(m_saoParam);
+    delete m_saoParam;
+    m_saoParam = NULL;
+  }
+  return true;
+}
+
 UInt TComPicSym::getPicSCUEncOrder( UInt SCUAddr )
 { 
   return getInverseCUOrderMap(SCUAddr/m_uiNumPartitions)*m_uiNumPartitions + SCUAddr%m_uiNumPartitions; 
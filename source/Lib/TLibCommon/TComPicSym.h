@@ -124,6 +124,7 @@ public:
   UInt        getNumAllocatedSlice()    { return m_uiNumAllocatedSlice;         }
   Void        allocateNewSlice();
   Void        clearSliceBuffer();
+  Bool        recycle( UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth );
   UInt        getNumPartition()         { return m_uiNumPartitions;             }
   UInt        getNumPartInWidth()       { return m_uiNumPartInWidth;            }
   UInt        getNumPartInHeight()      { return m_uiNumPartInHeight;           }
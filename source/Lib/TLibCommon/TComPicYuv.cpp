@@ -61,10 +61,17 @@ TComPicYuv::TComPicYuv()
   m_piPicOrgV       = NULL;
   
   m_bIsBorderExtended = false;
+  
+  m_bTrackReadyLines  = false;
+  m_iReadyLines       = MAX_INT;
+  pthread_mutex_init( &m_cReadyMutex, NULL );
+  pthread_cond_init ( &m_cReadyCond,  NULL );
 }
 
 TComPicYuv::~TComPicYuv()
 {
+  pthread_cond_destroy ( &m_cReadyCond  );
+  pthread_mutex_destroy( &m_cReadyMutex );
 }
 
 Void TComPicYuv::create( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxCUDepth )
@@ -264,6 +271,111 @@ Void TComPicYuv::xExtendPicCompBorder  (Pel* piTxt, Int iStride, Int iWidth, Int
 }
 
 
+/** extend the margins next to a band of luma lines, the top and bottom margins with the first and last band of the
+ *  picture. Unlike extendPicBorder(), the border extension flag is not set: the frame-parallel decoder sets it when it
+ *  hands the picture over to the loop filter stage, which extends the borders while other pictures are decoded
+ * \param iFirstLine first luma line of the band, a multiple of 2
+ * \param iNumLines  number of luma lines of the band, a multiple of 2
+ */
+Void TComPicYuv::extendPicBorder( Int iFirstLine, Int iNumLines )
+{
+  xExtendPicCompBorder( getLumaAddr(), getStride(),  getWidth(),      getHeight(),      m_iLumaMarginX,   m_iLumaMarginY,   iFirstLine,      iNumLines      );
+  xExtendPicCompBorder( getCbAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, iFirstLine >> 1, iNumLines >> 1 );
+  xExtendPicCompBorder( getCrAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, iFirstLine >> 1, iNumLines >> 1 );
+}
+
+Void TComPicYuv::xExtendPicCompBorder  (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY, Int iFirstLine, Int iNumLines)
+{
+  Int   x, y;
+  Pel*  pi;
+  
+  pi = piTxt + iFirstLine * iStride;
+  for ( y = 0; y < iNumLines; y++)
+  {
+    for ( x = 0; x < iMarginX; x++ )
+    {
+      pi[ -iMarginX + x ] = pi[0];
+      pi[    iWidth + x ] = pi[iWidth-1];
+    }
+    pi += iStride;
+  }
+  
+  if ( iFirstLine + iNumLines == iHeight )
+  {
+    pi = piTxt + (iHeight-1) * iStride - iMarginX;
+    for ( y = 0; y < iMarginY; y++ )
+    {
+      ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+    }
+  }
+  
+  if ( iFirstLine == 0 )
+  {
+    pi = piTxt - iMarginX;
+    for ( y = 0; y < iMarginY; y++ )
+    {
+      ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+    }
+  }
+}
+
+/** start tracking the reconstruction of a picture about to be decoded, no line is final
+ */
+Void TComPicYuv::initReadyLines()
+{
+  pthread_mutex_lock( &m_cReadyMutex );
+  m_bTrackReadyLines = true;
+  m_iReadyLines      = 0;
+  pthread_mutex_unlock( &m_cReadyMutex );
+}
+
+/** publish the final luma lines of the picture, and the chroma lines next to them
+ * \param iLines number of final luma lines from the top, including the margins beside them; MAX_INT when all lines and
+ *               margins are final
+ */
+Void TComPicYuv::setReadyLines( Int iLines )
+{
+  pthread_mutex_lock( &m_cReadyMutex );
+  m_iReadyLines = iLines;
+  pthread_cond_broadcast( &m_cReadyCond );
+  pthread_mutex_unlock( &m_cReadyMutex );
+}
+
+/** block until the given number of luma lines is final, lines beyond the picture wait for the completion
+ * \param iLines number of luma lines from the top that are read
+ */
+Void TComPicYuv::waitReadyLines( Int iLines )
+{
+  if ( !m_bTrackReadyLines )
+  {
+    return;
+  }
+  if ( iLines > m_iPicHeight )
+  {
+    iLines = MAX_INT;
+  }
+  pthread_mutex_lock( &m_cReadyMutex );
+  while ( m_iReadyLines < iLines )
+  {
+    pthread_cond_wait( &m_cReadyCond, &m_cReadyMutex );
+  }
+  pthread_mutex_unlock( &m_cReadyMutex );
+}
+
+/** check without blocking whether all lines and margins of the picture are final
+ */
+Bool TComPicYuv::isReconComplete()
+{
+  if ( !m_bTrackReadyLines )
+  {
+    return true;
+  }
+  pthread_mutex_lock( &m_cReadyMutex );
+  Bool bComplete = m_iReadyLines == MAX_INT;
+  pthread_mutex_unlock( &m_cReadyMutex );
+  return bComplete;
+}
+
 Void TComPicYuv::dump (Char* pFileName, Bool bAdd)
 {
   FILE* pFile;
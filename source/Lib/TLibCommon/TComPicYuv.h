@@ -39,6 +39,7 @@
 #define __TCOMPICYUV__
 
 #include <stdio.h>
+#include <pthread.h>
 #include "CommonDef.h"
 #include "TComRom.h"
 
@@ -87,8 +88,18 @@ private:
   
   Bool  m_bIsBorderExtended;
   
+  // ------------------------------------------------------------------------------------------------
+  //  Reconstruction progress for frame-parallel decoding
+  // ------------------------------------------------------------------------------------------------
+  
+  Bool            m_bTrackReadyLines;     ///< lines are published with setReadyLines(), otherwise the whole picture is ready
+  Int             m_iReadyLines;          ///< # of final luma lines, MAX_INT once the picture and its margins are final
+  pthread_mutex_t m_cReadyMutex;
+  pthread_cond_t  m_cReadyCond;
+  
 protected:
   Void  xExtendPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY);
+  Void  xExtendPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY, Int iFirstLine, Int iNumLines);
   
 public:
   TComPicYuv         ();
@@ -151,6 +162,13 @@ public:
   
   //  Extend function of picture buffer
   Void  extendPicBorder      ();
+  Void  extendPicBorder      ( Int iFirstLine, Int iNumLines );
+  
+  //  Reconstruction progress: published by the decoder loop filter stage, waited for by the pictures referring to it
+  Void  initReadyLines       ();
+  Void  setReadyLines        ( Int iLines );
+  Void  waitReadyLines       ( Int iLines );
+  Bool  isReconComplete      ();
   
   //  Dump picture
   Void  dump (Char* pFileName, Bool bAdd = false);
@@ -162,6 +180,7 @@ public:
 void calcChecksum(TComPicYuv& pic, UChar digest[3][16]);
 void calcCRC(TComPicYuv& pic, UChar digest[3][16]);
 void calcMD5(TComPicYuv& pic, UChar digest[3][16]);
+void calcPicHashSSD(TComPicYuv& pic, Int hashType, UChar digest[3][16], TComPicYuv* pcOrg, UInt uiSSDWidth, UInt uiSSDHeight, UInt64 auiSSD[3]);
 //! \}
 
 #endif // __TCOMPICYUV__
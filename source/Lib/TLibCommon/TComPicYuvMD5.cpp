@@ -31,9 +31,16 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <memory.h>
+#include <vector>
+#include <algorithm>
+#include <cilk/cilk.h>
 #include "TComPicYuv.h"
 #include "libmd5/MD5.h"
 
+/// minimum number of rows of the plane blocks hashed concurrently with CRC or checksum
+#define PIC_HASH_BLOCK_ROWS 32
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -83,100 +90,250 @@ static void md5_plane(MD5& md5, const Pel* plane, UInt width, UInt height, UInt
   }
 }
 
-static void compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, UChar digest[16])
+/**
+ * Update the CRC register crcVal with the width samples of row.
+ */
+static UInt crcRow(Int bitdepth, const Pel* row, UInt width, UInt crcVal)
 {
   UInt crcMsb;
   UInt bitVal;
-  UInt crcVal = 0xffff;
   UInt bitIdx;
-  for (UInt y = 0; y < height; y++)
+  for (UInt x = 0; x < width; x++)
   {
-    for (UInt x = 0; x < width; x++)
+    // take CRC of first pictureData byte
+    for(bitIdx=0; bitIdx<8; bitIdx++)
+    {
+      crcMsb = (crcVal >> 15) & 1;
+      bitVal = (row[x] >> (7 - bitIdx)) & 1;
+      crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+    }
+    // take CRC of second pictureData byte if bit depth is greater than 8-bits
+    if(bitdepth > 8)
     {
-      // take CRC of first pictureData byte
       for(bitIdx=0; bitIdx<8; bitIdx++)
       {
         crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
+        bitVal = (row[x] >> (15 - bitIdx)) & 1;
         crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
-      {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
-      }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
+  return crcVal;
+}
+
+/**
+ * Apply to the CRC register crcVal the linear operator op, whose column
+ * i is the image of the register 1<<i.
+ */
+static UInt crcOperatorTimes(const UInt op[16], UInt crcVal)
+{
+  UInt result = 0;
+  for (UInt i = 0; i < 16; i++)
   {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
+    if ((crcVal >> i) & 1)
+    {
+      result ^= op[i];
+    }
   }
+  return result;
+}
 
-  digest[0] = (crcVal>>8)  & 0xff;
-  digest[1] =  crcVal      & 0xff;
+/**
+ * Update the CRC register crcVal with numBits zero bits. The register
+ * update for a zero bit is linear, the update for numBits bits is the
+ * product of the squares of the one bit operator selected by numBits.
+ */
+static UInt crcZeroBits(UInt crcVal, UInt64 numBits)
+{
+  UInt op[16];
+  UInt square[16];
+  for (UInt i = 0; i < 16; i++)
+  {
+    UInt crcMsb = (1 << i) >> 15;
+    op[i] = (((1 << i) << 1) & 0xffff) ^ (crcMsb * 0x1021);
+  }
+  while (numBits)
+  {
+    if (numBits & 1)
+    {
+      crcVal = crcOperatorTimes(op, crcVal);
+    }
+    numBits >>= 1;
+    if (numBits)
+    {
+      for (UInt i = 0; i < 16; i++)
+      {
+        square[i] = crcOperatorTimes(op, op[i]);
+      }
+      memcpy(op, square, sizeof(op));
+    }
+  }
+  return crcVal;
 }
 
-void calcCRC(TComPicYuv& pic, UChar digest[3][16])
+/**
+ * Add to checksum the width samples of row y.
+ */
+static UInt checksumRow(Int bitdepth, const Pel* row, UInt width, UInt y, UInt checksum)
 {
-  UInt width = pic.getWidth();
-  UInt height = pic.getHeight();
-  UInt stride = pic.getStride();
+  UChar xor_mask;
 
-  compCRC(g_bitDepthY, pic.getLumaAddr(), width, height, stride, digest[0]);
+  for (UInt x = 0; x < width; x++)
+  {
+    xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
+    checksum = (checksum + ((row[x] & 0xff) ^ xor_mask)) & 0xffffffff;
+
+    if(bitdepth > 8)
+    {
+      checksum = (checksum + ((row[x]>>8) ^ xor_mask)) & 0xffffffff;
+    }
+  }
+  return checksum;
+}
 
-  width >>= 1;
-  height >>= 1;
-  stride >>= 1;
+/**
+ * Sum of squared differences of the width samples of two rows.
+ */
+static UInt64 ssdRow(const Pel* org, const Pel* rec, UInt width)
+{
+  UInt64 ssd = 0;
+  for (UInt x = 0; x < width; x++)
+  {
+    Int iDiff = (Int)( org[x] - rec[x] );
+    ssd += iDiff * iDiff;
+  }
+  return ssd;
+}
 
-  compCRC(g_bitDepthC, pic.getCbAddr(), width, height, stride, digest[1]);
-  compCRC(g_bitDepthC, pic.getCrAddr(), width, height, stride, digest[2]);
+static Pel* getPlaneAddr(TComPicYuv& pic, Int yuvIdx)
+{
+  return yuvIdx == 0 ? pic.getLumaAddr() : yuvIdx == 1 ? pic.getCbAddr() : pic.getCrAddr();
 }
 
-static void compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, UChar digest[16])
+/**
+ * Calculate in one sweep of the planes the hash of pic and the sum of squared
+ * differences between pic and pcOrg. The hash of a plane is computed as in
+ * calcMD5, calcCRC or calcChecksum. The three planes are processed
+ * concurrently; for CRC and checksum, the row blocks of each plane are as
+ * well, and their results are combined in raster order.
+ * \param pic picture to hash
+ * \param hashType hash of the planes, 0: none, 1: MD5, 2: CRC, 3: checksum
+ * \param digest hash of the planes
+ * \param pcOrg original picture, no SSD is computed when NULL
+ * \param uiSSDWidth luma width of the SSD area
+ * \param uiSSDHeight luma height of the SSD area
+ * \param auiSSD SSD of the planes
+ */
+void calcPicHashSSD(TComPicYuv& pic, Int hashType, UChar digest[3][16], TComPicYuv* pcOrg, UInt uiSSDWidth, UInt uiSSDHeight, UInt64 auiSSD[3])
 {
-  UInt checksum = 0;
-  UChar xor_mask;
+  // MD5 is sequential, a plane is a single block
+  Int numBlocks = (hashType == 1) ? 1 : std::max(1, (pic.getHeight() >> 1) / PIC_HASH_BLOCK_ROWS);
+  MD5 md5[3];
+  std::vector<UInt>   crcVal  ( 3*numBlocks );
+  std::vector<UInt>   checksum( 3*numBlocks );
+  std::vector<UInt64> ssd     ( 3*numBlocks );
 
-  for (UInt y = 0; y < height; y++)
+  cilk_for (Int i = 0; i < 3*numBlocks; i++)
   {
-    for (UInt x = 0; x < width; x++)
+    Int  yuvIdx    = i / numBlocks;
+    Int  block     = i % numBlocks;
+    Int  bitdepth  = yuvIdx ? g_bitDepthC : g_bitDepthY;
+    UInt width     = yuvIdx ? pic.getWidth() >> 1  : pic.getWidth();
+    UInt height    = yuvIdx ? pic.getHeight() >> 1 : pic.getHeight();
+    UInt stride    = yuvIdx ? pic.getStride() >> 1 : pic.getStride();
+    UInt ssdWidth  = yuvIdx ? uiSSDWidth >> 1  : uiSSDWidth;
+    UInt ssdHeight = yuvIdx ? uiSSDHeight >> 1 : uiSSDHeight;
+    UInt firstRow  = block*height/numBlocks;
+    UInt endRow    = (block+1)*height/numBlocks;
+    const Pel* plane = getPlaneAddr(pic, yuvIdx);
+    const Pel* org   = pcOrg ? getPlaneAddr(*pcOrg, yuvIdx) : NULL;
+
+    /* choose an md5_plane packing function based on the system bitdepth */
+    typedef void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
+    MD5PlaneFunc md5_plane_func = bitdepth <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+
+    crcVal[i]   = block == 0 ? 0xffff : 0;
+    checksum[i] = 0;
+    ssd[i]      = 0;
+    for (UInt y = firstRow; y < endRow; y++)
     {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
+      const Pel* row = plane + y*stride;
+      switch (hashType)
+      {
+      case 1:
+        md5_plane_func(md5[yuvIdx], row, width, 1, stride);
+        break;
+      case 2:
+        crcVal[i] = crcRow(bitdepth, row, width, crcVal[i]);
+        break;
+      case 3:
+        checksum[i] = checksumRow(bitdepth, row, width, y, checksum[i]);
+        break;
+      default:
+        break;
+      }
+      if (org && y < ssdHeight)
+      {
+        ssd[i] += ssdRow(org + y*stride, row, ssdWidth);
+      }
+    }
+  }
 
-      if(bitdepth > 8)
+  for (Int yuvIdx = 0; yuvIdx < 3; yuvIdx++)
+  {
+    UInt   width         = yuvIdx ? pic.getWidth() >> 1  : pic.getWidth();
+    UInt   height        = yuvIdx ? pic.getHeight() >> 1 : pic.getHeight();
+    Int    bitdepth      = yuvIdx ? g_bitDepthC : g_bitDepthY;
+    UInt   crcPlane      = crcVal[yuvIdx*numBlocks];
+    UInt   checksumPlane = 0;
+    UInt64 ssdPlane      = 0;
+    for (Int block = 0; block < numBlocks; block++)
+    {
+      Int i = yuvIdx*numBlocks + block;
+      if (block > 0)
       {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
+        // the register of a block started from zero, the register of the blocks above is shifted past it
+        UInt numRows = (block+1)*height/numBlocks - block*height/numBlocks;
+        crcPlane = crcZeroBits(crcPlane, (UInt64)numRows*width*(bitdepth > 8 ? 16 : 8)) ^ crcVal[i];
       }
+      checksumPlane = (checksumPlane + checksum[i]) & 0xffffffff;
+      ssdPlane     += ssd[i];
+    }
+    if (auiSSD)
+    {
+      auiSSD[yuvIdx] = ssdPlane;
+    }
+
+    switch (hashType)
+    {
+    case 1:
+      md5[yuvIdx].finalize(digest[yuvIdx]);
+      break;
+    case 2:
+      crcPlane = crcZeroBits(crcPlane, 16);
+      digest[yuvIdx][0] = (crcPlane>>8)  & 0xff;
+      digest[yuvIdx][1] =  crcPlane      & 0xff;
+      break;
+    case 3:
+      digest[yuvIdx][0] = (checksumPlane>>24) & 0xff;
+      digest[yuvIdx][1] = (checksumPlane>>16) & 0xff;
+      digest[yuvIdx][2] = (checksumPlane>>8)  & 0xff;
+      digest[yuvIdx][3] =  checksumPlane      & 0xff;
+      break;
+    default:
+      break;
     }
   }
+}
 
-  digest[0] = (checksum>>24) & 0xff;
-  digest[1] = (checksum>>16) & 0xff;
-  digest[2] = (checksum>>8)  & 0xff;
-  digest[3] =  checksum      & 0xff;
+void calcCRC(TComPicYuv& pic, UChar digest[3][16])
+{
+  calcPicHashSSD(pic, 2, digest, NULL, 0, 0, NULL);
 }
 
 void calcChecksum(TComPicYuv& pic, UChar digest[3][16])
 {
-  UInt width = pic.getWidth();
-  UInt height = pic.getHeight();
-  UInt stride = pic.getStride();
-
-  compChecksum(g_bitDepthY, pic.getLumaAddr(), width, height, stride, digest[0]);
-
-  width >>= 1;
-  height >>= 1;
-  stride >>= 1;
-
-  compChecksum(g_bitDepthC, pic.getCbAddr(), width, height, stride, digest[1]);
-  compChecksum(g_bitDepthC, pic.getCrAddr(), width, height, stride, digest[2]);
+  calcPicHashSSD(pic, 3, digest, NULL, 0, 0, NULL);
 }
 /**
  * Calculate the MD5sum of pic, storing the result in digest.
@@ -187,28 +344,6 @@ void calcChecksum(TComPicYuv& pic, UChar digest[3][16])
  */
 void calcMD5(TComPicYuv& pic, UChar digest[3][16])
 {
-  /* choose an md5_plane packing function based on the system bitdepth */
-  typedef void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
-  MD5PlaneFunc md5_plane_func;
-  md5_plane_func = g_bitDepthY <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
-
-  MD5 md5Y, md5U, md5V;
-  UInt width = pic.getWidth();
-  UInt height = pic.getHeight();
-  UInt stride = pic.getStride();
-
-  md5_plane_func(md5Y, pic.getLumaAddr(), width, height, stride);
-  md5Y.finalize(digest[0]);
-
-  md5_plane_func = g_bitDepthC <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
-  width >>= 1;
-  height >>= 1;
-  stride >>= 1;
-
-  md5_plane_func(md5U, pic.getCbAddr(), width, height, stride);
-  md5U.finalize(digest[1]);
-
-  md5_plane_func(md5V, pic.getCrAddr(), width, height, stride);
-  md5V.finalize(digest[2]);
+  calcPicHashSSD(pic, 1, digest, NULL, 0, 0, NULL);
 }
 //! \}
@@ -553,6 +553,11 @@ Void TComPrediction::xPredInterBi ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidt
  */
 Void TComPrediction::xPredInterLumaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt partAddr, TComMv *mv, Int width, Int height, TComYuv *&dstPic, Bool bi )
 {
+  // frame-parallel decoding: the reference lines under the interpolation filter taps must be final
+  Int refLineY  = ( cu->getAddr() / cu->getPic()->getFrameWidthInCU() ) * g_uiMaxCUHeight
+                + g_auiRasterToPelY[ g_auiZscanToRaster[ cu->getZorderIdxInCU() + partAddr ] ];
+  refPic->waitReadyLines( max( 1, refLineY + height + ( mv->getVer() >> 2 ) + ( NTAPS_LUMA >> 1 ) ) );
+
   Int refStride = refPic->getStride();  
   Int refOffset = ( mv->getHor() >> 2 ) + ( mv->getVer() >> 2 ) * refStride;
   Pel *ref      = refPic->getLumaAddr( cu->getAddr(), cu->getZorderIdxInCU() + partAddr ) + refOffset;
@@ -598,6 +603,11 @@ Void TComPrediction::xPredInterLumaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt
  */
 Void TComPrediction::xPredInterChromaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt partAddr, TComMv *mv, Int width, Int height, TComYuv *&dstPic, Bool bi )
 {
+  // frame-parallel decoding: the reference lines under the interpolation filter taps must be final
+  Int refLineC  = ( ( cu->getAddr() / cu->getPic()->getFrameWidthInCU() ) * g_uiMaxCUHeight
+                + g_auiRasterToPelY[ g_auiZscanToRaster[ cu->getZorderIdxInCU() + partAddr ] ] ) >> 1;
+  refPic->waitReadyLines( max( 1, ( refLineC + ( height >> 1 ) + ( mv->getVer() >> 3 ) + ( NTAPS_CHROMA >> 1 ) ) << 1 ) );
+
   Int     refStride  = refPic->getCStride();
   Int     dstStride  = dstPic->getCStride();
   
@@ -172,6 +172,22 @@ Void TComRdCost::setLambda( Double dLambda )
   m_uiLambdaMotionSSE = (UInt)floor(65536.0 * m_dLambda   );
 }
 
+/** copy the lambda and distortion weight state of another cost object, the motion vector predictor is not copied
+ * \param pcRdCost source cost object
+ */
+Void TComRdCost::copyLambda( TComRdCost* pcRdCost )
+{
+#if WEIGHTED_CHROMA_DISTORTION
+  m_cbDistortionWeight = pcRdCost->m_cbDistortionWeight;
+  m_crDistortionWeight = pcRdCost->m_crDistortionWeight;
+#endif
+  m_dLambda            = pcRdCost->m_dLambda;
+  m_sqrtLambda         = pcRdCost->m_sqrtLambda;
+  m_uiLambdaMotionSAD  = pcRdCost->m_uiLambdaMotionSAD;
+  m_uiLambdaMotionSSE  = pcRdCost->m_uiLambdaMotionSSE;
+  m_dFrameLambda       = pcRdCost->m_dFrameLambda;
+}
+
 
 // Initalize Function Pointer by [eDFunc]
 Void TComRdCost::init()
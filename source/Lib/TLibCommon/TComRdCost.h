@@ -160,6 +160,7 @@ public:
 #endif
   Void    setLambda      ( Double dLambda );
   Void    setFrameLambda ( Double dLambda ) { m_dFrameLambda = dLambda; }
+  Void    copyLambda     ( TComRdCost* pcRdCost );
   
   Double  getSqrtLambda ()   { return m_sqrtLambda; }
 
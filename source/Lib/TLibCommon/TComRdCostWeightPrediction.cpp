@@ -40,13 +40,6 @@
 #include "TComRdCost.h"
 #include "TComRdCostWeightPrediction.h"
 
-Int   TComRdCostWeightPrediction::m_w0        = 0;
-Int   TComRdCostWeightPrediction::m_w1        = 0;
-Int   TComRdCostWeightPrediction::m_shift     = 0;
-Int   TComRdCostWeightPrediction::m_offset    = 0;
-Int   TComRdCostWeightPrediction::m_round     = 0;
-Bool  TComRdCostWeightPrediction::m_xSetDone  = false;
-
 // ====================================================================================================================
 // Distortion functions
 // ====================================================================================================================
@@ -157,6 +150,7 @@ UInt TComRdCostWeightPrediction::xGetSSEw( DistParam* pcDtParam )
 // HADAMARD with step (used in fractional search)
 // --------------------------------------------------------------------------------------------------------------------
 /** get weighted Hadamard cost for 2x2 block
+ * \param *wpCur
  * \param *piOrg
  * \param *piCur
  * \param iStrideOrg
@@ -164,20 +158,23 @@ UInt TComRdCostWeightPrediction::xGetSSEw( DistParam* pcDtParam )
  * \param iStep
  * \returns UInt
  */
-UInt TComRdCostWeightPrediction::xCalcHADs2x2w( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
+UInt TComRdCostWeightPrediction::xCalcHADs2x2w( wpScalingParam *wpCur, Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
 {
   Int satd = 0, diff[4], m[4];
   
-  assert( m_xSetDone );
+  Int   w0      = wpCur->w,
+        offset  = wpCur->offset,
+        shift   = wpCur->shift,
+        round   = wpCur->round;
   Pel   pred;
 
-  pred    = ( (m_w0*piCur[0*iStep             ] + m_round) >> m_shift ) + m_offset ;
+  pred    = ( (w0*piCur[0*iStep             ] + round) >> shift ) + offset ;
   diff[0] = piOrg[0             ] - pred;
-  pred    = ( (m_w0*piCur[1*iStep             ] + m_round) >> m_shift ) + m_offset ;
+  pred    = ( (w0*piCur[1*iStep             ] + round) >> shift ) + offset ;
   diff[1] = piOrg[1             ] - pred;
-  pred    = ( (m_w0*piCur[0*iStep + iStrideCur] + m_round) >> m_shift ) + m_offset ;
+  pred    = ( (w0*piCur[0*iStep + iStrideCur] + round) >> shift ) + offset ;
   diff[2] = piOrg[iStrideOrg    ] - pred;
-  pred    = ( (m_w0*piCur[1*iStep + iStrideCur] + m_round) >> m_shift ) + m_offset ;
+  pred    = ( (w0*piCur[1*iStep + iStrideCur] + round) >> shift ) + offset ;
   diff[3] = piOrg[iStrideOrg + 1] - pred;
 
   m[0] = diff[0] + diff[2];
@@ -194,6 +191,7 @@ UInt TComRdCostWeightPrediction::xCalcHADs2x2w( Pel *piOrg, Pel *piCur, Int iStr
 }
 
 /** get weighted Hadamard cost for 4x4 block
+ * \param *wpCur
  * \param *piOrg
  * \param *piCur
  * \param iStrideOrg
@@ -201,22 +199,25 @@ UInt TComRdCostWeightPrediction::xCalcHADs2x2w( Pel *piOrg, Pel *piCur, Int iStr
  * \param iStep
  * \returns UInt
  */
-UInt TComRdCostWeightPrediction::xCalcHADs4x4w( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
+UInt TComRdCostWeightPrediction::xCalcHADs4x4w( wpScalingParam *wpCur, Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
 {
   Int k, satd = 0, diff[16], m[16], d[16];
   
-  assert( m_xSetDone );
+  Int   w0      = wpCur->w,
+        offset  = wpCur->offset,
+        shift   = wpCur->shift,
+        round   = wpCur->round;
   Pel   pred;
 
   for( k = 0; k < 16; k+=4 )
   {
-    pred      = ( (m_w0*piCur[0*iStep] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[0*iStep] + round) >> shift ) + offset ;
     diff[k+0] = piOrg[0] - pred;
-    pred      = ( (m_w0*piCur[1*iStep] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[1*iStep] + round) >> shift ) + offset ;
     diff[k+1] = piOrg[1] - pred;
-    pred      = ( (m_w0*piCur[2*iStep] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[2*iStep] + round) >> shift ) + offset ;
     diff[k+2] = piOrg[2] - pred;
-    pred      = ( (m_w0*piCur[3*iStep] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[3*iStep] + round) >> shift ) + offset ;
     diff[k+3] = piOrg[3] - pred;
 
     piCur += iStrideCur;
@@ -302,6 +303,7 @@ UInt TComRdCostWeightPrediction::xCalcHADs4x4w( Pel *piOrg, Pel *piCur, Int iStr
 }
 
 /** get weighted Hadamard cost for 8x8 block
+ * \param *wpCur
  * \param *piOrg
  * \param *piCur
  * \param iStrideOrg
@@ -309,7 +311,7 @@ UInt TComRdCostWeightPrediction::xCalcHADs4x4w( Pel *piOrg, Pel *piCur, Int iStr
  * \param iStep
  * \returns UInt
  */
-UInt TComRdCostWeightPrediction::xCalcHADs8x8w( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
+UInt TComRdCostWeightPrediction::xCalcHADs8x8w( wpScalingParam *wpCur, Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
 {
   Int k, i, j, jj, sad=0;
   Int diff[64], m1[8][8], m2[8][8], m3[8][8];
@@ -320,26 +322,29 @@ UInt TComRdCostWeightPrediction::xCalcHADs8x8w( Pel *piOrg, Pel *piCur, Int iStr
   Int iStep6 = iStep5 + iStep;
   Int iStep7 = iStep6 + iStep;
   
-  assert( m_xSetDone );
+  Int   w0      = wpCur->w,
+        offset  = wpCur->offset,
+        shift   = wpCur->shift,
+        round   = wpCur->round;
   Pel   pred;
 
   for( k = 0; k < 64; k+=8 )
   {
-    pred      = ( (m_w0*piCur[     0] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[     0] + round) >> shift ) + offset ;
     diff[k+0] = piOrg[0] - pred;
-    pred      = ( (m_w0*piCur[iStep ] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep ] + round) >> shift ) + offset ;
     diff[k+1] = piOrg[1] - pred;
-    pred      = ( (m_w0*piCur[iStep2] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep2] + round) >> shift ) + offset ;
     diff[k+2] = piOrg[2] - pred;
-    pred      = ( (m_w0*piCur[iStep3] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep3] + round) >> shift ) + offset ;
     diff[k+3] = piOrg[3] - pred;
-    pred      = ( (m_w0*piCur[iStep4] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep4] + round) >> shift ) + offset ;
     diff[k+4] = piOrg[4] - pred;
-    pred      = ( (m_w0*piCur[iStep5] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep5] + round) >> shift ) + offset ;
     diff[k+5] = piOrg[5] - pred;
-    pred      = ( (m_w0*piCur[iStep6] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep6] + round) >> shift ) + offset ;
     diff[k+6] = piOrg[6] - pred;
-    pred      = ( (m_w0*piCur[iStep7] + m_round) >> m_shift ) + m_offset ;
+    pred      = ( (w0*piCur[iStep7] + round) >> shift ) + offset ;
     diff[k+7] = piOrg[7] - pred;
     
     piCur += iStrideCur;
@@ -435,6 +440,7 @@ UInt TComRdCostWeightPrediction::xGetHADs4w( DistParam* pcDtParam )
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStep  = pcDtParam->iStep;
   Int  y;
+  wpScalingParam  *wpCur    = &(pcDtParam->wpCur[pcDtParam->uiComp]);
   Int  iOffsetOrg = iStrideOrg<<2;
   Int  iOffsetCur = iStrideCur<<2;
   
@@ -442,7 +448,7 @@ UInt TComRdCostWeightPrediction::xGetHADs4w( DistParam* pcDtParam )
   
   for ( y=0; y<iRows; y+= 4 )
   {
-    uiSum += xCalcHADs4x4w( piOrg, piCur, iStrideOrg, iStrideCur, iStep );
+    uiSum += xCalcHADs4x4w( wpCur, piOrg, piCur, iStrideOrg, iStrideCur, iStep );
     piOrg += iOffsetOrg;
     piCur += iOffsetCur;
   }
@@ -463,13 +469,14 @@ UInt TComRdCostWeightPrediction::xGetHADs8w( DistParam* pcDtParam )
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStep  = pcDtParam->iStep;
   Int  y;
+  wpScalingParam  *wpCur    = &(pcDtParam->wpCur[pcDtParam->uiComp]);
   
   UInt uiSum = 0;
   
   if ( iRows == 4 )
   {
-    uiSum += xCalcHADs4x4w( piOrg+0, piCur        , iStrideOrg, iStrideCur, iStep );
-    uiSum += xCalcHADs4x4w( piOrg+4, piCur+4*iStep, iStrideOrg, iStrideCur, iStep );
+    uiSum += xCalcHADs4x4w( wpCur, piOrg+0, piCur        , iStrideOrg, iStrideCur, iStep );
+    uiSum += xCalcHADs4x4w( wpCur, piOrg+4, piCur+4*iStep, iStrideOrg, iStrideCur, iStep );
   }
   else
   {
@@ -477,7 +484,7 @@ UInt TComRdCostWeightPrediction::xGetHADs8w( DistParam* pcDtParam )
     Int  iOffsetCur = iStrideCur<<3;
     for ( y=0; y<iRows; y+= 8 )
     {
-      uiSum += xCalcHADs8x8w( piOrg, piCur, iStrideOrg, iStrideCur, iStep );
+      uiSum += xCalcHADs8x8w( wpCur, piOrg, piCur, iStrideOrg, iStrideCur, iStep );
       piOrg += iOffsetOrg;
       piCur += iOffsetCur;
     }
@@ -506,8 +513,6 @@ UInt TComRdCostWeightPrediction::xGetHADsw( DistParam* pcDtParam )
   assert(uiComp<3);
   wpScalingParam  *wpCur    = &(pcDtParam->wpCur[uiComp]);
 
-  xSetWPscale(wpCur->w, 0, wpCur->shift, wpCur->offset, wpCur->round);
-
   UInt uiSum = 0;
   
   if( ( iRows % 8 == 0) && (iCols % 8 == 0) )
@@ -518,7 +523,7 @@ UInt TComRdCostWeightPrediction::xGetHADsw( DistParam* pcDtParam )
     {
       for ( x=0; x<iCols; x+= 8 )
       {
-        uiSum += xCalcHADs8x8w( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
+        uiSum += xCalcHADs8x8w( wpCur, &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
       }
       piOrg += iOffsetOrg;
       piCur += iOffsetCur;
@@ -533,7 +538,7 @@ UInt TComRdCostWeightPrediction::xGetHADsw( DistParam* pcDtParam )
     {
       for ( x=0; x<iCols; x+= 4 )
       {
-        uiSum += xCalcHADs4x4w( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
+        uiSum += xCalcHADs4x4w( wpCur, &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
       }
       piOrg += iOffsetOrg;
       piCur += iOffsetCur;
@@ -545,14 +550,12 @@ UInt TComRdCostWeightPrediction::xGetHADsw( DistParam* pcDtParam )
     {
       for ( x=0; x<iCols; x+=2 )
       {
-        uiSum += xCalcHADs2x2w( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
+        uiSum += xCalcHADs2x2w( wpCur, &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
       }
       piOrg += iStrideOrg;
       piCur += iStrideCur;
     }
   }
-  
-  m_xSetDone  = false;
 
   return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
 }
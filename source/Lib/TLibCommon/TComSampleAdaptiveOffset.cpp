@@ -40,6 +40,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <algorithm>
+#include <cilk/cilk.h>
 
 //! \ingroup TLibCommon
 //! \{
@@ -76,8 +78,16 @@ TComSampleAdaptiveOffset::TComSampleAdaptiveOffset()
 
   m_pTmpU1 = NULL;
   m_pTmpU2 = NULL;
+  for (Int i=0; i<3; i++)
+  {
+    m_apTmpU[i][0] = NULL;
+    m_apTmpU[i][1] = NULL;
+  }
   m_pTmpL1 = NULL;
   m_pTmpL2 = NULL;
+  m_pTmpD  = NULL;
+  m_pcBandSAO    = NULL;
+  m_uiNumBandSAO = 0;
 }
 
 TComSampleAdaptiveOffset::~TComSampleAdaptiveOffset()
@@ -253,8 +263,12 @@ Void TComSampleAdaptiveOffset::create( UInt uiSourceWidth, UInt uiSourceHeight,
 
   m_pTmpL1 = new Pel [m_uiMaxCUHeight+1];
   m_pTmpL2 = new Pel [m_uiMaxCUHeight+1];
-  m_pTmpU1 = new Pel [m_iPicWidth];
-  m_pTmpU2 = new Pel [m_iPicWidth];
+  for (Int i=0; i<3; i++)
+  {
+    m_apTmpU[i][0] = new Pel [m_iPicWidth];
+    m_apTmpU[i][1] = new Pel [m_iPicWidth];
+  }
+  m_pTmpD = new Pel [m_iPicWidth];
 }
 
 /** destroy SampleAdaptiveOffset memory.
@@ -311,14 +325,32 @@ Void TComSampleAdaptiveOffset::destroy()
   {
     delete [] m_pTmpL2; m_pTmpL2 = NULL;
   }
-  if (m_pTmpU1)
+  for (Int i=0; i<3; i++)
+  {
+    if (m_apTmpU[i][0])
+    {
+      delete [] m_apTmpU[i][0]; m_apTmpU[i][0] = NULL;
+    }
+    if (m_apTmpU[i][1])
+    {
+      delete [] m_apTmpU[i][1]; m_apTmpU[i][1] = NULL;
+    }
+  }
+  m_pTmpU1 = NULL;
+  m_pTmpU2 = NULL;
+  if (m_pTmpD)
   {
-    delete [] m_pTmpU1; m_pTmpU1 = NULL;
+    delete [] m_pTmpD; m_pTmpD = NULL;
   }
-  if (m_pTmpU2)
+  if (m_pcBandSAO)
   {
-    delete [] m_pTmpU2; m_pTmpU2 = NULL;
+    for (UInt i=0; i<m_uiNumBandSAO; i++)
+    {
+      m_pcBandSAO[i].destroy();
+    }
+    delete [] m_pcBandSAO; m_pcBandSAO = NULL;
   }
+  m_uiNumBandSAO = 0;
 }
 
 /** allocate memory for SAO parameters
@@ -1033,30 +1065,44 @@ Void TComSampleAdaptiveOffset::processSaoCuOrg(Int iAddr, Int iSaoType, Int iYCb
  */
 Void TComSampleAdaptiveOffset::SAOProcess(SAOParam* pcSaoParam)
 {
-  {
-    m_uiSaoBitIncreaseY = max(g_bitDepthY - 10, 0);
-    m_uiSaoBitIncreaseC = max(g_bitDepthC - 10, 0);
+  SAOProcessRows(pcSaoParam, 0, m_pcPic->getFrameHeightInCU());
+  m_pcPic = NULL;
+}
 
-    if(m_bUseNIF)
-    {
-      m_pcPic->getPicYuvRec()->copyToPic(m_pcYuvTmp);
-    }
-    if (m_saoLcuBasedOptimization)
-    {
-      pcSaoParam->oneUnitFlag[0] = 0;  
-      pcSaoParam->oneUnitFlag[1] = 0;  
-      pcSaoParam->oneUnitFlag[2] = 0;  
-    }
-    Int iY  = 0;
-    {
-      processSaoUnitAll( pcSaoParam->saoLcuParam[iY], pcSaoParam->oneUnitFlag[iY], iY);
-    }
+/** Sample adaptive offset process of LCU rows, called for the rows of the picture from the top. The line above the
+ *  next row is kept before SAO for each component, so a row can be processed while the rows below are still deblocked
+ * \param pcSaoParam SAO parameters
+ * \param iFirstRow first LCU row, the rows above have been processed
+ * \param iNumRows number of LCU rows
+ */
+Void TComSampleAdaptiveOffset::SAOProcessRows(SAOParam* pcSaoParam, Int iFirstRow, Int iNumRows)
+{
+  m_uiSaoBitIncreaseY = max(g_bitDepthY - 10, 0);
+  m_uiSaoBitIncreaseC = max(g_bitDepthC - 10, 0);
+
+  if(m_bUseNIF)
+  {
+    m_pcPic->getPicYuvRec()->copyToPic(m_pcYuvTmp);
+    if (iFirstRow > 0)
     {
-       processSaoUnitAll( pcSaoParam->saoLcuParam[1], pcSaoParam->oneUnitFlag[1], 1);//Cb
-       processSaoUnitAll( pcSaoParam->saoLcuParam[2], pcSaoParam->oneUnitFlag[2], 2);//Cr
+      // the last line of the row above has been processed already, restore the samples read by this row
+      for (Int iYCbCr = 0; iYCbCr < 3; iYCbCr++)
+      {
+        Int  isChroma = (iYCbCr != 0) ? 1:0;
+        Int  stride   = (iYCbCr != 0) ? m_pcPic->getCStride() : m_pcPic->getStride();
+        Pel* pDec     = getPicYuvAddr(m_pcYuvTmp, iYCbCr, (iFirstRow-1)*m_pcPic->getFrameWidthInCU());
+        pDec += ((m_uiMaxCUHeight>>isChroma)-1)*stride;
+        memcpy(pDec, m_apTmpU[iYCbCr][0], sizeof(Pel)*(m_iPicWidth>>isChroma));
+      }
     }
-    m_pcPic = NULL;
   }
+  if (iFirstRow == 0 && m_saoLcuBasedOptimization)
+  {
+    pcSaoParam->oneUnitFlag[0] = 0;  
+    pcSaoParam->oneUnitFlag[1] = 0;  
+    pcSaoParam->oneUnitFlag[2] = 0;  
+  }
+  processSaoPicRows( pcSaoParam, true, true, iFirstRow, iNumRows);
 }
 
 Pel* TComSampleAdaptiveOffset::getPicYuvAddr(TComPicYuv* pcPicYuv, Int iYCbCr, Int iAddr)
@@ -1083,6 +1129,18 @@ Pel* TComSampleAdaptiveOffset::getPicYuvAddr(TComPicYuv* pcPicYuv, Int iYCbCr, I
  * \param yCbCr color componet index
  */
 Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, Int yCbCr)
+{
+  processSaoUnitRows(saoLcuParam, oneUnitFlag, yCbCr, 0, m_pcPic->getFrameHeightInCU());
+}
+
+/** Process SAO units of LCU rows, the rows above have been processed
+ * \param saoLcuParam SAO LCU parameters
+ * \param oneUnitFlag one unit flag
+ * \param yCbCr color componet index
+ * \param iFirstRow first LCU row
+ * \param iNumRows number of LCU rows
+ */
+Void TComSampleAdaptiveOffset::processSaoUnitRows(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, Int yCbCr, Int iFirstRow, Int iNumRows)
 {
   Pel *pRec;
   Int picWidthTmp;
@@ -1103,7 +1161,12 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
     picWidthTmp = m_iPicWidth>>1;
   }
 
-  memcpy(m_pTmpU1, pRec, sizeof(Pel)*picWidthTmp);
+  m_pTmpU1 = m_apTmpU[yCbCr][0];
+  m_pTmpU2 = m_apTmpU[yCbCr][1];
+  if (iFirstRow == 0)
+  {
+    memcpy(m_pTmpU1, pRec, sizeof(Pel)*picWidthTmp);
+  }
 
   Int  i;
   UInt edgeType;
@@ -1116,6 +1179,7 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
   Int idxX;
   Int idxY;
   Int addr;
+  Int paramIdx;
   Int frameWidthInCU = m_pcPic->getFrameWidthInCU();
   Int frameHeightInCU = m_pcPic->getFrameHeightInCU();
   Int stride;
@@ -1127,7 +1191,7 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
   pOffsetBo = (yCbCr==0) ? m_iOffsetBo : m_iChromaOffsetBo;
 
   offset[0] = 0;
-  for (idxY = 0; idxY< frameHeightInCU; idxY++)
+  for (idxY = iFirstRow; idxY< iFirstRow+iNumRows; idxY++)
   { 
     addr = idxY * frameWidthInCU;
     if (yCbCr == 0)
@@ -1165,11 +1229,13 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
 
       if (oneUnitFlag)
       {
+        paramIdx = 0;
         typeIdx = saoLcuParam[0].typeIdx;
-        mergeLeftFlag = (addr == 0)? 0:1;
+        mergeLeftFlag = (addr == iFirstRow * frameWidthInCU)? 0:1;
       }
       else
       {
+        paramIdx = addr;
         typeIdx = saoLcuParam[addr].typeIdx;
         mergeLeftFlag = saoLcuParam[addr].mergeLeftFlag;
       }
@@ -1184,9 +1250,9 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
             {
               offset[i] = 0;
             }
-            for (i=0; i<saoLcuParam[addr].length; i++)
+            for (i=0; i<saoLcuParam[paramIdx].length; i++)
             {
-              offset[ (saoLcuParam[addr].subTypeIdx +i)%SAO_MAX_BO_CLASSES  +1] = saoLcuParam[addr].offset[i] << saoBitIncrease;
+              offset[ (saoLcuParam[paramIdx].subTypeIdx +i)%SAO_MAX_BO_CLASSES  +1] = saoLcuParam[paramIdx].offset[i] << saoBitIncrease;
             }
 
             ppLumaTable = (yCbCr==0)?m_lumaTableBo:m_chromaTableBo;
@@ -1201,9 +1267,9 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
           }
           if (typeIdx == SAO_EO_0 || typeIdx == SAO_EO_1 || typeIdx == SAO_EO_2 || typeIdx == SAO_EO_3)
           {
-            for (i=0;i<saoLcuParam[addr].length;i++)
+            for (i=0;i<saoLcuParam[paramIdx].length;i++)
             {
-              offset[i+1] = saoLcuParam[addr].offset[i] << saoBitIncrease;
+              offset[i+1] = saoLcuParam[paramIdx].offset[i] << saoBitIncrease;
             }
             for (edgeType=0;edgeType<6;edgeType++)
             {
@@ -1245,7 +1311,132 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
     m_pTmpU1 = m_pTmpU2;
     m_pTmpU2 = tmpUSwap;
   }
+  m_apTmpU[yCbCr][0] = m_pTmpU1;
+  m_apTmpU[yCbCr][1] = m_pTmpU2;
+}
+
+/** Process SAO units of LCU rows for the three components, the rows above have been processed. Each component is
+ *  split in bands of LCU rows processed concurrently by private SAO, with the boundary lines of the bands copied
+ *  before SAO. The last row of a band reads the first line of the band below, it is processed once the other rows
+ *  are, with the saved line swapped in.
+ * \param pcSaoParam SAO parameters
+ * \param bLuma process the luma component
+ * \param bChroma process the chroma components
+ * \param iFirstRow first LCU row
+ * \param iNumRows number of LCU rows
+ */
+Void TComSampleAdaptiveOffset::processSaoPicRows(SAOParam* pcSaoParam, Bool bLuma, Bool bChroma, Int iFirstRow, Int iNumRows)
+{
+  if (iNumRows <= 0)
+  {
+    return;
+  }
+  Int frameWidthInCU = m_pcPic->getFrameWidthInCU();
+  Int numBands = max(1, iNumRows / SAO_MIN_BAND_ROWS);
+  xCreateBandSAO( 3*numBands );
 
+  for (Int yCbCr = 0; yCbCr < 3; yCbCr++)
+  {
+    Int stride = (yCbCr != 0) ? m_pcPic->getCStride() : m_pcPic->getStride();
+    Int width  = (yCbCr != 0) ? (m_iPicWidth>>1) : m_iPicWidth;
+    for (Int band = 0; band < numBands; band++)
+    {
+      TComSampleAdaptiveOffset* pcBandSAO = &m_pcBandSAO[yCbCr*numBands + band];
+      Int firstRow = iFirstRow + band*iNumRows/numBands;
+      Int endRow   = iFirstRow + (band+1)*iNumRows/numBands;
+
+      pcBandSAO->m_pcPic    = m_pcPic;
+      pcBandSAO->m_bUseNIF  = m_bUseNIF;
+      pcBandSAO->m_pcYuvTmp = m_pcYuvTmp;
+      pcBandSAO->m_uiSaoBitIncreaseY = m_uiSaoBitIncreaseY;
+      pcBandSAO->m_uiSaoBitIncreaseC = m_uiSaoBitIncreaseC;
+
+      // line above the band
+      if (band > 0)
+      {
+        Pel* pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), yCbCr, firstRow*frameWidthInCU);
+        memcpy(pcBandSAO->m_apTmpU[yCbCr][0], pRec-stride, sizeof(Pel)*width);
+      }
+      else if (firstRow > 0)
+      {
+        memcpy(pcBandSAO->m_apTmpU[yCbCr][0], m_apTmpU[yCbCr][0], sizeof(Pel)*width);
+      }
+      // line below the band
+      if (band < numBands-1)
+      {
+        Pel* pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), yCbCr, endRow*frameWidthInCU);
+        memcpy(pcBandSAO->m_pTmpD, pRec, sizeof(Pel)*width);
+      }
+    }
+  }
+
+  cilk_for (Int i = 0; i < 3*numBands; i++)
+  {
+    Int yCbCr = i / numBands;
+    Int band  = i % numBands;
+    if ((yCbCr == 0) ? bLuma : bChroma)
+    {
+      Int firstRow = iFirstRow + band*iNumRows/numBands;
+      Int endRow   = iFirstRow + (band+1)*iNumRows/numBands;
+      m_pcBandSAO[i].processSaoUnitRows( pcSaoParam->saoLcuParam[yCbCr], pcSaoParam->oneUnitFlag[yCbCr], yCbCr, firstRow, endRow-1-firstRow);
+    }
+  }
+
+  cilk_for (Int i = 0; i < 3*numBands; i++)
+  {
+    Int yCbCr = i / numBands;
+    Int band  = i % numBands;
+    if ((yCbCr == 0) ? bLuma : bChroma)
+    {
+      Int  width  = (yCbCr != 0) ? (m_iPicWidth>>1) : m_iPicWidth;
+      Int  endRow = iFirstRow + (band+1)*iNumRows/numBands;
+      Pel* pBelow = NULL;
+      if (band < numBands-1)
+      {
+        pBelow = getPicYuvAddr(m_pcPic->getPicYuvRec(), yCbCr, endRow*frameWidthInCU);
+        std::swap_ranges(pBelow, pBelow+width, m_pcBandSAO[i].m_pTmpD);
+      }
+      m_pcBandSAO[i].processSaoUnitRows( pcSaoParam->saoLcuParam[yCbCr], pcSaoParam->oneUnitFlag[yCbCr], yCbCr, endRow-1, 1);
+      if (pBelow)
+      {
+        std::swap_ranges(pBelow, pBelow+width, m_pcBandSAO[i].m_pTmpD);
+      }
+    }
+  }
+
+  // line above the next LCU row, for the rows processed by the next call
+  for (Int yCbCr = 0; yCbCr < 3; yCbCr++)
+  {
+    if ((yCbCr == 0) ? bLuma : bChroma)
+    {
+      Int width = (yCbCr != 0) ? (m_iPicWidth>>1) : m_iPicWidth;
+      memcpy(m_apTmpU[yCbCr][0], m_pcBandSAO[(yCbCr+1)*numBands-1].m_apTmpU[yCbCr][0], sizeof(Pel)*width);
+    }
+  }
+}
+
+/** allocate the private SAO of the component bands, with the configuration of this SAO
+ * \param uiNumBandSAO number of bands of the three components
+ */
+Void TComSampleAdaptiveOffset::xCreateBandSAO(UInt uiNumBandSAO)
+{
+  if (uiNumBandSAO > m_uiNumBandSAO)
+  {
+    if (m_pcBandSAO)
+    {
+      for (UInt i=0; i<m_uiNumBandSAO; i++)
+      {
+        m_pcBandSAO[i].destroy();
+      }
+      delete [] m_pcBandSAO;
+    }
+    m_pcBandSAO    = new TComSampleAdaptiveOffset[uiNumBandSAO];
+    m_uiNumBandSAO = uiNumBandSAO;
+    for (UInt i=0; i<uiNumBandSAO; i++)
+    {
+      m_pcBandSAO[i].create(m_iPicWidth, m_iPicHeight, m_uiMaxCUWidth, m_uiMaxCUHeight);
+    }
+  }
 }
 /** Reset SAO LCU part 
  * \param saoLcuParam
@@ -1372,20 +1563,33 @@ Void TComSampleAdaptiveOffset::copySaoUnit(SaoLcuParam* saoUnitDst, SaoLcuParam*
  */
 Void TComSampleAdaptiveOffset::PCMLFDisableProcess (TComPic* pcPic)
 {
-  xPCMRestoration(pcPic);
+  xPCMRestoration(pcPic, 0, pcPic->getNumCUsInFrame());
+}
+
+/** PCM LF disable process of LCU rows, once they have been filtered. 
+ * \param pcPic picture (TComPic) pointer
+ * \param uiFirstRow first LCU row
+ * \param uiNumRows number of LCU rows
+ * \returns Void
+ */
+Void TComSampleAdaptiveOffset::PCMLFDisableProcess (TComPic* pcPic, UInt uiFirstRow, UInt uiNumRows)
+{
+  xPCMRestoration(pcPic, uiFirstRow*pcPic->getFrameWidthInCU(), uiNumRows*pcPic->getFrameWidthInCU());
 }
 
-/** Picture-level PCM restoration. 
+/** PCM restoration of consecutive LCUs. 
  * \param pcPic picture (TComPic) pointer
+ * \param uiFirstCUAddr first LCU
+ * \param uiNumCUs number of LCUs
  * \returns Void
  */
-Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
+Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic, UInt uiFirstCUAddr, UInt uiNumCUs)
 {
   Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
 
   if(bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnableFlag())
   {
-    for( UInt uiCUAddr = 0; uiCUAddr < pcPic->getNumCUsInFrame() ; uiCUAddr++ )
+    for( UInt uiCUAddr = uiFirstCUAddr; uiCUAddr < uiFirstCUAddr+uiNumCUs ; uiCUAddr++ )
     {
       TComDataCU* pcCU = pcPic->getCU(uiCUAddr);
 
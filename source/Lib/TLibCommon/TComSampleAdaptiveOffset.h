@@ -53,6 +53,7 @@
 #define LUMA_GROUP_NUM                (1<<SAO_BO_BITS)
 #define MAX_NUM_SAO_OFFSETS           4
 #define MAX_NUM_SAO_CLASS             33
+#define SAO_MIN_BAND_ROWS             2     ///< minimum number of LCU rows of a band processed concurrently
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -99,13 +100,18 @@ protected:
 
   Pel* m_pTmpU1;
   Pel* m_pTmpU2;
+  Pel* m_apTmpU[3][2];   //!< per component, the line above the next LCU row before SAO and a spare line
   Pel* m_pTmpL1;
   Pel* m_pTmpL2;
+  Pel* m_pTmpD;          //!< the line below the LCU rows of a band before SAO
+  TComSampleAdaptiveOffset* m_pcBandSAO;   //!< private SAO of the component bands processed concurrently
+  UInt    m_uiNumBandSAO;
   Int     m_maxNumOffsetsPerPic;
   Bool    m_saoLcuBoundary;
   Bool    m_saoLcuBasedOptimization;
 
-  Void xPCMRestoration        (TComPic* pcPic);
+  Void xCreateBandSAO         (UInt uiNumBandSAO);
+  Void xPCMRestoration        (TComPic* pcPic, UInt uiFirstCUAddr, UInt uiNumCUs);
   Void xPCMCURestoration      (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth);
   Void xPCMSampleRestoration  (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, TextType ttText);
 public:
@@ -123,6 +129,7 @@ public:
   static Void freeSaoParam   (SAOParam *pcSaoParam);
   
   Void SAOProcess(SAOParam* pcSaoParam);
+  Void SAOProcessRows(SAOParam* pcSaoParam, Int iFirstRow, Int iNumRows);
   Void processSaoCu(Int iAddr, Int iSaoType, Int iYCbCr);
   Pel* getPicYuvAddr(TComPicYuv* pcPicYuv, Int iYCbCr,Int iAddr = 0);
 
@@ -135,6 +142,8 @@ public:
   Void convertQT2SaoUnit(SAOParam* saoParam, UInt partIdx, Int yCbCr);
   Void convertOnePart2SaoUnit(SAOParam *saoParam, UInt partIdx, Int yCbCr);
   Void processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, Int yCbCr);
+  Void processSaoUnitRows(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, Int yCbCr, Int iFirstRow, Int iNumRows);
+  Void processSaoPicRows(SAOParam* pcSaoParam, Bool bLuma, Bool bChroma, Int iFirstRow, Int iNumRows);
   Void setSaoLcuBoundary (Bool bVal)  {m_saoLcuBoundary = bVal;}
   Bool getSaoLcuBoundary ()           {return m_saoLcuBoundary;}
   Void setSaoLcuBasedOptimization (Bool bVal)  {m_saoLcuBasedOptimization = bVal;}
@@ -142,6 +151,7 @@ public:
   Void resetSaoUnit(SaoLcuParam* saoUnit);
   Void copySaoUnit(SaoLcuParam* saoUnitDst, SaoLcuParam* saoUnitSrc );
   Void PCMLFDisableProcess    ( TComPic* pcPic);                        ///< interface function for ALF process 
+  Void PCMLFDisableProcess    ( TComPic* pcPic, UInt uiFirstRow, UInt uiNumRows );
 };
 
 //! \}
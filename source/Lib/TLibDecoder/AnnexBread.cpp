@@ -40,6 +40,22 @@
 #include <stdint.h>
 #include <cassert>
 #include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANNEXB_SCAN_SSE2 1
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 #include "AnnexBread.h"
 
 using namespace std;
@@ -47,6 +63,172 @@ using namespace std;
 //! \ingroup TLibDecoder
 //! \{
 
+#if ANNEXB_SCAN_SSE2 || defined(__AVX2__)
+/** index of the lowest set bit of a non-zero mask */
+static inline UInt lowestSetBit(UInt mask)
+{
+#ifdef _MSC_VER
+  unsigned long idx;
+  _BitScanForward(&idx, mask);
+  return idx;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+size_t findZeroZeroByte(const uint8_t* data, size_t pos, size_t size, uint8_t maxThirdByte)
+{
+  /* a lane is a candidate when its byte and the next one are zero and the
+   * byte after them is not greater than maxThirdByte */
+#if defined(__AVX2__)
+  const __m256i zero32      = _mm256_setzero_si256();
+  const __m256i maxThird32  = _mm256_set1_epi8(maxThirdByte);
+  while (pos + 32 + 2 <= size)
+  {
+    __m256i first  = _mm256_loadu_si256((const __m256i*)(data + pos));
+    __m256i second = _mm256_loadu_si256((const __m256i*)(data + pos + 1));
+    __m256i third  = _mm256_loadu_si256((const __m256i*)(data + pos + 2));
+    __m256i match  = _mm256_and_si256(_mm256_cmpeq_epi8(first, zero32), _mm256_cmpeq_epi8(second, zero32));
+    match = _mm256_and_si256(match, _mm256_cmpeq_epi8(_mm256_min_epu8(third, maxThird32), third));
+    UInt mask = (UInt)_mm256_movemask_epi8(match);
+    if (mask)
+    {
+      return pos + lowestSetBit(mask);
+    }
+    pos += 32;
+  }
+#endif
+#if ANNEXB_SCAN_SSE2
+  const __m128i zero     = _mm_setzero_si128();
+  const __m128i maxThird = _mm_set1_epi8(maxThirdByte);
+  while (pos + 16 + 2 <= size)
+  {
+    __m128i first  = _mm_loadu_si128((const __m128i*)(data + pos));
+    __m128i second = _mm_loadu_si128((const __m128i*)(data + pos + 1));
+    __m128i third  = _mm_loadu_si128((const __m128i*)(data + pos + 2));
+    __m128i match  = _mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero));
+    match = _mm_and_si128(match, _mm_cmpeq_epi8(_mm_min_epu8(third, maxThird), third));
+    UInt mask = (UInt)_mm_movemask_epi8(match);
+    if (mask)
+    {
+      return pos + lowestSetBit(mask);
+    }
+    pos += 16;
+  }
+#endif
+  for (; pos + 3 <= size; pos++)
+  {
+    if (data[pos] == 0 && data[pos+1] == 0 && data[pos+2] <= maxThirdByte)
+    {
+      return pos;
+    }
+  }
+  return size;
+}
+
+InputByteStream::~InputByteStream()
+{
+#ifndef _WIN32
+  if (m_pMapped)
+  {
+    munmap((void*)m_pMapped, m_uiMappedSize);
+  }
+#endif
+}
+
+Bool InputByteStream::map(const Char* fileName)
+{
+#ifndef _WIN32
+  Int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+  Void* pMapped = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (pMapped == MAP_FAILED)
+  {
+    return false;
+  }
+  madvise(pMapped, fileStat.st_size, MADV_SEQUENTIAL);
+  m_pMapped      = (const uint8_t*)pMapped;
+  m_uiMappedSize = fileStat.st_size;
+  m_uiMappedPos  = 0;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Extract a single nalUnit from the size bytes of a mapped AnnexB
+ * Bytestream data, from position pos, while accumulating bytestream
+ * statistics into stats.  The steps are the ones of the stream parser
+ * below, the NAL unit is copied at once once its end has been located.
+ *
+ * Returns true if the end of the data was reached (NB, nalunit data may
+ * be valid), otherwise false.
+ */
+static Bool
+_mappedNALUnit(
+  const uint8_t* data,
+  size_t size,
+  size_t& pos,
+  vector<uint8_t>& nalUnit,
+  AnnexBStats& stats)
+{
+  /* leading_zero_8bits, up to the next three or four byte start code */
+  while (!(pos + 3 <= size && data[pos] == 0 && data[pos+1] == 0 && data[pos+2] == 1)
+  &&     !(pos + 4 <= size && data[pos] == 0 && data[pos+1] == 0 && data[pos+2] == 0 && data[pos+3] == 1))
+  {
+    if (pos == size)
+    {
+      return true;
+    }
+    assert(data[pos] == 0);
+    stats.m_numLeadingZero8BitsBytes++;
+    pos++;
+  }
+
+  /* zero_byte */
+  if (data[pos+2] != 1)
+  {
+    stats.m_numZeroByteBytes++;
+    pos++;
+  }
+
+  /* start_code_prefix_one_3bytes */
+  pos += 3;
+  stats.m_numStartCodePrefixBytes += 3;
+
+  /* the NAL unit ends before the next byte-aligned 0x000000, 0x000001
+   * or 0x000002, or at the end of the data */
+  size_t start = pos;
+  pos = findZeroZeroByte(data, pos, size, 2);
+  nalUnit.assign(data + start, data + pos);
+
+  /* trailing_zero_8bits, up to the next start code */
+  while (!(pos + 3 <= size && data[pos] == 0 && data[pos+1] == 0 && data[pos+2] == 1)
+  &&     !(pos + 4 <= size && data[pos] == 0 && data[pos+1] == 0 && data[pos+2] == 0 && data[pos+3] == 1))
+  {
+    if (pos == size)
+    {
+      return true;
+    }
+    assert(data[pos] == 0);
+    stats.m_numTrailingZero8BitsBytes++;
+    pos++;
+  }
+  return false;
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -159,6 +341,12 @@ byteStreamNALUnit(
   AnnexBStats& stats)
 {
   Bool eof = false;
+  if (bs.m_pMapped)
+  {
+    eof = _mappedNALUnit(bs.m_pMapped, bs.m_uiMappedSize, bs.m_uiMappedPos, nalUnit, stats);
+    stats.m_numBytesInNALUnit = UInt(nalUnit.size());
+    return eof;
+  }
   try
   {
     _byteStreamNALUnit(bs, nalUnit, stats);
@@ -47,6 +47,8 @@
 //! \ingroup TLibDecoder
 //! \{
 
+struct AnnexBStats;
+
 class InputByteStream
 {
 public:
@@ -63,10 +65,23 @@ public:
   : m_NumFutureBytes(0)
   , m_FutureBytes(0)
   , m_Input(istream)
+  , m_pMapped(NULL)
+  , m_uiMappedSize(0)
+  , m_uiMappedPos(0)
   {
     istream.exceptions(std::istream::eofbit);
   }
 
+  ~InputByteStream();
+
+  /**
+   * Map the file fileName in memory, the NAL units are then located
+   * directly in the mapped bytes and istream is not read.  Returns
+   * false, the bytes being read from istream, when the file cannot be
+   * mapped (e.g. a pipe).
+   */
+  Bool map(const Char* fileName);
+
   /**
    * Reset the internal state.  Must be called if input stream is
    * modified externally to this class
@@ -157,6 +172,12 @@ private:
   UInt m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
   uint32_t m_FutureBytes; /* bytes that have been peeked */
   std::istream& m_Input; /* Input stream to read from */
+
+  const uint8_t* m_pMapped; /* mapped input file, NULL when reading from m_Input */
+  size_t m_uiMappedSize; /* size of the mapped input file */
+  size_t m_uiMappedPos; /* position of the next byte in the mapped input file */
+
+  friend Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 };
 
 /**
@@ -183,4 +204,12 @@ struct AnnexBStats
 
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
+/**
+ * Return the position of the first byte-aligned three-byte sequence
+ * 0x00 0x00 xx, with xx <= maxThirdByte, at or after pos in the size
+ * bytes of data, or size if there is none.  The data is scanned 16 (32
+ * with AVX2) bytes at a time when SSE2 is available.
+ */
+size_t findZeroZeroByte(const uint8_t* data, size_t pos, size_t size, uint8_t maxThirdByte);
+
 //! \}
@@ -40,8 +40,10 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <cstring>
 
 #include "NALread.h"
+#include "AnnexBread.h"
 #include "TLibCommon/NAL.h"
 #include "TLibCommon/TComBitStream.h"
 
@@ -54,9 +56,47 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream
   UInt zeroCount = 0;
   vector<uint8_t>::iterator it_read, it_write;
 
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+
+  // the bytes up to the next 0x000000-0x000003 sequence are moved at once, the sequences are found by
+  // findZeroZeroByte; a 0x000000-0x000002 sequence is left to the byte loop
+  uint8_t* data = nalUnitBuf.empty() ? NULL : &nalUnitBuf[0];
+  size_t   size = nalUnitBuf.size();
+  size_t   read = 0;
+  size_t   write = 0;
+  while (read < size)
+  {
+    size_t next = findZeroZeroByte(data, read, size, 0x03);
+    size_t numBytes = (next == size) ? size - read : next + 2 - read;
+    if (next == size)
+    {
+      // zeros ending the payload, checked below
+      for (size_t i = size; i > read && data[i-1] == 0x00; i--)
+      {
+        zeroCount++;
+      }
+    }
+    if (write != read)
+    {
+      memmove(data + write, data + read, numBytes);
+    }
+    read  += numBytes;
+    write += numBytes;
+    if (next == size)
+    {
+      break;
+    }
+    if (data[read] != 0x03)
+    {
+      zeroCount = 2;
+      break;
+    }
+    bitstream->pushEmulationPreventionByteLocation( (UInt)read );
+    read++;
+  }
+
+  UInt pos = (UInt)read;
+  for (it_read = nalUnitBuf.begin() + read, it_write = nalUnitBuf.begin() + write; it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
   {
     assert(zeroCount < 2 || *it_read >= 0x03);
     if (zeroCount == 2 && *it_read == 0x03)
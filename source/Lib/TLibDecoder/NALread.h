@@ -58,5 +58,6 @@ struct InputNALUnit : public NALUnit
 };
 
 void read(InputNALUnit& nalu, std::vector<uint8_t>& nalUnitBuf);
+Void readNalUnitHeader(InputNALUnit& nalu);
 
 //! \}
@@ -1313,6 +1313,14 @@ Void TDecCavlc::parseSliceHeader (TComSlice*& rpcSlice, ParameterSetManagerDecod
         rpcSlice->setTileLocation( idx, prevPos + entryPointOffset [ idx ] );
         prevPos += entryPointOffset[ idx ];
       }
+
+      // substream sizes, used when the tiles are decoded concurrently
+      rpcSlice->allocSubstreamSizes( numEntryPointOffsets+1 );
+      UInt *pSubstreamSizes = rpcSlice->getSubstreamSizes();
+      for (Int idx=0; idx<numEntryPointOffsets; idx++)
+      {
+        pSubstreamSizes[ idx ] = ( entryPointOffset[ idx ] << 3 );
+      }
     }
     else if ( pps->getEntropyCodingSyncEnabledFlag() )
     {
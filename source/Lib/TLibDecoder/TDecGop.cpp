@@ -59,11 +59,13 @@ TDecGop::TDecGop()
   m_dDecTime = 0;
   m_pcSbacDecoders = NULL;
   m_pcBinCABACs = NULL;
+  m_bFilterThread = false;
+  m_bFilterExit = false;
 }
 
 TDecGop::~TDecGop()
 {
-  
+  stopFilterThread();
 }
 
 Void TDecGop::create()
@@ -123,7 +125,9 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic)
   m_pcSbacDecoder->init( (TDecBinIf*)m_pcBinCABAC );
   m_pcEntropyDecoder->setEntropyDecoder (m_pcSbacDecoder);
 
-  UInt uiNumSubstreams = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcSlice->getNumEntryPointOffsets()+1 : pcSlice->getPPS()->getNumSubstreams();
+  // tiles decoded concurrently are split into one substream per tile, like the wavefront rows
+  Bool bSplitSubstreams = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() || m_pcSliceDecoder->getParallelTiles( pcSlice );
+  UInt uiNumSubstreams = bSplitSubstreams ? pcSlice->getNumEntryPointOffsets()+1 : pcSlice->getPPS()->getNumSubstreams();
 
   // init each couple {EntropyDecoder, Substream}
   UInt *puiSubstreamSizes = pcSlice->getSubstreamSizes();
@@ -169,7 +173,328 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic)
 
 Void TDecGop::filterPicture(TComPic*& rpcPic)
 {
-  TComSlice*  pcSlice = rpcPic->getSlice(rpcPic->getCurrSliceIdx());
+  TDecFilterJob cJob;
+  xPrepareFilterJob( rpcPic, cJob );
+  xFilterPicture( cJob );
+
+  rpcPic->setOutputMark(true);
+  rpcPic->setReconMark(true);
+}
+
+/** start the thread running the loop filters of the decoded pictures, pictures are filtered inline if it cannot be
+ *  started
+ */
+Void TDecGop::startFilterThread()
+{
+  if ( m_bFilterThread )
+  {
+    return;
+  }
+  m_bFilterExit = false;
+  pthread_mutex_init( &m_cFilterMutex, NULL );
+  pthread_cond_init( &m_cFilterCond, NULL );
+  m_bFilterThread = ( pthread_create( &m_cFilterThread, NULL, xFilterThreadMain, this ) == 0 );
+  if ( !m_bFilterThread )
+  {
+    pthread_cond_destroy( &m_cFilterCond );
+    pthread_mutex_destroy( &m_cFilterMutex );
+  }
+}
+
+/** filter the queued pictures and stop the filter thread
+ */
+Void TDecGop::stopFilterThread()
+{
+  if ( !m_bFilterThread )
+  {
+    return;
+  }
+  pthread_mutex_lock( &m_cFilterMutex );
+  m_bFilterExit = true;
+  for ( std::list<TDecFilterJob>::iterator it = m_cFilterQueue.begin(); it != m_cFilterQueue.end(); it++ )
+  {
+    if ( !it->bDecoded )
+    {
+      // the decoding of the picture is given up, let the filter thread run through its rows
+      it->pcPic->setReconRows( it->pcPic->getFrameHeightInCU() );
+    }
+  }
+  pthread_cond_broadcast( &m_cFilterCond );
+  pthread_mutex_unlock( &m_cFilterMutex );
+  pthread_join( m_cFilterThread, NULL );
+  m_bFilterThread = false;
+
+  pthread_cond_destroy( &m_cFilterCond );
+  pthread_mutex_destroy( &m_cFilterMutex );
+}
+
+/** hand a picture about to be decoded over to the filter thread, which filters its LCU rows as they are
+ *  reconstructed. Called once the first slice of the picture is set up
+ * \param pcPic picture to decode
+ */
+Void TDecGop::startFilterPicture( TComPic* pcPic )
+{
+  if ( !m_bFilterThread )
+  {
+    return;
+  }
+  pcPic->initReconRows();
+
+  TDecFilterJob cJob;
+  cJob.pcPic      = pcPic;
+  cJob.bDecoded   = false;
+  cJob.pcSlice    = NULL;
+  cJob.dDecTime   = 0;
+  cJob.cSliceType = 0;
+
+  pthread_mutex_lock( &m_cFilterMutex );
+  m_cFilterQueue.push_back( cJob );
+  pthread_cond_broadcast( &m_cFilterCond );
+  pthread_mutex_unlock( &m_cFilterMutex );
+}
+
+/** hand the slice boundaries of a decoded picture over to the filter thread. The picture is marked for output and
+ *  its border as extended right away, the samples and the compressed motion are published with
+ *  TComPicYuv::setReadyLines() as the loop filters go through the rows
+ * \param pcPic decoded picture
+ */
+Void TDecGop::queueFilterPicture( TComPic* pcPic )
+{
+  if ( !m_bFilterThread )
+  {
+    filterPicture( pcPic );
+    return;
+  }
+
+  pcPic->setOutputMark(true);
+  pcPic->setReconMark(true);
+  pcPic->getPicYuvRec()->setBorderExtension( true );
+
+  pthread_mutex_lock( &m_cFilterMutex );
+  if ( m_cFilterQueue.empty() || m_cFilterQueue.back().pcPic != pcPic || m_cFilterQueue.back().bDecoded )
+  {
+    // the picture was not started, its rows are filtered now
+    TDecFilterJob cJob;
+    cJob.pcPic = pcPic;
+    m_cFilterQueue.push_back( cJob );
+  }
+  TDecFilterJob& rcJob = m_cFilterQueue.back();
+  xPrepareFilterJob( pcPic, rcJob );
+  rcJob.bDecoded = true;
+  pthread_cond_broadcast( &m_cFilterCond );
+  pthread_mutex_unlock( &m_cFilterMutex );
+
+  pcPic->setReconRows( pcPic->getFrameHeightInCU() );
+}
+
+/** wait until the loop filters of all decoded pictures are done, the picture being decoded is not waited for
+ */
+Void TDecGop::waitFilterPictures()
+{
+  if ( !m_bFilterThread )
+  {
+    return;
+  }
+  pthread_mutex_lock( &m_cFilterMutex );
+  while ( !m_cFilterQueue.empty() && m_cFilterQueue.front().bDecoded )
+  {
+    pthread_cond_wait( &m_cFilterCond, &m_cFilterMutex );
+  }
+  pthread_mutex_unlock( &m_cFilterMutex );
+}
+
+/** take the slice boundaries and the decoding time of a picture, which restart for the next picture
+ * \param pcPic picture whose slices have all been decoded
+ * \param rcJob loop filter job of the picture
+ */
+Void TDecGop::xPrepareFilterJob( TComPic* pcPic, TDecFilterJob& rcJob )
+{
+  TComSlice* pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+
+  rcJob.pcPic = pcPic;
+  rcJob.pcSlice = pcSlice;
+  rcJob.sliceStartCUAddress.swap( m_sliceStartCUAddress );
+  rcJob.LFCrossSliceBoundaryFlag.swap( m_LFCrossSliceBoundaryFlag );
+  m_sliceStartCUAddress.clear();
+  m_LFCrossSliceBoundaryFlag.clear();
+  rcJob.dDecTime = m_dDecTime;
+  m_dDecTime = 0;
+
+  rcJob.cSliceType = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
+  if (!pcSlice->isReferenced()) rcJob.cSliceType += 32;
+}
+
+Void* TDecGop::xFilterThreadMain( Void* pArg )
+{
+  static_cast<TDecGop*>( pArg )->xRunFilter();
+  return NULL;
+}
+
+/** filter loop, runs until it is asked to terminate and the queue is empty. The front job stays queued while it is
+ *  processed, so that waitFilterPictures() returns once the last picture is published
+ */
+Void TDecGop::xRunFilter()
+{
+  pthread_mutex_lock( &m_cFilterMutex );
+  while ( true )
+  {
+    while ( m_cFilterQueue.empty() && !m_bFilterExit )
+    {
+      pthread_cond_wait( &m_cFilterCond, &m_cFilterMutex );
+    }
+    if ( m_cFilterQueue.empty() )
+    {
+      break;
+    }
+    TDecFilterJob& rcJob = m_cFilterQueue.front();
+    pthread_mutex_unlock( &m_cFilterMutex );
+
+    xFilterRows( rcJob );
+
+    pthread_mutex_lock( &m_cFilterMutex );
+    m_cFilterQueue.pop_front();
+    pthread_cond_broadcast( &m_cFilterCond );
+  }
+  pthread_mutex_unlock( &m_cFilterMutex );
+}
+
+/** run the loop filters of a picture while it is decoded, LCU row by LCU row. A row is deblocked once the row below
+ *  is reconstructed, as intra prediction reads its last line, and goes through SAO once the row below is deblocked.
+ *  SAO of the rows stops at the first slice or tile boundary it may not cross, the remaining rows are processed when
+ *  all slices of the picture are known
+ * \param rcJob loop filter job of the picture
+ */
+Void TDecGop::xFilterRows( TDecFilterJob& rcJob )
+{
+  TComPic*    pcPic       = rcJob.pcPic;
+  TComSlice*  pcSlice     = pcPic->getSlice(0);
+  Int         iHeightInCU = pcPic->getFrameHeightInCU();
+  UInt        uiWidthInCU = pcPic->getFrameWidthInCU();
+  Bool        bUseSAO     = pcSlice->getSPS()->getUseSAO();
+  SAOParam*   saoParam    = pcPic->getPicSym()->getSaoParam();
+  Double      dFilterTime = 0;
+
+  Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+  m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
+
+  Bool bSaoRows           = bUseSAO && ( bLFCrossTileBoundary || pcPic->getPicSym()->getNumTiles() == 1 );
+  Bool bMultipleSlices    = false;
+  Bool bIndependentSlices = false;
+  Int  iCheckedRows       = 0;
+  Int  iFinishedRows      = 0;
+  if ( bSaoRows )
+  {
+    m_pcSAO->setSaoLcuBasedOptimization(1);
+    m_pcSAO->createPicSaoInfo(pcPic);
+  }
+
+  for ( Int iRow = 0; iRow < iHeightInCU; iRow++ )
+  {
+    pcPic->waitReconRows( min(iRow+2, iHeightInCU) );
+    long iBeforeTime = clock();
+
+    m_pcLoopFilter->loopFilterRow( pcPic, iRow );
+    // the deblocking of the rows above is final, and of the last row once it is deblocked itself
+    Int iFinalRows = ( iRow+1 < iHeightInCU ) ? iRow : iHeightInCU;
+
+    if ( bSaoRows )
+    {
+      // SAO of a row reads the samples of the rows next to it
+      for ( ; iCheckedRows < min(iFinalRows+1, iHeightInCU); iCheckedRows++ )
+      {
+        for ( UInt uiCUAddr = iCheckedRows*uiWidthInCU; uiCUAddr < (iCheckedRows+1)*uiWidthInCU; uiCUAddr++ )
+        {
+          TComSlice* pcCUSlice = pcPic->getCU( uiCUAddr )->getSlice();
+          bMultipleSlices    = bMultipleSlices    || pcCUSlice->getSliceCurStartCUAddr() != 0;
+          bIndependentSlices = bIndependentSlices || !pcCUSlice->getLFCrossSliceBoundaryFlag();
+        }
+      }
+      bSaoRows = !( bMultipleSlices && bIndependentSlices );
+      if ( bSaoRows && iFinalRows > iFinishedRows )
+      {
+        m_pcSAO->SAOProcessRows( saoParam, iFinishedRows, iFinalRows-iFinishedRows );
+      }
+    }
+    if ( !bUseSAO || bSaoRows )
+    {
+      xFinishRows( pcPic, iFinishedRows, iFinalRows-iFinishedRows, bUseSAO );
+      iFinishedRows = iFinalRows;
+    }
+    dFilterTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+  }
+
+  pthread_mutex_lock( &m_cFilterMutex );
+  while ( !rcJob.bDecoded && !m_bFilterExit )
+  {
+    pthread_cond_wait( &m_cFilterCond, &m_cFilterMutex );
+  }
+  Bool bDecoded = rcJob.bDecoded;
+  pthread_mutex_unlock( &m_cFilterMutex );
+
+  if ( bDecoded )
+  {
+    long iBeforeTime = clock();
+    if ( bUseSAO && iFinishedRows < iHeightInCU )
+    {
+      // non-cross slice or tile boundary SAO of the remaining rows
+      rcJob.sliceStartCUAddress.push_back(pcPic->getNumCUsInFrame()* pcPic->getNumPartInCU());
+      pcPic->createNonDBFilterInfo(rcJob.sliceStartCUAddress, 0, &rcJob.LFCrossSliceBoundaryFlag, pcPic->getPicSym()->getNumTiles(), bLFCrossTileBoundary);
+      m_pcSAO->setSaoLcuBasedOptimization(1);
+      m_pcSAO->createPicSaoInfo(pcPic);
+      m_pcSAO->SAOProcessRows( saoParam, iFinishedRows, iHeightInCU-iFinishedRows );
+      xFinishRows( pcPic, iFinishedRows, iHeightInCU-iFinishedRows, true );
+      m_pcSAO->destroyPicSaoInfo();
+      pcPic->destroyNonDBFilterInfo();
+    }
+    else if ( bUseSAO )
+    {
+      m_pcSAO->destroyPicSaoInfo();
+    }
+    rcJob.dDecTime += dFilterTime + (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+    xPrintPicture( rcJob );
+  }
+  pcPic->getPicYuvRec()->setReadyLines( MAX_INT );
+}
+
+/** restore the PCM and lossless samples of filtered LCU rows, compress their motion and publish them with the
+ *  margins beside them
+ * \param pcPic picture being filtered
+ * \param iFirstRow first LCU row
+ * \param iNumRows number of LCU rows
+ * \param bRestorePCM the rows went through SAO
+ */
+Void TDecGop::xFinishRows( TComPic* pcPic, Int iFirstRow, Int iNumRows, Bool bRestorePCM )
+{
+  if ( iNumRows <= 0 )
+  {
+    return;
+  }
+  TComPicYuv* pcPicYuvRec = pcPic->getPicYuvRec();
+  UInt        uiWidthInCU = pcPic->getFrameWidthInCU();
+  Int         iCUHeight   = pcPic->getSlice(0)->getSPS()->getMaxCUHeight();
+
+  if ( bRestorePCM )
+  {
+    m_pcSAO->PCMLFDisableProcess( pcPic, iFirstRow, iNumRows );
+  }
+  for ( UInt uiCUAddr = iFirstRow*uiWidthInCU; uiCUAddr < (iFirstRow+iNumRows)*uiWidthInCU; uiCUAddr++ )
+  {
+    pcPic->getCU( uiCUAddr )->compressMV();
+  }
+
+  Int iFirstLine = iFirstRow*iCUHeight;
+  Int iEndLine   = min( (iFirstRow+iNumRows)*iCUHeight, pcPicYuvRec->getHeight() );
+  pcPicYuvRec->extendPicBorder( iFirstLine, iEndLine-iFirstLine );
+  pcPicYuvRec->setReadyLines( iEndLine );
+}
+
+/** run the loop filters of a decoded picture, compress its motion and print its summary
+ * \param rcJob loop filter job of the picture
+ */
+Void TDecGop::xFilterPicture( TDecFilterJob& rcJob )
+{
+  TComPic*    rpcPic  = rcJob.pcPic;
+  TComSlice*  pcSlice = rcJob.pcSlice;
 
   //-- For time output for each slice
   long iBeforeTime = clock();
@@ -181,10 +506,9 @@ Void TDecGop::filterPicture(TComPic*& rpcPic)
 
   if(pcSlice->getSPS()->getUseSAO())
   {
-    m_sliceStartCUAddress.push_back(rpcPic->getNumCUsInFrame()* rpcPic->getNumPartInCU());
-    rpcPic->createNonDBFilterInfo(m_sliceStartCUAddress, 0, &m_LFCrossSliceBoundaryFlag, rpcPic->getPicSym()->getNumTiles(), bLFCrossTileBoundary);
+    rcJob.sliceStartCUAddress.push_back(rpcPic->getNumCUsInFrame()* rpcPic->getNumPartInCU());
+    rpcPic->createNonDBFilterInfo(rcJob.sliceStartCUAddress, 0, &rcJob.LFCrossSliceBoundaryFlag, rpcPic->getPicSym()->getNumTiles(), bLFCrossTileBoundary);
   }
-
   if( pcSlice->getSPS()->getUseSAO() )
   {
     {
@@ -205,18 +529,27 @@ Void TDecGop::filterPicture(TComPic*& rpcPic)
   }
 
   rpcPic->compressMotion(); 
-  Char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced()) c += 32;
 
   //-- For time output for each slice
+  rcJob.dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+  xPrintPicture( rcJob );
+}
+
+/** print the summary of a filtered picture and check its decoded picture hash
+ * \param rcJob loop filter job of the picture
+ */
+Void TDecGop::xPrintPicture( TDecFilterJob& rcJob )
+{
+  TComPic*    rpcPic  = rcJob.pcPic;
+  TComSlice*  pcSlice = rcJob.pcSlice;
+  Char c = rcJob.cSliceType;
+
   printf("\nPOC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getPOC(),
                                                     pcSlice->getTLayer(),
                                                     c,
                                                     pcSlice->getSliceQp() );
 
-  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
-  printf ("[DT %6.3f] ", m_dDecTime );
-  m_dDecTime  = 0;
+  printf ("[DT %6.3f] ", rcJob.dDecTime );
 
   for (Int iRefList = 0; iRefList < 2; iRefList++)
   {
@@ -237,11 +570,6 @@ Void TDecGop::filterPicture(TComPic*& rpcPic)
     }
     calcAndPrintHashStatus(*rpcPic->getPicYuvRec(), hash);
   }
-
-  rpcPic->setOutputMark(true);
-  rpcPic->setReconMark(true);
-  m_sliceStartCUAddress.clear();
-  m_LFCrossSliceBoundaryFlag.clear();
 }
 
 /**
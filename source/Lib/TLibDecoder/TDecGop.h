@@ -55,9 +55,24 @@
 #include "TDecBinCoder.h"
 #include "TDecBinCoderCABAC.h"
 
+#include <pthread.h>
+#include <list>
+
 //! \ingroup TLibDecoder
 //! \{
 
+/// loop filter job of a picture: the slice boundaries and the decoding time of the picture, known once it is decoded
+struct TDecFilterJob
+{
+  TComPic*              pcPic;
+  Bool                  bDecoded;             ///< all slices of the picture are decoded, the fields below are set
+  TComSlice*            pcSlice;              ///< last slice of the picture, the current slice index is reset when the DPB is sorted
+  std::vector<Int>      sliceStartCUAddress;
+  std::vector<Bool>     LFCrossSliceBoundaryFlag;
+  Double                dDecTime;
+  Char                  cSliceType;           ///< slice type printed in the picture summary, lower case if not referenced
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -86,6 +101,23 @@ private:
   std::vector<Int> m_sliceStartCUAddress;
   std::vector<Bool> m_LFCrossSliceBoundaryFlag;
 
+  // frame-parallel decoding: the loop filters of a picture run on a thread, LCU row by LCU row behind its
+  // reconstruction, while the next pictures are decoded
+  Bool                     m_bFilterThread;          ///< the filter thread is running
+  Bool                     m_bFilterExit;            ///< the filter thread exits once the queue is empty
+  std::list<TDecFilterJob> m_cFilterQueue;           ///< pictures being decoded or waiting for their loop filters, in decoding order
+  pthread_t                m_cFilterThread;
+  pthread_mutex_t          m_cFilterMutex;
+  pthread_cond_t           m_cFilterCond;            ///< signalled when a job is queued, decoded or completed
+
+  Void  xPrepareFilterJob  ( TComPic* pcPic, TDecFilterJob& rcJob );
+  Void  xFilterPicture     ( TDecFilterJob& rcJob );
+  Void  xFilterRows        ( TDecFilterJob& rcJob );
+  Void  xFinishRows        ( TComPic* pcPic, Int iFirstRow, Int iNumRows, Bool bRestorePCM );
+  Void  xPrintPicture      ( TDecFilterJob& rcJob );
+  static Void* xFilterThreadMain( Void* pArg );
+  Void  xRunFilter         ();
+
 public:
   TDecGop();
   virtual ~TDecGop();
@@ -103,6 +135,13 @@ public:
   Void  decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic );
   Void  filterPicture  (TComPic*& rpcPic );
 
+  Void  startFilterThread  ();
+  Void  stopFilterThread   ();
+  Bool  getFilterThread    ()                 { return m_bFilterThread; }
+  Void  startFilterPicture ( TComPic* pcPic );
+  Void  queueFilterPicture ( TComPic* pcPic );
+  Void  waitFilterPictures ();
+
   void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
 
 };
@@ -36,6 +36,7 @@
 */
 
 #include "TDecSlice.h"
+#include <cilk/cilk.h>
 
 //! \ingroup TLibDecoder
 //! \{
@@ -50,10 +51,21 @@ TDecSlice::TDecSlice()
   m_pcBufferBinCABACs    = NULL;
   m_pcBufferLowLatSbacDecoders = NULL;
   m_pcBufferLowLatBinCABACs    = NULL;
+  m_pcBufferRowSbacDecoders    = NULL;
+  m_pcBufferRowBinCABACs       = NULL;
+  m_pcWorkers                  = NULL;
+  m_iNumWorkers                = 0;
+  m_pcReconWorker              = NULL;
+  m_bReconThread               = false;
+  m_bReconExit                 = false;
+  m_pcReconPic                 = NULL;
+  m_uiNumParsedCUs             = 0;
+  m_uiNumReconCUs              = 0;
 }
 
 TDecSlice::~TDecSlice()
 {
+  stopReconThread();
   for (std::vector<TDecSbac*>::iterator i = CTXMem.begin(); i != CTXMem.end(); i++)
   {
     delete (*i);
@@ -97,6 +109,16 @@ Void TDecSlice::destroy()
     delete[] m_pcBufferLowLatBinCABACs;
     m_pcBufferLowLatBinCABACs = NULL;
   }
+  if ( m_pcBufferRowSbacDecoders )
+  {
+    delete[] m_pcBufferRowSbacDecoders;
+    m_pcBufferRowSbacDecoders = NULL;
+  }
+  if ( m_pcBufferRowBinCABACs )
+  {
+    delete[] m_pcBufferRowBinCABACs;
+    m_pcBufferRowBinCABACs = NULL;
+  }
 }
 
 Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder)
@@ -132,6 +154,78 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
   TComSlice*  pcSlice = rpcPic->getSlice(rpcPic->getCurrSliceIdx());
   Int  iNumSubstreams = pcSlice->getPPS()->getNumSubstreams();
 
+  if ( getParallelTiles( pcSlice ) )
+  {
+    // the slice holds complete tiles, each of them coded in its own substream
+    UInt uiFirstTile = rpcPic->getPicSym()->getTileIdxMap(iStartCUAddr);
+    UInt uiNumTiles  = pcSlice->getNumEntryPointOffsets()+1;
+    assert( iStartCUAddr == rpcPic->getPicSym()->getTComTile(uiFirstTile)->getFirstCUAddr() );
+
+    if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
+    {
+      SAOParam *saoParam = rpcPic->getPicSym()->getSaoParam();
+      saoParam->bSaoFlag[0] = pcSlice->getSaoEnabledFlag();
+      saoParam->bSaoFlag[1] = pcSlice->getSaoEnabledFlagChroma();
+    }
+    for (UInt ui = 0; ui < uiNumTiles; ui++)
+    {
+      m_pcWorkers[ui].initSlice( pcSlice );
+    }
+    cilk_for (UInt ui = 0; ui < uiNumTiles; ui++)
+    {
+      xDecompressTile( &m_pcWorkers[ui], ppcSubstreams[ui], &pcSbacDecoders[ui], rpcPic, uiFirstTile+ui );
+    }
+    return;
+  }
+
+  if ( getParallelRows( pcSlice ) )
+  {
+    // jobs are the LCU rows of the slice, one substream each. As in the encoder, the LCU in column c of row j is
+    // decoded in step c+2j, so its left, above and above-right neighbours, and the contexts stored after the
+    // second LCU of the row above, belong to earlier steps: no row ever waits for another one
+    UInt uiWidthInLCUs = rpcPic->getPicSym()->getFrameWidthInCU();
+    UInt uiNumRows     = pcSlice->getNumEntryPointOffsets()+1;
+    std::vector<UInt> auiIsLast( uiNumRows, 0 );
+
+    if (m_pcBufferRowSbacDecoders)
+    {
+      delete [] m_pcBufferRowSbacDecoders;
+    }
+    if (m_pcBufferRowBinCABACs)
+    {
+      delete [] m_pcBufferRowBinCABACs;
+    }
+    m_pcBufferRowSbacDecoders = new TDecSbac    [uiNumRows];
+    m_pcBufferRowBinCABACs    = new TDecBinCABAC[uiNumRows];
+    for (UInt ui = 0; ui < uiNumRows; ui++)
+    {
+      m_pcBufferRowSbacDecoders[ui].init(&m_pcBufferRowBinCABACs[ui]);
+    }
+
+    if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
+    {
+      SAOParam *saoParam = rpcPic->getPicSym()->getSaoParam();
+      saoParam->bSaoFlag[0] = pcSlice->getSaoEnabledFlag();
+      saoParam->bSaoFlag[1] = pcSlice->getSaoEnabledFlagChroma();
+    }
+    for (Int i = 0; i < m_iNumWorkers; i++)
+    {
+      m_pcWorkers[i].initSlice( pcSlice );
+    }
+    UInt uiNumSteps = uiWidthInLCUs + 2*(uiNumRows-1);
+    for ( UInt uiStep = 0; uiStep < uiNumSteps; uiStep++ )
+    {
+      UInt uiFirstRow = uiStep < uiWidthInLCUs ? 0 : (uiStep - uiWidthInLCUs)/2 + 1;
+      UInt uiLastRow  = std::min( uiStep/2, uiNumRows-1 );
+      // the rows active in one step are consecutive and not more than the workers, so they never share one
+      cilk_for (UInt ui = uiFirstRow; ui <= uiLastRow; ui++)
+      {
+        xDecompressWppStep( &m_pcWorkers[ui % m_iNumWorkers], ppcSubstreams[ui], &pcSbacDecoders[ui], rpcPic, iStartCUAddr, ui, uiStep - 2*ui, auiIsLast[ui] );
+      }
+    }
+    return;
+  }
+
   // delete decoders if already allocated in previous slice
   if (m_pcBufferSbacDecoders)
   {
@@ -184,6 +278,16 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
   UInt uiTileLCUX;
   Int iNumSubstreamsPerTile = 1; // if independent.
   Bool depSliceSegmentsEnabled = rpcPic->getSlice(rpcPic->getCurrSliceIdx())->getPPS()->getDependentSliceSegmentsEnabledFlag();
+#if ENC_DEC_TRACE
+  Bool bPipelineRecon = false;
+#else
+  Bool bPipelineRecon = m_bReconThread;
+#endif
+  if ( bPipelineRecon )
+  {
+    // the reconstruction thread is idle between slices
+    m_pcReconWorker->initSlice( pcSlice );
+  }
   uiTileStartLCU = rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(iStartCUAddr))->getFirstCUAddr();
   if( depSliceSegmentsEnabled )
   {
@@ -316,51 +420,18 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
       {
         saoParam->bSaoFlag[1] = pcSlice->getSaoEnabledFlagChroma();
       }
-      Int numCuInWidth     = saoParam->numCuInWidth;
-      Int cuAddrInSlice = iCUAddr - rpcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/rpcPic->getNumPartInCU());
-      Int cuAddrUpInSlice  = cuAddrInSlice - numCuInWidth;
-      Int rx = iCUAddr % numCuInWidth;
-      Int ry = iCUAddr / numCuInWidth;
-      Int allowMergeLeft = 1;
-      Int allowMergeUp   = 1;
-      if (rx!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(iCUAddr-1) != rpcPic->getPicSym()->getTileIdxMap(iCUAddr))
-        {
-          allowMergeLeft = 0;
-        }
-      }
-      if (ry!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(iCUAddr-numCuInWidth) != rpcPic->getPicSym()->getTileIdxMap(iCUAddr))
-        {
-          allowMergeUp = 0;
-        }
-      }
-      pcSbacDecoder->parseSaoOneLcuInterleaving(rx, ry, saoParam,pcCU, cuAddrInSlice, cuAddrUpInSlice, allowMergeLeft, allowMergeUp);
     }
-    else if ( pcSlice->getSPS()->getUseSAO() )
+    xDecodeSaoLcu( rpcPic, pcSlice, pcCU, pcSbacDecoder );
+    m_pcCuDecoder->decodeCU     ( pcCU, uiIsLast );
+    if ( bPipelineRecon )
     {
-      Int addr = pcCU->getAddr();
-      SAOParam *saoParam = rpcPic->getPicSym()->getSaoParam();
-      for (Int cIdx=0; cIdx<3; cIdx++)
-      {
-        SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
-        if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
-        {
-          saoLcuParam->mergeUpFlag   = 0;
-          saoLcuParam->mergeLeftFlag = 0;
-          saoLcuParam->subTypeIdx    = 0;
-          saoLcuParam->typeIdx       = -1;
-          saoLcuParam->offset[0]     = 0;
-          saoLcuParam->offset[1]     = 0;
-          saoLcuParam->offset[2]     = 0;
-          saoLcuParam->offset[3]     = 0;
-        }
-      }
+      xQueueRecon( rpcPic, iCUAddr );
+    }
+    else
+    {
+      m_pcCuDecoder->decompressCU ( pcCU );
+      rpcPic->reportReconCU( iCUAddr );
     }
-    m_pcCuDecoder->decodeCU     ( pcCU, uiIsLast );
-    m_pcCuDecoder->decompressCU ( pcCU );
     
 #if ENC_DEC_TRACE
     g_bJustDoIt = g_bEncDecTraceDisable;
@@ -389,7 +460,314 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
         CTXMem[1]->loadContexts( &m_pcBufferSbacDecoders[uiTileCol] );//ctx 2.LCU
       }
       CTXMem[0]->loadContexts( pcSbacDecoder );//ctx end of dep.slice
-      return;
+      break;
+    }
+  }
+
+  if ( bPipelineRecon )
+  {
+    xWaitRecon();
+  }
+}
+
+/** start the thread reconstructing the LCUs of the slices decoded serially while the next LCUs are parsed
+ * \param pcReconWorker decoding context of the thread, created for the active SPS
+ */
+Void TDecSlice::startReconThread( TDecWorker* pcReconWorker )
+{
+  if ( m_bReconThread )
+  {
+    return;
+  }
+  m_pcReconWorker  = pcReconWorker;
+  m_bReconExit     = false;
+  m_uiNumParsedCUs = 0;
+  m_uiNumReconCUs  = 0;
+  pthread_mutex_init( &m_cReconMutex, NULL );
+  pthread_cond_init( &m_cReconCond, NULL );
+  m_bReconThread = ( pthread_create( &m_cReconThread, NULL, xReconThreadMain, this ) == 0 );
+  if ( !m_bReconThread )
+  {
+    pthread_cond_destroy( &m_cReconCond );
+    pthread_mutex_destroy( &m_cReconMutex );
+  }
+}
+
+/** stop the reconstruction thread, the queue is empty after every slice
+ */
+Void TDecSlice::stopReconThread()
+{
+  if ( !m_bReconThread )
+  {
+    return;
+  }
+  pthread_mutex_lock( &m_cReconMutex );
+  m_bReconExit = true;
+  pthread_cond_broadcast( &m_cReconCond );
+  pthread_mutex_unlock( &m_cReconMutex );
+  pthread_join( m_cReconThread, NULL );
+  m_bReconThread = false;
+
+  pthread_cond_destroy( &m_cReconCond );
+  pthread_mutex_destroy( &m_cReconMutex );
+}
+
+/** hand a parsed LCU over to the reconstruction thread, blocks while the queue is full. The coefficients stay in the
+ *  LCU of the picture, so the queue bounds how far parsing runs ahead
+ * \param pcPic    picture being decoded
+ * \param uiCUAddr address of the parsed LCU
+ */
+Void TDecSlice::xQueueRecon( TComPic* pcPic, UInt uiCUAddr )
+{
+  pthread_mutex_lock( &m_cReconMutex );
+  while ( m_uiNumParsedCUs - m_uiNumReconCUs >= RECON_QUEUE_SIZE )
+  {
+    pthread_cond_wait( &m_cReconCond, &m_cReconMutex );
+  }
+  m_pcReconPic = pcPic;
+  m_auiReconQueue[ m_uiNumParsedCUs % RECON_QUEUE_SIZE ] = uiCUAddr;
+  m_uiNumParsedCUs++;
+  pthread_cond_broadcast( &m_cReconCond );
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
+/** wait until all queued LCUs are reconstructed
+ */
+Void TDecSlice::xWaitRecon()
+{
+  pthread_mutex_lock( &m_cReconMutex );
+  while ( m_uiNumReconCUs != m_uiNumParsedCUs )
+  {
+    pthread_cond_wait( &m_cReconCond, &m_cReconMutex );
+  }
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
+Void* TDecSlice::xReconThreadMain( Void* pArg )
+{
+  static_cast<TDecSlice*>( pArg )->xRunRecon();
+  return NULL;
+}
+
+/** reconstruction loop, runs until it is asked to terminate and the queue is empty
+ */
+Void TDecSlice::xRunRecon()
+{
+  pthread_mutex_lock( &m_cReconMutex );
+  while ( true )
+  {
+    while ( m_uiNumReconCUs == m_uiNumParsedCUs && !m_bReconExit )
+    {
+      pthread_cond_wait( &m_cReconCond, &m_cReconMutex );
+    }
+    if ( m_uiNumReconCUs == m_uiNumParsedCUs )
+    {
+      break;
+    }
+    TComDataCU* pcCU = m_pcReconPic->getCU( m_auiReconQueue[ m_uiNumReconCUs % RECON_QUEUE_SIZE ] );
+    pthread_mutex_unlock( &m_cReconMutex );
+
+    m_pcReconWorker->getCuDecoder()->decompressCU( pcCU );
+    pcCU->getPic()->reportReconCU( pcCU->getAddr() );
+
+    pthread_mutex_lock( &m_cReconMutex );
+    m_uiNumReconCUs++;
+    pthread_cond_broadcast( &m_cReconCond );
+  }
+  pthread_mutex_unlock( &m_cReconMutex );
+}
+
+/** check whether the tiles of the slice are decoded concurrently
+ * \param pcSlice slice to decode
+ * \returns true if the slice holds several complete tiles and a worker is available for each of them
+ */
+Bool TDecSlice::getParallelTiles( TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE
+  return false;
+#else
+  TComPPS* pcPPS = pcSlice->getPPS();
+  return m_pcWorkers != NULL
+      && pcPPS->getTilesEnabledFlag()
+      && !pcPPS->getEntropyCodingSyncEnabledFlag()
+      && !pcPPS->getDependentSliceSegmentsEnabledFlag()
+      && pcSlice->getNumEntryPointOffsets() > 0
+      && pcSlice->getNumEntryPointOffsets() < m_iNumWorkers;
+#endif
+}
+
+/** check whether the LCU rows of a WPP slice are decoded concurrently
+ * \param pcSlice slice to decode
+ * \returns true if the slice spans several LCU rows of a picture without tiles and workers are available
+ */
+Bool TDecSlice::getParallelRows( TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE
+  return false;
+#else
+  TComPPS* pcPPS = pcSlice->getPPS();
+  return m_pcWorkers != NULL
+      && pcPPS->getEntropyCodingSyncEnabledFlag()
+      && !pcPPS->getTilesEnabledFlag()
+      && !pcPPS->getDependentSliceSegmentsEnabledFlag()
+      && pcSlice->getNumEntryPointOffsets() > 0;
+#endif
+}
+
+/** decode the LCU of one WPP row that belongs to one wavefront step
+ * \param pcWorker       worker whose CU and entropy decoders decode the LCU
+ * \param pcSubstream    substream of the row
+ * \param pcSbacDecoder  SBAC decoder of the row
+ * \param pcPic          picture being decoded
+ * \param iStartCUAddr   address of the first LCU of the slice
+ * \param uiRow          LCU row within the slice
+ * \param uiCol          LCU column of the step in this row
+ * \param ruiIsLast      set when the last LCU of the slice has been decoded in this row
+ */
+Void TDecSlice::xDecompressWppStep( TDecWorker* pcWorker, TComInputBitstream* pcSubstream, TDecSbac* pcSbacDecoder, TComPic* pcPic, Int iStartCUAddr, UInt uiRow, UInt uiCol, UInt& ruiIsLast )
+{
+  UInt uiWidthInLCUs = pcPic->getFrameWidthInCU();
+  UInt uiFirstCol    = uiRow == 0 ? iStartCUAddr % uiWidthInLCUs : 0;
+  if ( ruiIsLast || uiCol < uiFirstCol || uiCol >= uiWidthInLCUs )
+  {
+    return;
+  }
+  Int iCUAddr = (iStartCUAddr / uiWidthInLCUs + uiRow) * uiWidthInLCUs + uiCol;
+  if ( iCUAddr >= pcPic->getNumCUsInFrame() )
+  {
+    return;
+  }
+
+  TComSlice*   pcSlice          = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TDecCu*      pcCuDecoder      = pcWorker->getCuDecoder();
+  TDecEntropy* pcEntropyDecoder = pcWorker->getEntropyDecoder();
+  TComDataCU*  pcCU             = pcPic->getCU( iCUAddr );
+  pcCU->initCU( pcPic, iCUAddr );
+
+  pcEntropyDecoder->setEntropyDecoder( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream     ( pcSubstream );
+
+  if ( uiCol == 0 )
+  {
+    // Synchronize cabac probabilities with upper-right LCU if it's available.
+    TComDataCU *pcCUUp = pcCU->getCUAbove();
+    TComDataCU *pcCUTR = NULL;
+    if ( pcCUUp && ((iCUAddr%uiWidthInLCUs+1) < uiWidthInLCUs)  )
+    {
+      pcCUTR = pcPic->getCU( iCUAddr - uiWidthInLCUs + 1 );
+    }
+    UInt uiMaxParts = 1<<(pcSlice->getSPS()->getMaxCUDepth()<<1);
+    if ( !((pcCUTR==NULL) || (pcCUTR->getSlice()==NULL) ||
+           ((pcCUTR->getSCUAddr()+uiMaxParts-1) < pcSlice->getSliceCurStartCUAddr())) )
+    {
+      pcSbacDecoder->loadContexts( &m_pcBufferRowSbacDecoders[uiRow-1] );
+    }
+  }
+
+  xDecodeSaoLcu( pcPic, pcSlice, pcCU, pcSbacDecoder );
+  pcCuDecoder->decodeCU     ( pcCU, ruiIsLast );
+  pcCuDecoder->decompressCU ( pcCU );
+  pcPic->reportReconCU( pcCU->getAddr() );
+
+  if ( uiCol == uiWidthInLCUs-1 && !ruiIsLast )
+  {
+    // Parse end_of_substream_one_bit for WPP case
+    UInt binVal;
+    pcSbacDecoder->parseTerminatingBit( binVal );
+    assert( binVal );
+  }
+  //Store probabilities of second LCU in line into buffer
+  if ( uiCol == 1 )
+  {
+    m_pcBufferRowSbacDecoders[uiRow].loadContexts( pcSbacDecoder );
+  }
+}
+
+/** decode the LCUs of one tile with the private objects of a worker
+ * \param pcWorker       worker whose CU and entropy decoders decode the tile
+ * \param pcSubstream    substream of the tile
+ * \param pcSbacDecoder  SBAC decoder initialized at the start of the substream
+ * \param pcPic          picture being decoded
+ * \param uiTileIdx      index of the tile in the picture
+ */
+Void TDecSlice::xDecompressTile( TDecWorker* pcWorker, TComInputBitstream* pcSubstream, TDecSbac* pcSbacDecoder, TComPic* pcPic, UInt uiTileIdx )
+{
+  TComSlice*   pcSlice          = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TDecCu*      pcCuDecoder      = pcWorker->getCuDecoder();
+  TDecEntropy* pcEntropyDecoder = pcWorker->getEntropyDecoder();
+  UInt         uiIsLast         = 0;
+
+  pcEntropyDecoder->setEntropyDecoder( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream     ( pcSubstream );
+
+  for( Int iCUAddr = pcPic->getPicSym()->getTComTile(uiTileIdx)->getFirstCUAddr();
+       !uiIsLast && iCUAddr < pcPic->getNumCUsInFrame() && pcPic->getPicSym()->getTileIdxMap(iCUAddr) == uiTileIdx;
+       iCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(iCUAddr) )
+  {
+    TComDataCU* pcCU = pcPic->getCU( iCUAddr );
+    pcCU->initCU( pcPic, iCUAddr );
+
+    xDecodeSaoLcu( pcPic, pcSlice, pcCU, pcSbacDecoder );
+    // the end_of_slice_segment_flag of the last LCU of the tile is only set in the last tile of the slice
+    pcCuDecoder->decodeCU     ( pcCU, uiIsLast );
+    pcCuDecoder->decompressCU ( pcCU );
+    pcPic->reportReconCU( iCUAddr );
+  }
+}
+
+/** parse the SAO parameters of an LCU, or reset them if SAO is disabled for the slice
+ * \param pcPic          picture being decoded
+ * \param pcSlice        current slice
+ * \param pcCU           LCU to decode
+ * \param pcSbacDecoder  SBAC decoder of the substream holding the LCU
+ */
+Void TDecSlice::xDecodeSaoLcu( TComPic* pcPic, TComSlice* pcSlice, TComDataCU* pcCU, TDecSbac* pcSbacDecoder )
+{
+  Int iCUAddr = pcCU->getAddr();
+  if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
+  {
+    SAOParam *saoParam = pcPic->getPicSym()->getSaoParam();
+    Int numCuInWidth     = saoParam->numCuInWidth;
+    Int cuAddrInSlice = iCUAddr - pcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/pcPic->getNumPartInCU());
+    Int cuAddrUpInSlice  = cuAddrInSlice - numCuInWidth;
+    Int rx = iCUAddr % numCuInWidth;
+    Int ry = iCUAddr / numCuInWidth;
+    Int allowMergeLeft = 1;
+    Int allowMergeUp   = 1;
+    if (rx!=0)
+    {
+      if (pcPic->getPicSym()->getTileIdxMap(iCUAddr-1) != pcPic->getPicSym()->getTileIdxMap(iCUAddr))
+      {
+        allowMergeLeft = 0;
+      }
+    }
+    if (ry!=0)
+    {
+      if (pcPic->getPicSym()->getTileIdxMap(iCUAddr-numCuInWidth) != pcPic->getPicSym()->getTileIdxMap(iCUAddr))
+      {
+        allowMergeUp = 0;
+      }
+    }
+    pcSbacDecoder->parseSaoOneLcuInterleaving(rx, ry, saoParam,pcCU, cuAddrInSlice, cuAddrUpInSlice, allowMergeLeft, allowMergeUp);
+  }
+  else if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    Int addr = pcCU->getAddr();
+    SAOParam *saoParam = pcPic->getPicSym()->getSaoParam();
+    for (Int cIdx=0; cIdx<3; cIdx++)
+    {
+      SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
+      if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
+      {
+        saoLcuParam->mergeUpFlag   = 0;
+        saoLcuParam->mergeLeftFlag = 0;
+        saoLcuParam->subTypeIdx    = 0;
+        saoLcuParam->typeIdx       = -1;
+        saoLcuParam->offset[0]     = 0;
+        saoLcuParam->offset[1]     = 0;
+        saoLcuParam->offset[2]     = 0;
+        saoLcuParam->offset[3]     = 0;
+      }
     }
   }
 }
@@ -49,10 +49,19 @@
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecWorker.h"
+
+#include <pthread.h>
 
 //! \ingroup TLibDecoder
 //! \{
 
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define RECON_QUEUE_SIZE            64      ///< max. # of parsed LCUs waiting for their reconstruction
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -69,7 +78,23 @@ private:
   TDecBinCABAC*   m_pcBufferBinCABACs;
   TDecSbac*       m_pcBufferLowLatSbacDecoders;   ///< dependent tiles: line to store temporary contexts, one per column of tiles.
   TDecBinCABAC*   m_pcBufferLowLatBinCABACs;
+  TDecSbac*       m_pcBufferRowSbacDecoders;   ///< WPP decoded concurrently: contexts after the second LCU, one per LCU row of the slice
+  TDecBinCABAC*   m_pcBufferRowBinCABACs;
   std::vector<TDecSbac*> CTXMem;
+  TDecWorker*     m_pcWorkers;              ///< private decoding contexts, one per tile of the picture, NULL if tiles are decoded serially
+  Int             m_iNumWorkers;            ///< # of worker contexts in m_pcWorkers
+
+  // parse/reconstruction pipeline: the parsed LCUs are reconstructed on a thread while the next ones are parsed
+  TDecWorker*     m_pcReconWorker;          ///< decoding context of the reconstruction thread
+  Bool            m_bReconThread;           ///< the reconstruction thread is running
+  Bool            m_bReconExit;             ///< the reconstruction thread exits once the queue is empty
+  TComPic*        m_pcReconPic;             ///< picture of the queued LCUs
+  UInt            m_auiReconQueue[RECON_QUEUE_SIZE]; ///< ring of parsed LCU addresses, in decoding order
+  UInt            m_uiNumParsedCUs;         ///< # of LCUs queued so far
+  UInt            m_uiNumReconCUs;          ///< # of LCUs reconstructed so far
+  pthread_t       m_cReconThread;
+  pthread_mutex_t m_cReconMutex;
+  pthread_cond_t  m_cReconCond;             ///< signalled when an LCU is queued or reconstructed
   
 public:
   TDecSlice();
@@ -83,6 +108,25 @@ public:
   Void      initCtxMem(  UInt i );
   Void      setCtxMem( TDecSbac* sb, Int b )   { CTXMem[b] = sb; }
   Int       getCtxMemSize( )                   { return (Int)CTXMem.size(); }
+
+  Void      setWorkers( TDecWorker* pcWorkers, Int iNumWorkers ) { m_pcWorkers = pcWorkers; m_iNumWorkers = iNumWorkers; }
+  Int       getNumWorkers( )                   { return m_iNumWorkers; }
+  Bool      getParallelTiles( TComSlice* pcSlice );
+  Bool      getParallelRows ( TComSlice* pcSlice );
+
+  Void      startReconThread( TDecWorker* pcReconWorker );
+  Void      stopReconThread ();
+  Bool      getReconThread  ()                 { return m_bReconThread; }
+
+private:
+  Void      xDecompressTile   ( TDecWorker* pcWorker, TComInputBitstream* pcSubstream, TDecSbac* pcSbacDecoder, TComPic* pcPic, UInt uiTileIdx );
+  Void      xDecompressWppStep( TDecWorker* pcWorker, TComInputBitstream* pcSubstream, TDecSbac* pcSbacDecoder, TComPic* pcPic, Int iStartCUAddr, UInt uiRow, UInt uiCol, UInt& ruiIsLast );
+  Void      xDecodeSaoLcu     ( TComPic* pcPic, TComSlice* pcSlice, TComDataCU* pcCU, TDecSbac* pcSbacDecoder );
+
+  Void      xQueueRecon       ( TComPic* pcPic, UInt uiCUAddr );
+  Void      xWaitRecon        ();
+  static Void* xReconThreadMain( Void* pArg );
+  Void      xRunRecon         ();
 };
 
 
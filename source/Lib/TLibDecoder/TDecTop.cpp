@@ -58,6 +58,12 @@ TDecTop::TDecTop()
   m_bFirstSliceInSequence   = true;
   m_prevSliceSkipped = false;
   m_skippedPOC = 0;
+  m_pcWorkers = NULL;
+  m_iNumWorkers = 0;
+  m_pcSetupSPS = NULL;
+  m_bCuDecoderCreated = false;
+  m_bReconWorkerCreated = false;
+  m_bLookaheadNalu = false;
 }
 
 TDecTop::~TDecTop()
@@ -82,6 +88,37 @@ Void TDecTop::destroy()
   m_apcSlicePilot = NULL;
   
   m_cSliceDecoder.destroy();
+
+  xDestroyCuDecoders();
+}
+
+/** \param bFrameParallel run the loop filters of a decoded picture on a thread while the next pictures are decoded
+ */
+Void TDecTop::setFrameParallel( Bool bFrameParallel )
+{
+  if ( bFrameParallel )
+  {
+    m_cGopDecoder.startFilterThread();
+  }
+  else
+  {
+    m_cGopDecoder.stopFilterThread();
+  }
+}
+
+/** \param bReconThread reconstruct the LCUs of the serially decoded slices on a thread while the next LCUs are parsed
+ */
+Void TDecTop::setReconThread( Bool bReconThread )
+{
+  if ( bReconThread )
+  {
+    m_cSliceDecoder.startReconThread( &m_cReconWorker );
+  }
+  else
+  {
+    m_cSliceDecoder.stopReconThread();
+  }
+  m_pcSetupSPS = NULL;
 }
 
 Void TDecTop::init()
@@ -95,6 +132,9 @@ Void TDecTop::init()
 
 Void TDecTop::deletePicBuffer ( )
 {
+  m_cGopDecoder.stopFilterThread();
+  m_cSliceDecoder.stopReconThread();
+
   TComList<TComPic*>::iterator  iterPic   = m_cListPic.begin();
   Int iSize = Int( m_cListPic.size() );
   
@@ -160,6 +200,11 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
       break;
     }
   }
+  if ( bBufferIsAvailable )
+  {
+    // the loop filters of the picture may still run with frame-parallel decoding
+    rpcPic->getPicYuvRec()->waitReadyLines( MAX_INT );
+  }
   
   if ( !bBufferIsAvailable )
   {
@@ -184,14 +229,13 @@ Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
   
   TComPic*&   pcPic         = m_pcPic;
 
-  // Execute Deblock + Cleanup
+  // Execute Deblock + Cleanup, on the filter thread with frame-parallel decoding
 
-  m_cGopDecoder.filterPicture(pcPic);
+  m_cGopDecoder.queueFilterPicture(pcPic);
 
   TComSlice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcPic->getSlice(m_uiSliceIdx-1)->getPOC();
   rpcListPic          = &m_cListPic;  
-  m_cCuDecoder.destroy();        
   m_bFirstSliceInPicture  = true;
 
   return;
@@ -227,6 +271,7 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
     if(abs(rpcPic->getPicSym()->getSlice(0)->getPOC() -iLostPoc)==closestPoc&&rpcPic->getPicSym()->getSlice(0)->getPOC()!=m_apcSlicePilot->getPOC())
     {
       printf("copying picture %d to %d (%d)\n",rpcPic->getPicSym()->getSlice(0)->getPOC() ,iLostPoc,m_apcSlicePilot->getPOC());
+      rpcPic->getPicYuvRec()->waitReadyLines( MAX_INT );
       rpcPic->getPicYuvRec()->copyToPic(cFillPic->getPicYuvRec());
       break;
     }
@@ -247,8 +292,37 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
 }
 
 
+/** release the CU decoding contexts of the main thread and of the workers
+ */
+Void TDecTop::xDestroyCuDecoders()
+{
+  if ( m_bCuDecoderCreated )
+  {
+    m_cCuDecoder.destroy();
+    m_bCuDecoderCreated = false;
+  }
+  if ( m_bReconWorkerCreated )
+  {
+    m_cReconWorker.destroy();
+    m_bReconWorkerCreated = false;
+  }
+  for (Int i = 0; i < m_iNumWorkers; i++)
+  {
+    m_pcWorkers[i].destroy();
+  }
+  delete [] m_pcWorkers;
+  m_pcWorkers = NULL;
+  m_iNumWorkers = 0;
+  m_cSliceDecoder.setWorkers( NULL, 0 );
+}
+
 Void TDecTop::xActivateParameterSets()
 {
+  if ( m_pcSetupSPS == NULL )
+  {
+    // parameter sets replaced here may still be read by the loop filters of the previous pictures
+    m_cGopDecoder.waitFilterPictures();
+  }
   m_parameterSetManagerDecoder.applyPrefetchedPS();
   
   TComPPS *pps = m_parameterSetManagerDecoder.getPPS(m_apcSlicePilot->getPPSId());
@@ -286,6 +360,16 @@ Void TDecTop::xActivateParameterSets()
   pps->setNumSubstreams(pps->getEntropyCodingSyncEnabledFlag() ? ((sps->getPicHeightInLumaSamples() + sps->getMaxCUHeight() - 1) / sps->getMaxCUHeight()) * (pps->getNumColumnsMinus1() + 1) : 1);
   pps->setMinCuDQPSize( sps->getMaxCUWidth() >> ( pps->getMaxCuDQPDepth()) );
 
+  if ( sps == m_pcSetupSPS )
+  {
+    return;
+  }
+
+  // the global CU geometry, the CU decoding contexts and the loop filters change with the SPS: finish the pictures
+  // still filtered with the previous one first
+  m_cGopDecoder.waitFilterPictures();
+  m_pcSetupSPS = sps;
+
   g_bitDepthY     = sps->getBitDepthY();
   g_bitDepthC     = sps->getBitDepthC();
   g_uiMaxCUWidth  = sps->getMaxCUWidth();
@@ -306,6 +390,18 @@ Void TDecTop::xActivateParameterSets()
   m_cSAO.destroy();
   m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getMaxCUWidth(), sps->getMaxCUHeight() );
   m_cLoopFilter.create( sps->getMaxCUDepth() );
+
+  // Recursive structure
+  xDestroyCuDecoders();
+  m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight );
+  m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+  m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, sps->getMaxTrSize());
+  m_bCuDecoderCreated = true;
+  if ( m_cSliceDecoder.getReconThread() )
+  {
+    m_cReconWorker.create( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, sps->getMaxTrSize() );
+    m_bReconWorkerCreated = true;
+  }
 }
 
 Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay )
@@ -399,6 +495,11 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     m_apcSlicePilot->applyReferencePictureSet(m_cListPic, m_apcSlicePilot->getRPS());
     //  Get a new picture buffer
     xGetNewPicBuffer (m_apcSlicePilot, pcPic);
+    if ( m_cGopDecoder.getFilterThread() )
+    {
+      // the samples and the motion of the picture are published by the filter thread
+      pcPic->getPicYuvRec()->initReadyLines();
+    }
 
     Bool isField = false;
     Bool isTff = false;
@@ -423,10 +524,45 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     pcPic->setSEIs(m_SEIs);
     m_SEIs.clear();
 
-    // Recursive structure
-    m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight );
-    m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
-    m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getMaxTrSize());
+    // private CU decoding contexts: one per tile, the complete tiles of a slice are decoded concurrently, or with WPP
+    // one per LCU row active in a wavefront step
+    TComPPS* pcPPS = m_apcSlicePilot->getPPS();
+    TComSPS* pcSPS = m_apcSlicePilot->getSPS();
+    Int iNumWorkers = 1;
+    if ( pcPPS->getEntropyCodingSyncEnabledFlag() )
+    {
+      Int iWidthInLCUs  = (pcSPS->getPicWidthInLumaSamples()  + g_uiMaxCUWidth  - 1) / g_uiMaxCUWidth;
+      Int iHeightInLCUs = (pcSPS->getPicHeightInLumaSamples() + g_uiMaxCUHeight - 1) / g_uiMaxCUHeight;
+      iNumWorkers = min( iHeightInLCUs, (iWidthInLCUs+1)/2 );
+    }
+    else if ( pcPPS->getTilesEnabledFlag() )
+    {
+      iNumWorkers = (pcPPS->getNumColumnsMinus1()+1)*(pcPPS->getNumRowsMinus1()+1);
+    }
+    if ( iNumWorkers > 1 && iNumWorkers > m_iNumWorkers )
+    {
+      // creating a CU decoder rewrites the partition order tables read by the loop filters
+      m_cGopDecoder.waitFilterPictures();
+      for (Int i = 0; i < m_iNumWorkers; i++)
+      {
+        m_pcWorkers[i].destroy();
+      }
+      delete [] m_pcWorkers;
+      m_pcWorkers   = new TDecWorker[iNumWorkers];
+      m_iNumWorkers = iNumWorkers;
+      for (Int i = 0; i < iNumWorkers; i++)
+      {
+        m_pcWorkers[i].create( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, pcSPS->getMaxTrSize() );
+      }
+    }
+    if ( iNumWorkers > 1 )
+    {
+      m_cSliceDecoder.setWorkers( m_pcWorkers, iNumWorkers );
+    }
+    else
+    {
+      m_cSliceDecoder.setWorkers( NULL, 0 );
+    }
 
     m_cSliceDecoder.create();
   }
@@ -451,75 +587,80 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
   UInt uiCummulativeTileHeight;
   UInt i, j, p;
 
-  //set NumColumnsMins1 and NumRowsMinus1
-  pcPic->getPicSym()->setNumColumnsMinus1( pcSlice->getPPS()->getNumColumnsMinus1() );
-  pcPic->getPicSym()->setNumRowsMinus1( pcSlice->getPPS()->getNumRowsMinus1() );
+  // all slices of a picture refer to the same PPS: the tiles and the coding order maps are set up with the first one,
+  // the loop filters of the picture read them while the next slices are decoded
+  if (m_bFirstSliceInPicture)
+  {
+    //set NumColumnsMins1 and NumRowsMinus1
+    pcPic->getPicSym()->setNumColumnsMinus1( pcSlice->getPPS()->getNumColumnsMinus1() );
+    pcPic->getPicSym()->setNumRowsMinus1( pcSlice->getPPS()->getNumRowsMinus1() );
 
-  //create the TComTileArray
-  pcPic->getPicSym()->xCreateTComTileArray();
+    //create the TComTileArray
+    pcPic->getPicSym()->xCreateTComTileArray();
 
-  if( pcSlice->getPPS()->getUniformSpacingFlag() )
-  {
-    //set the width for each tile
-    for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
+    if( pcSlice->getPPS()->getUniformSpacingFlag() )
     {
-      for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1()+1; p++)
+      //set the width for each tile
+      for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
       {
-        pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->
-          setTileWidth( (p+1)*pcPic->getPicSym()->getFrameWidthInCU()/(pcPic->getPicSym()->getNumColumnsMinus1()+1) 
-          - (p*pcPic->getPicSym()->getFrameWidthInCU())/(pcPic->getPicSym()->getNumColumnsMinus1()+1) );
+        for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1()+1; p++)
+        {
+          pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->
+            setTileWidth( (p+1)*pcPic->getPicSym()->getFrameWidthInCU()/(pcPic->getPicSym()->getNumColumnsMinus1()+1) 
+            - (p*pcPic->getPicSym()->getFrameWidthInCU())/(pcPic->getPicSym()->getNumColumnsMinus1()+1) );
+        }
       }
-    }
 
-    //set the height for each tile
-    for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
-    {
-      for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1()+1; p++)
+      //set the height for each tile
+      for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
       {
-        pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->
-          setTileHeight( (p+1)*pcPic->getPicSym()->getFrameHeightInCU()/(pcPic->getPicSym()->getNumRowsMinus1()+1) 
-          - (p*pcPic->getPicSym()->getFrameHeightInCU())/(pcPic->getPicSym()->getNumRowsMinus1()+1) );   
+        for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1()+1; p++)
+        {
+          pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->
+            setTileHeight( (p+1)*pcPic->getPicSym()->getFrameHeightInCU()/(pcPic->getPicSym()->getNumRowsMinus1()+1) 
+            - (p*pcPic->getPicSym()->getFrameHeightInCU())/(pcPic->getPicSym()->getNumRowsMinus1()+1) );   
+        }
       }
     }
-  }
-  else
-  {
-    //set the width for each tile
-    for(j=0; j < pcSlice->getPPS()->getNumRowsMinus1()+1; j++)
+    else
     {
-      uiCummulativeTileWidth = 0;
-      for(i=0; i < pcSlice->getPPS()->getNumColumnsMinus1(); i++)
+      //set the width for each tile
+      for(j=0; j < pcSlice->getPPS()->getNumRowsMinus1()+1; j++)
       {
-        pcPic->getPicSym()->getTComTile(j * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + i)->setTileWidth( pcSlice->getPPS()->getColumnWidth(i) );
-        uiCummulativeTileWidth += pcSlice->getPPS()->getColumnWidth(i);
+        uiCummulativeTileWidth = 0;
+        for(i=0; i < pcSlice->getPPS()->getNumColumnsMinus1(); i++)
+        {
+          pcPic->getPicSym()->getTComTile(j * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + i)->setTileWidth( pcSlice->getPPS()->getColumnWidth(i) );
+          uiCummulativeTileWidth += pcSlice->getPPS()->getColumnWidth(i);
+        }
+        pcPic->getPicSym()->getTComTile(j * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + i)->setTileWidth( pcPic->getPicSym()->getFrameWidthInCU()-uiCummulativeTileWidth );
       }
-      pcPic->getPicSym()->getTComTile(j * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + i)->setTileWidth( pcPic->getPicSym()->getFrameWidthInCU()-uiCummulativeTileWidth );
-    }
 
-    //set the height for each tile
-    for(j=0; j < pcSlice->getPPS()->getNumColumnsMinus1()+1; j++)
-    {
-      uiCummulativeTileHeight = 0;
-      for(i=0; i < pcSlice->getPPS()->getNumRowsMinus1(); i++)
-      { 
-        pcPic->getPicSym()->getTComTile(i * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcSlice->getPPS()->getRowHeight(i) );
-        uiCummulativeTileHeight += pcSlice->getPPS()->getRowHeight(i);
+      //set the height for each tile
+      for(j=0; j < pcSlice->getPPS()->getNumColumnsMinus1()+1; j++)
+      {
+        uiCummulativeTileHeight = 0;
+        for(i=0; i < pcSlice->getPPS()->getNumRowsMinus1(); i++)
+        { 
+          pcPic->getPicSym()->getTComTile(i * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcSlice->getPPS()->getRowHeight(i) );
+          uiCummulativeTileHeight += pcSlice->getPPS()->getRowHeight(i);
+        }
+        pcPic->getPicSym()->getTComTile(i * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcPic->getPicSym()->getFrameHeightInCU()-uiCummulativeTileHeight );
       }
-      pcPic->getPicSym()->getTComTile(i * (pcSlice->getPPS()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcPic->getPicSym()->getFrameHeightInCU()-uiCummulativeTileHeight );
     }
-  }
 
-  pcPic->getPicSym()->xInitTiles();
+    pcPic->getPicSym()->xInitTiles();
 
-  //generate the Coding Order Map and Inverse Coding Order Map
-  UInt uiEncCUAddr;
-  for(i=0, uiEncCUAddr=0; i<pcPic->getPicSym()->getNumberOfCUsInFrame(); i++, uiEncCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(uiEncCUAddr))
-  {
-    pcPic->getPicSym()->setCUOrderMap(i, uiEncCUAddr);
-    pcPic->getPicSym()->setInverseCUOrderMap(uiEncCUAddr, i);
+    //generate the Coding Order Map and Inverse Coding Order Map
+    UInt uiEncCUAddr;
+    for(i=0, uiEncCUAddr=0; i<pcPic->getPicSym()->getNumberOfCUsInFrame(); i++, uiEncCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(uiEncCUAddr))
+    {
+      pcPic->getPicSym()->setCUOrderMap(i, uiEncCUAddr);
+      pcPic->getPicSym()->setInverseCUOrderMap(uiEncCUAddr, i);
+    }
+    pcPic->getPicSym()->setCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
+    pcPic->getPicSym()->setInverseCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
   }
-  pcPic->getPicSym()->setCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
-  pcPic->getPicSym()->setInverseCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
 
   //convert the start and end CU addresses of the slice and dependent slice into encoding order
   pcSlice->setSliceSegmentCurStartCUAddr( pcPic->getPicSym()->getPicSCUEncOrder(pcSlice->getSliceSegmentCurStartCUAddr()) );
@@ -621,6 +762,12 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     m_cTrQuant.setUseScalingList(false);
   }
 
+  if (m_bFirstSliceInPicture)
+  {
+    // the loop filters follow the reconstruction of the picture on the filter thread
+    m_cGopDecoder.startFilterPicture(pcPic);
+  }
+
   //  Decode a picture
   m_cGopDecoder.decompressSlice(nalu.m_Bitstream, pcPic);
 
@@ -665,6 +812,10 @@ Void TDecTop::xDecodeSEI( TComInputBitstream* bs, const NalUnitType nalUnitType
     if (activeParamSets.size()>0)
     {
       SEIActiveParameterSets *seiAps = (SEIActiveParameterSets*)(*activeParamSets.begin());
+      if ( m_pcSetupSPS == NULL )
+      {
+        m_cGopDecoder.waitFilterPictures();
+      }
       m_parameterSetManagerDecoder.applyPrefetchedPS();
       assert(seiAps->activeSeqParamSetId.size()>0);
       if (! m_parameterSetManagerDecoder.activateSPSWithSEI(seiAps->activeSeqParamSetId[0] ))
@@ -684,14 +835,17 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
   switch (nalu.m_nalUnitType)
   {
     case NAL_UNIT_VPS:
+      m_pcSetupSPS = NULL;
       xDecodeVPS();
       return false;
       
     case NAL_UNIT_SPS:
+      m_pcSetupSPS = NULL;
       xDecodeSPS();
       return false;
 
     case NAL_UNIT_PPS:
+      m_pcSetupSPS = NULL;
       xDecodePPS();
       return false;
       
@@ -716,8 +870,13 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
     case NAL_UNIT_CODED_SLICE_RADL_R:
     case NAL_UNIT_CODED_SLICE_RASL_N:
     case NAL_UNIT_CODED_SLICE_RASL_R:
-      return xDecodeSlice(nalu, iSkipFrame, iPOCLastDisplay);
-      break;
+      if (xDecodeSlice(nalu, iSkipFrame, iPOCLastDisplay))
+      {
+        // the slice starts the next picture, it is decoded by decodeLookaheadNalu() once the current one is complete
+        xPushBackNalu(nalu);
+        return true;
+      }
+      return false;
     default:
       assert (1);
   }
@@ -725,6 +884,36 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
   return false;
 }
 
+/** Decode the NAL unit pushed back when decode() found the first slice of a new picture
+ * \param iSkipFrame skip frame counter
+ * \param iPOCLastDisplay POC of last picture displayed
+ * \returns true if a new picture is found
+ */
+Bool TDecTop::decodeLookaheadNalu(Int& iSkipFrame, Int& iPOCLastDisplay)
+{
+  assert(m_bLookaheadNalu);
+  m_bLookaheadNalu = false;
+  return decode(m_cLookaheadNalu, iSkipFrame, iPOCLastDisplay);
+}
+
+/** Keep a NAL unit to be decoded again by decodeLookaheadNalu(). The payload is taken over without copy and read
+ *  again from the start of the slice header, the NAL unit is not extracted and unescaped again from the byte stream.
+ * \param nalu NAL unit whose slice header has been read
+ */
+Void TDecTop::xPushBackNalu(InputNALUnit& nalu)
+{
+  std::vector<UInt> epbLocations = nalu.m_Bitstream->getEmulationPreventionByteLocation();
+  if (&nalu != &m_cLookaheadNalu)
+  {
+    m_lookaheadNaluBuf.swap(nalu.m_Bitstream->getFIFO());
+  }
+  delete m_cLookaheadNalu.m_Bitstream;
+  m_cLookaheadNalu.m_Bitstream = new TComInputBitstream(&m_lookaheadNaluBuf);
+  m_cLookaheadNalu.m_Bitstream->setEmulationPreventionByteLocation(epbLocations);
+  readNalUnitHeader(m_cLookaheadNalu);
+  m_bLookaheadNalu = true;
+}
+
 /** Function for checking if picture should be skipped because of association with a previous BLA picture
  * \param iPOCLastDisplay POC of last picture displayed
  * \returns true if the picture should be skipped
@@ -50,8 +50,7 @@
 #include "TDecSbac.h"
 #include "TDecCAVLC.h"
 #include "SEIread.h"
-
-struct InputNALUnit;
+#include "NALread.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -89,6 +88,12 @@ private:
   SEIReader               m_seiReader;
   TComLoopFilter          m_cLoopFilter;
   TComSampleAdaptiveOffset m_cSAO;
+  TDecWorker*             m_pcWorkers;        ///< private CU decoding contexts for the tiles of a picture
+  Int                     m_iNumWorkers;      ///< # of allocated worker contexts
+  TDecWorker              m_cReconWorker;     ///< decoding context of the thread reconstructing the parsed LCUs
+  Bool                    m_bReconWorkerCreated;
+  TComSPS*                m_pcSetupSPS;       ///< SPS the CU decoding contexts and the loop filters are set up for, NULL after new parameter sets
+  Bool                    m_bCuDecoderCreated;
 
   Bool isSkipPictureForBLA(Int& iPOCLastDisplay);
   Bool isRandomAccessSkipPicture(Int& iSkipFrame,  Int& iPOCLastDisplay);
@@ -100,6 +105,10 @@ private:
   Bool                    m_prevSliceSkipped;
   Int                     m_skippedPOC;
 
+  InputNALUnit            m_cLookaheadNalu;     ///< NAL unit of the first slice of the next picture, pushed back by decode()
+  std::vector<uint8_t>    m_lookaheadNaluBuf;   ///< payload of the pushed back NAL unit
+  Bool                    m_bLookaheadNalu;     ///< a NAL unit has been pushed back
+
 public:
   TDecTop();
   virtual ~TDecTop();
@@ -108,9 +117,13 @@ public:
   Void  destroy ();
 
   void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  Void  setFrameParallel  ( Bool bFrameParallel );
+  Void  setReconThread    ( Bool bReconThread );
 
   Void  init();
   Bool  decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay);
+  Bool  hasLookaheadNalu() { return m_bLookaheadNalu; }
+  Bool  decodeLookaheadNalu(Int& iSkipFrame, Int& iPOCLastDisplay);
   
   Void  deletePicBuffer();
 
@@ -120,12 +133,14 @@ protected:
   Void  xGetNewPicBuffer  (TComSlice* pcSlice, TComPic*& rpcPic);
   Void  xCreateLostPicture (Int iLostPOC);
 
+  Void      xDestroyCuDecoders();
   Void      xActivateParameterSets();
   Bool      xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay);
   Void      xDecodeVPS();
   Void      xDecodeSPS();
   Void      xDecodePPS();
   Void      xDecodeSEI( TComInputBitstream* bs, const NalUnitType nalUnitType );
+  Void      xPushBackNalu( InputNALUnit& nalu );
 
 };// END CLASS DEFINITION TDecTop
 
@@ -0,0 +1,95 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TDecWorker.cpp
+    \brief    per-worker decoding context for parallel tile decoding
+*/
+
+#include "TDecWorker.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TDecWorker::TDecWorker()
+{
+  m_cCuDecoder.init( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+  m_cEntropyDecoder.init( &m_cPrediction );
+}
+
+TDecWorker::~TDecWorker()
+{
+}
+
+/**
+ - allocate CU decoder buffers, called for every picture like the CU decoder of the master
+ .
+ \param uiMaxDepth    total number of allowable depth
+ \param uiMaxWidth    largest CU width
+ \param uiMaxHeight   largest CU height
+ \param uiMaxTrSize   largest transform size
+ */
+Void TDecWorker::create( UInt uiMaxDepth, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxTrSize )
+{
+  m_cPrediction.initTempBuff();
+  m_cCuDecoder.create( uiMaxDepth, uiMaxWidth, uiMaxHeight );
+  m_cTrQuant.init    ( uiMaxWidth, uiMaxHeight, uiMaxTrSize );
+}
+
+Void TDecWorker::destroy()
+{
+  m_cCuDecoder.destroy();
+}
+
+/** set the scaling lists of the slice, as done for the master transform in TDecTop
+ * \param pcSlice slice whose tiles are decoded next
+ */
+Void TDecWorker::initSlice( TComSlice* pcSlice )
+{
+  if ( pcSlice->getSPS()->getScalingListFlag() )
+  {
+    m_cTrQuant.setScalingListDec( pcSlice->getScalingList() );
+    m_cTrQuant.setUseScalingList( true );
+  }
+  else
+  {
+    m_cTrQuant.setFlatScalingList();
+    m_cTrQuant.setUseScalingList( false );
+  }
+}
+
+//! \}
@@ -220,6 +220,11 @@ protected:
 
   Int       m_iWaveFrontSynchro;
   Int       m_iWaveFrontSubstreams;
+  Int       m_iFrameParallelism;                          ///< max. number of pictures compressed concurrently
+  Int       m_iParallelSplitDepth;                        ///< number of CU depths whose split subtree is compressed concurrently
+  Bool      m_bParallelRefME;                             ///< uni-directional ME of the reference pictures of a PU runs concurrently
+  Bool      m_bParallelIntraModes;                        ///< intra luma mode candidates of a PU are checked concurrently
+  Int       m_iLookaheadDepth;                            ///< number of source pictures analyzed ahead of encoding on a background thread, 0: inline
 
   Int       m_decodedPictureHashSEIEnabled;              ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   Int       m_bufferingPeriodSEIEnabled;
@@ -562,6 +567,16 @@ public:
   Int   getWaveFrontsynchro()                            { return m_iWaveFrontSynchro; }
   Void  setWaveFrontSubstreams(Int iWaveFrontSubstreams) { m_iWaveFrontSubstreams = iWaveFrontSubstreams; }
   Int   getWaveFrontSubstreams()                         { return m_iWaveFrontSubstreams; }
+  Void  setFrameParallelism(Int i)                       { m_iFrameParallelism = i; }
+  Int   getFrameParallelism()                            { return m_iFrameParallelism; }
+  Void  setParallelSplitDepth(Int i)                     { m_iParallelSplitDepth = i; }
+  Int   getParallelSplitDepth()                          { return m_iParallelSplitDepth; }
+  Void  setParallelRefME(Bool b)                         { m_bParallelRefME = b; }
+  Bool  getParallelRefME()                               { return m_bParallelRefME; }
+  Void  setParallelIntraModes(Bool b)                    { m_bParallelIntraModes = b; }
+  Bool  getParallelIntraModes()                          { return m_bParallelIntraModes; }
+  Void  setLookaheadDepth(Int i)                         { m_iLookaheadDepth = i; }
+  Int   getLookaheadDepth()                              { return m_iLookaheadDepth; }
   Void  setDecodedPictureHashSEIEnabled(Int b)           { m_decodedPictureHashSEIEnabled = b; }
   Int   getDecodedPictureHashSEIEnabled()                { return m_decodedPictureHashSEIEnabled; }
   Void  setBufferingPeriodSEIEnabled(Int b)              { m_bufferingPeriodSEIEnabled = b; }
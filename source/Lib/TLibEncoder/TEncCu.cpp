@@ -52,6 +52,27 @@ using namespace std;
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
 
+TEncCu::TEncCu()
+{
+  m_ppcBestCU      = NULL;
+  m_ppcTempCU      = NULL;
+  m_uhTotalDepth   = 0;
+
+  m_ppcPredYuvBest = NULL;
+  m_ppcResiYuvBest = NULL;
+  m_ppcRecoYuvBest = NULL;
+  m_ppcPredYuvTemp = NULL;
+  m_ppcResiYuvTemp = NULL;
+  m_ppcRecoYuvTemp = NULL;
+  m_ppcOrigYuv     = NULL;
+
+  m_pcSplitCu      = NULL;
+}
+
+TEncCu::~TEncCu()
+{
+}
+
 /**
  \param    uiTotalDepth  total number of allowable depth
  \param    uiMaxWidth    largest CU width
@@ -203,29 +224,25 @@ Void TEncCu::destroy()
 
 /** \param    pcEncTop      pointer of encoder class
  */
-Void TEncCu::init_new( TEncTop* pcEncTop, TEncEntropy* entropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder )
+Void TEncCu::init_new( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost, TComBitCounter* pcBitCounter, TEncEntropy* entropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder )
 {
   m_pcEncCfg          = pcEncTop;
-//  m_pcTrQuant         = pcEncTop->getTrQuant();
-  m_pcTrQuant         = new TComTrQuant;
-  m_pcTrQuant->copyInit(pcEncTop->getTrQuant());
-  m_pcTrQuant->copyTrQuant(pcEncTop->getTrQuant());
+  m_pcPredSearch      = pcPredSearch;
+  m_pcTrQuant         = pcTrQuant;
+  m_pcBitCounter      = pcBitCounter;
+  m_pcRdCost          = pcRdCost;
 
-  m_pcBitCounter      = pcEncTop->getBitCounter(); 
-  m_pcBitCounter      = new TComBitCounter;
-
-  m_pcRdCost          = pcEncTop->getRdCost();
-//  m_pcRdCost          = new TComRdCost;
+  m_pcEntropyCoder    = entropyCoder;
+  m_pcCavlcCoder      = NULL;
+  m_pcSbacCoder       = NULL;
+  m_pcBinCABAC        = NULL;
 
   m_pppcRDSbacCoder   = pppcRDSbacCoder;
   m_pcRDGoOnSbacCoder = pcRDGoOnSbacCoder;
 
-  m_pcEntropyCoder = entropyCoder;
-  m_pcPredSearch      = new TEncSearch;
-  m_pcPredSearch->init(pcEncTop, m_pcTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getFastSearch(), 0, m_pcEntropyCoder, m_pcRdCost, m_pppcRDSbacCoder, m_pcRDGoOnSbacCoder);
-  
   m_bUseSBACRD        = pcEncTop->getUseSBACRD();
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
+  m_pcSplitCu         = NULL;
 }
 
 /** \param    pcEncTop      pointer of encoder class
@@ -248,6 +265,7 @@ Void TEncCu::init( TEncTop* pcEncTop )
 
   m_bUseSBACRD        = pcEncTop->getUseSBACRD();
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
+  m_pcSplitCu         = NULL;
 }
 
 // ====================================================================================================================
@@ -453,6 +471,27 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
   Bool bSliceStart = pcSlice->getSliceSegmentCurStartCUAddr()>rpcTempCU->getSCUAddr()&&pcSlice->getSliceSegmentCurStartCUAddr()<rpcTempCU->getSCUAddr()+rpcTempCU->getTotalNumPart();
   Bool bSliceEnd = (pcSlice->getSliceSegmentCurEndCUAddr()>rpcTempCU->getSCUAddr()&&pcSlice->getSliceSegmentCurEndCUAddr()<rpcTempCU->getSCUAddr()+rpcTempCU->getTotalNumPart());
   Bool bInsidePicture = ( uiRPelX < rpcBestCU->getSlice()->getSPS()->getPicWidthInLumaSamples() ) && ( uiBPelY < rpcBestCU->getSlice()->getSPS()->getPicHeightInLumaSamples() );
+
+  // compress the split subtree on the split encoder while the unsplit inter modes are checked here; without delta QP
+  // and early CU it does not depend on them, except for the AMP modes of the sub-CUs which are checked after the sync.
+  // Intra modes must wait for the split subtree, so nothing overlaps in I slices
+  Bool bSplitSpawned = false;
+  if( m_pcSplitCu && (Int)uiDepth < m_pcEncCfg->getParallelSplitDepth() && uiDepth < g_uiMaxCUDepth - g_uiAddCUDepth &&
+      rpcTempCU->getSlice()->getSliceType() != I_SLICE && !bSliceEnd && !bSliceStart && bInsidePicture && !rpcTempCU->getSlice()->getPPS()->getUseDQP() && !m_pcEncCfg->getUseEarlyCU() )
+  {
+    m_pcSplitCu->m_ppcTempCU[uiDepth]->initEstData( rpcTempCU, uiDepth, iMinQP );
+    if( m_bUseSBACRD )
+    {
+      m_pcSplitCu->m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST]->load( m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST] );
+    }
+#if AMP_ENC_SPEEDUP
+    cilk_spawn m_pcSplitCu->xCompressSubCUs( m_pcSplitCu->m_ppcTempCU[uiDepth], uiDepth, iMinQP, false, SIZE_2Nx2N );
+#else
+    cilk_spawn m_pcSplitCu->xCompressSubCUs( m_pcSplitCu->m_ppcTempCU[uiDepth], uiDepth, iMinQP, false );
+#endif
+    bSplitSpawned = true;
+  }
+
   // We need to split, so don't try these modes.
   if(!bSliceEnd && !bSliceStart && bInsidePicture )
   {
@@ -660,6 +699,9 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
 #endif
         }
 
+        // intra search reconstructs into the picture, which the split encoder reads inside this CU
+        cilk_sync;
+
         // do normal intra modes
         // speedup for inter frames
         if( rpcBestCU->getSlice()->getSliceType() == I_SLICE || 
@@ -725,6 +767,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
     m_addSADDepth++;
 #endif
   }
+  cilk_sync;
 
   // copy orginal YUV samples to PCM buffer
   if( rpcBestCU->isLosslessCoded(0) && (rpcBestCU->getIPCMFlag(0) == false))
@@ -787,114 +830,23 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
     // further split
     if( bSubBranch && uiDepth < g_uiMaxCUDepth - g_uiAddCUDepth )
     {
-      UChar       uhNextDepth         = uiDepth+1;
-      TComDataCU* pcSubBestPartCU     = m_ppcBestCU[uhNextDepth];
-      TComDataCU* pcSubTempPartCU     = m_ppcTempCU[uhNextDepth];
-
-      for ( UInt uiPartUnitIdx = 0; uiPartUnitIdx < 4; uiPartUnitIdx++ )
-      {
-        pcSubBestPartCU->initSubCU( rpcTempCU, uiPartUnitIdx, uhNextDepth, iQP );           // clear sub partition datas or init.
-        pcSubTempPartCU->initSubCU( rpcTempCU, uiPartUnitIdx, uhNextDepth, iQP );           // clear sub partition datas or init.
-
-        Bool bInSlice = pcSubBestPartCU->getSCUAddr()+pcSubBestPartCU->getTotalNumPart()>pcSlice->getSliceSegmentCurStartCUAddr()&&pcSubBestPartCU->getSCUAddr()<pcSlice->getSliceSegmentCurEndCUAddr();
-        if(bInSlice && ( pcSubBestPartCU->getCUPelX() < pcSlice->getSPS()->getPicWidthInLumaSamples() ) && ( pcSubBestPartCU->getCUPelY() < pcSlice->getSPS()->getPicHeightInLumaSamples() ) )
-        {
-          if( m_bUseSBACRD )
-          {
-            if ( 0 == uiPartUnitIdx) //initialize RD with previous depth buffer
-            {
-              m_pppcRDSbacCoder[uhNextDepth][CI_CURR_BEST]->load(m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST]);
-            }
-            else
-            {
-              m_pppcRDSbacCoder[uhNextDepth][CI_CURR_BEST]->load(m_pppcRDSbacCoder[uhNextDepth][CI_NEXT_BEST]);
-            }
-          }
-
 #if AMP_ENC_SPEEDUP
-          if ( rpcBestCU->isIntra(0) )
-          {
-            xCompressCU( pcSubBestPartCU, pcSubTempPartCU, uhNextDepth, SIZE_NONE );
-          }
-          else
-          {
-            xCompressCU( pcSubBestPartCU, pcSubTempPartCU, uhNextDepth, rpcBestCU->getPartitionSize(0) );
-          }
+      PartSize eSubParentPartSize = rpcBestCU->isIntra(0) ? SIZE_NONE : rpcBestCU->getPartitionSize(0);
+      // the split encoder assumed a 2Nx2N parent, its result is only valid if the sub-CUs would test the same AMP modes
+      if ( bSplitSpawned && ( !pcPic->getSlice(0)->getSPS()->getAMPAcc(uiDepth+1) || xIsSameAMPParent( SIZE_2Nx2N, eSubParentPartSize ) ) )
 #else
-          xCompressCU( pcSubBestPartCU, pcSubTempPartCU, uhNextDepth );
+      if ( bSplitSpawned )
 #endif
-
-          rpcTempCU->copyPartFrom( pcSubBestPartCU, uiPartUnitIdx, uhNextDepth );         // Keep best part data to current temporary data.
-          xCopyYuv2Tmp( pcSubBestPartCU->getTotalNumPart()*uiPartUnitIdx, uhNextDepth );
-        }
-        else if (bInSlice)
-        {
-          pcSubBestPartCU->copyToPic( uhNextDepth );
-          rpcTempCU->copyPartFrom( pcSubBestPartCU, uiPartUnitIdx, uhNextDepth );
-        }
-      }
-
-      if( !bBoundary )
       {
-        m_pcEntropyCoder->resetBits();
-        m_pcEntropyCoder->encodeSplitFlag( rpcTempCU, 0, uiDepth, true );
-
-        rpcTempCU->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // split bits
-        if(m_pcEncCfg->getUseSBACRD())
-        {
-          rpcTempCU->getTotalBins() += ((TEncBinCABAC *)((TEncSbac*)m_pcEntropyCoder->m_pcEntropyCoderIf)->getEncBinIf())->getBinsCoded();
-        }
+        xTakeOverSplit( rpcTempCU, uiDepth );
       }
-      rpcTempCU->getTotalCost()  = m_pcRdCost->calcRdCost( rpcTempCU->getTotalBits(), rpcTempCU->getTotalDistortion() );
-
-      if( (g_uiMaxCUWidth>>uiDepth) == rpcTempCU->getSlice()->getPPS()->getMinCuDQPSize() && rpcTempCU->getSlice()->getPPS()->getUseDQP())
+      else
       {
-        Bool hasResidual = false;
-        for( UInt uiBlkIdx = 0; uiBlkIdx < rpcTempCU->getTotalNumPart(); uiBlkIdx ++)
-        {
-          if( ( pcPic->getCU( rpcTempCU->getAddr() )->getSliceSegmentStartCU(uiBlkIdx+rpcTempCU->getZorderIdxInCU()) == rpcTempCU->getSlice()->getSliceSegmentCurStartCUAddr() ) && 
-              ( rpcTempCU->getCbf( uiBlkIdx, TEXT_LUMA ) || rpcTempCU->getCbf( uiBlkIdx, TEXT_CHROMA_U ) || rpcTempCU->getCbf( uiBlkIdx, TEXT_CHROMA_V ) ) )
-          {
-            hasResidual = true;
-            break;
-          }
-        }
-
-        UInt uiTargetPartIdx;
-        if ( pcPic->getCU( rpcTempCU->getAddr() )->getSliceSegmentStartCU(rpcTempCU->getZorderIdxInCU()) != pcSlice->getSliceSegmentCurStartCUAddr() )
-        {
-          uiTargetPartIdx = pcSlice->getSliceSegmentCurStartCUAddr() % pcPic->getNumPartInCU() - rpcTempCU->getZorderIdxInCU();
-        }
-        else
-        {
-          uiTargetPartIdx = 0;
-        }
-        if ( hasResidual )
-        {
-#if !RDO_WITHOUT_DQP_BITS
-          m_pcEntropyCoder->resetBits();
-          m_pcEntropyCoder->encodeQP( rpcTempCU, uiTargetPartIdx, false );
-          rpcTempCU->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // dQP bits
-          if(m_pcEncCfg->getUseSBACRD())
-          {
-            rpcTempCU->getTotalBins() += ((TEncBinCABAC *)((TEncSbac*)m_pcEntropyCoder->m_pcEntropyCoderIf)->getEncBinIf())->getBinsCoded();
-          }
-          rpcTempCU->getTotalCost()  = m_pcRdCost->calcRdCost( rpcTempCU->getTotalBits(), rpcTempCU->getTotalDistortion() );
+#if AMP_ENC_SPEEDUP
+        xCompressSubCUs( rpcTempCU, uiDepth, iQP, bBoundary, eSubParentPartSize );
+#else
+        xCompressSubCUs( rpcTempCU, uiDepth, iQP, bBoundary );
 #endif
-
-          Bool foundNonZeroCbf = false;
-          rpcTempCU->setQPSubCUs( rpcTempCU->getRefQP( uiTargetPartIdx ), rpcTempCU, 0, uiDepth, foundNonZeroCbf );
-          assert( foundNonZeroCbf );
-        }
-        else
-        {
-          rpcTempCU->setQPSubParts( rpcTempCU->getRefQP( uiTargetPartIdx ), 0, uiDepth ); // set QP to default QP
-        }
-      }
-
-      if( m_bUseSBACRD )
-      {
-        m_pppcRDSbacCoder[uhNextDepth][CI_NEXT_BEST]->store(m_pppcRDSbacCoder[uiDepth][CI_TEMP_BEST]);
       }
       Bool isEndOfSlice        = rpcBestCU->getSlice()->getSliceMode()==FIXED_NUMBER_OF_BYTES
                                  && (rpcBestCU->getTotalBits()>rpcBestCU->getSlice()->getSliceArgument()<<3);
@@ -927,6 +879,180 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
   assert( rpcBestCU->getTotalCost     (   ) != MAX_DOUBLE );
 }
 
+#if AMP_ENC_SPEEDUP
+/** check whether sub-CUs compressed below two parent partition sizes test the same AMP modes
+ * \param eParentPartSize  partition size the sub-CUs were compressed with
+ * \param eOtherPartSize   partition size to compare with, SIZE_NONE for an intra parent
+ * \returns true if deriveTestModeAMP() of the sub-CUs does not distinguish the two
+ */
+Bool TEncCu::xIsSameAMPParent( PartSize eParentPartSize, PartSize eOtherPartSize )
+{
+  Bool bParentAMP = eParentPartSize >= SIZE_2NxnU && eParentPartSize <= SIZE_nRx2N;
+  Bool bOtherAMP  = eOtherPartSize  >= SIZE_2NxnU && eOtherPartSize  <= SIZE_nRx2N;
+#if AMP_MRG
+  return bParentAMP == bOtherAMP && ( eParentPartSize == SIZE_NONE ) == ( eOtherPartSize == SIZE_NONE );
+#else
+  return bParentAMP == bOtherAMP && ( eParentPartSize == SIZE_2Nx2N ) == ( eOtherPartSize == SIZE_2Nx2N );
+#endif
+}
+#endif
+
+/** compress the four sub-CUs of a CU and collect them in the temporary CU of its depth
+ * \param rpcTempCU        CU collecting the best sub-CUs, initialized for estimation at uiDepth
+ * \param uiDepth          depth of the CU
+ * \param iQP              QP of the sub-CUs
+ * \param bBoundary        CU crosses the picture boundary, the split flag is not coded
+ * \param eParentPartSize  partition size of the best unsplit mode passed to the sub-CUs, SIZE_NONE for intra
+ * \returns Void
+ *
+ *- the reconstruction is collected in m_ppcRecoYuvTemp[uiDepth], the contexts in m_pppcRDSbacCoder[uiDepth][CI_TEMP_BEST]
+ */
+#if AMP_ENC_SPEEDUP
+Void TEncCu::xCompressSubCUs( TComDataCU*& rpcTempCU, UInt uiDepth, Int iQP, Bool bBoundary, PartSize eParentPartSize )
+#else
+Void TEncCu::xCompressSubCUs( TComDataCU*& rpcTempCU, UInt uiDepth, Int iQP, Bool bBoundary )
+#endif
+{
+  TComPic* pcPic = rpcTempCU->getPic();
+  TComSlice * pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+
+  UChar       uhNextDepth         = uiDepth+1;
+  TComDataCU* pcSubBestPartCU     = m_ppcBestCU[uhNextDepth];
+  TComDataCU* pcSubTempPartCU     = m_ppcTempCU[uhNextDepth];
+
+  for ( UInt uiPartUnitIdx = 0; uiPartUnitIdx < 4; uiPartUnitIdx++ )
+  {
+    pcSubBestPartCU->initSubCU( rpcTempCU, uiPartUnitIdx, uhNextDepth, iQP );           // clear sub partition datas or init.
+    pcSubTempPartCU->initSubCU( rpcTempCU, uiPartUnitIdx, uhNextDepth, iQP );           // clear sub partition datas or init.
+
+    Bool bInSlice = pcSubBestPartCU->getSCUAddr()+pcSubBestPartCU->getTotalNumPart()>pcSlice->getSliceSegmentCurStartCUAddr()&&pcSubBestPartCU->getSCUAddr()<pcSlice->getSliceSegmentCurEndCUAddr();
+    if(bInSlice && ( pcSubBestPartCU->getCUPelX() < pcSlice->getSPS()->getPicWidthInLumaSamples() ) && ( pcSubBestPartCU->getCUPelY() < pcSlice->getSPS()->getPicHeightInLumaSamples() ) )
+    {
+      if( m_bUseSBACRD )
+      {
+        if ( 0 == uiPartUnitIdx) //initialize RD with previous depth buffer
+        {
+          m_pppcRDSbacCoder[uhNextDepth][CI_CURR_BEST]->load(m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST]);
+        }
+        else
+        {
+          m_pppcRDSbacCoder[uhNextDepth][CI_CURR_BEST]->load(m_pppcRDSbacCoder[uhNextDepth][CI_NEXT_BEST]);
+        }
+      }
+
+#if AMP_ENC_SPEEDUP
+      xCompressCU( pcSubBestPartCU, pcSubTempPartCU, uhNextDepth, eParentPartSize );
+#else
+      xCompressCU( pcSubBestPartCU, pcSubTempPartCU, uhNextDepth );
+#endif
+
+      rpcTempCU->copyPartFrom( pcSubBestPartCU, uiPartUnitIdx, uhNextDepth );         // Keep best part data to current temporary data.
+      xCopyYuv2Tmp( pcSubBestPartCU->getTotalNumPart()*uiPartUnitIdx, uhNextDepth );
+    }
+    else if (bInSlice)
+    {
+      pcSubBestPartCU->copyToPic( uhNextDepth );
+      rpcTempCU->copyPartFrom( pcSubBestPartCU, uiPartUnitIdx, uhNextDepth );
+    }
+  }
+
+  if( !bBoundary )
+  {
+    m_pcEntropyCoder->resetBits();
+    m_pcEntropyCoder->encodeSplitFlag( rpcTempCU, 0, uiDepth, true );
+
+    rpcTempCU->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // split bits
+    if(m_pcEncCfg->getUseSBACRD())
+    {
+      rpcTempCU->getTotalBins() += ((TEncBinCABAC *)((TEncSbac*)m_pcEntropyCoder->m_pcEntropyCoderIf)->getEncBinIf())->getBinsCoded();
+    }
+  }
+  rpcTempCU->getTotalCost()  = m_pcRdCost->calcRdCost( rpcTempCU->getTotalBits(), rpcTempCU->getTotalDistortion() );
+
+  if( (g_uiMaxCUWidth>>uiDepth) == rpcTempCU->getSlice()->getPPS()->getMinCuDQPSize() && rpcTempCU->getSlice()->getPPS()->getUseDQP())
+  {
+    Bool hasResidual = false;
+    for( UInt uiBlkIdx = 0; uiBlkIdx < rpcTempCU->getTotalNumPart(); uiBlkIdx ++)
+    {
+      if( ( pcPic->getCU( rpcTempCU->getAddr() )->getSliceSegmentStartCU(uiBlkIdx+rpcTempCU->getZorderIdxInCU()) == rpcTempCU->getSlice()->getSliceSegmentCurStartCUAddr() ) && 
+          ( rpcTempCU->getCbf( uiBlkIdx, TEXT_LUMA ) || rpcTempCU->getCbf( uiBlkIdx, TEXT_CHROMA_U ) || rpcTempCU->getCbf( uiBlkIdx, TEXT_CHROMA_V ) ) )
+      {
+        hasResidual = true;
+        break;
+      }
+    }
+
+    UInt uiTargetPartIdx;
+    if ( pcPic->getCU( rpcTempCU->getAddr() )->getSliceSegmentStartCU(rpcTempCU->getZorderIdxInCU()) != pcSlice->getSliceSegmentCurStartCUAddr() )
+    {
+      uiTargetPartIdx = pcSlice->getSliceSegmentCurStartCUAddr() % pcPic->getNumPartInCU() - rpcTempCU->getZorderIdxInCU();
+    }
+    else
+    {
+      uiTargetPartIdx = 0;
+    }
+    if ( hasResidual )
+    {
+#if !RDO_WITHOUT_DQP_BITS
+      m_pcEntropyCoder->resetBits();
+      m_pcEntropyCoder->encodeQP( rpcTempCU, uiTargetPartIdx, false );
+      rpcTempCU->getTotalBits() += m_pcEntropyCoder->getNumberOfWrittenBits(); // dQP bits
+      if(m_pcEncCfg->getUseSBACRD())
+      {
+        rpcTempCU->getTotalBins() += ((TEncBinCABAC *)((TEncSbac*)m_pcEntropyCoder->m_pcEntropyCoderIf)->getEncBinIf())->getBinsCoded();
+      }
+      rpcTempCU->getTotalCost()  = m_pcRdCost->calcRdCost( rpcTempCU->getTotalBits(), rpcTempCU->getTotalDistortion() );
+#endif
+
+      Bool foundNonZeroCbf = false;
+      rpcTempCU->setQPSubCUs( rpcTempCU->getRefQP( uiTargetPartIdx ), rpcTempCU, 0, uiDepth, foundNonZeroCbf );
+      assert( foundNonZeroCbf );
+    }
+    else
+    {
+      rpcTempCU->setQPSubParts( rpcTempCU->getRefQP( uiTargetPartIdx ), 0, uiDepth ); // set QP to default QP
+    }
+  }
+
+  if( m_bUseSBACRD )
+  {
+    m_pppcRDSbacCoder[uhNextDepth][CI_NEXT_BEST]->store(m_pppcRDSbacCoder[uiDepth][CI_TEMP_BEST]);
+  }
+}
+
+/** take over the split subtree compressed by the split encoder as the temporary CU of this depth
+ * \param rpcTempCU  temporary CU of this depth, replaced by the one of the split encoder
+ * \param uiDepth    depth of the CU
+ * \returns Void
+ *
+ *- CU data and reconstruction buffers are exchanged with the split encoder instead of being copied
+ */
+Void TEncCu::xTakeOverSplit( TComDataCU*& rpcTempCU, UInt uiDepth )
+{
+  TComDataCU* pcSplitCU = m_pcSplitCu->m_ppcTempCU[uiDepth];
+  TComDataCU* pcOwnCU   = rpcTempCU;
+  if ( m_ppcTempCU[uiDepth] == pcOwnCU )
+  {
+    m_ppcTempCU[uiDepth] = pcSplitCU;
+  }
+  else
+  {
+    m_ppcBestCU[uiDepth] = pcSplitCU;
+  }
+  m_pcSplitCu->m_ppcTempCU[uiDepth] = pcOwnCU;
+  rpcTempCU = pcSplitCU;
+
+  TComYuv* pcYuv = m_ppcRecoYuvTemp[uiDepth];
+  m_ppcRecoYuvTemp[uiDepth] = m_pcSplitCu->m_ppcRecoYuvTemp[uiDepth];
+  m_pcSplitCu->m_ppcRecoYuvTemp[uiDepth] = pcYuv;
+
+  if( m_bUseSBACRD )
+  {
+    m_pppcRDSbacCoder[uiDepth][CI_TEMP_BEST]->load( m_pcSplitCu->m_pppcRDSbacCoder[uiDepth][CI_TEMP_BEST] );
+    m_pcRDGoOnSbacCoder->load( m_pcSplitCu->m_pcRDGoOnSbacCoder );
+  }
+}
+
 /** finish encoding a cu and handle end-of-slice conditions
  * \param pcCU
  * \param uiAbsPartIdx
@@ -98,17 +98,23 @@ private:
   TEncSbac*               m_pcRDGoOnSbacCoder;
   Bool                    m_bUseSBACRD;
   TEncRateCtrl*           m_pcRateCtrl;
+
+  TEncCu*                 m_pcSplitCu;      ///< CU encoder of another context compressing split subtrees concurrently, NULL if none
 #if RATE_CONTROL_LAMBDA_DOMAIN && !M0036_RC_IMPROVEMENT
   UInt                    m_LCUPredictionSAD;
   Int                     m_addSADDepth;
   Int                     m_temporalSAD;
 #endif
 public:
+  TEncCu();
+  virtual ~TEncCu();
+
   /// copy parameters from encoder class
   Void  init                ( TEncTop* pcEncTop );
 
-  /// init with all new objects
-  Void  init_new            ( TEncTop* pcEncTop, TEncEntropy* entropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder );
+  /// init with the private objects of a parallel worker
+  Void  init_new            ( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                              TComBitCounter* pcBitCounter, TEncEntropy* entropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder );
   
   /// create internal buffers
   Void  create              ( UChar uhTotalDepth, UInt iMaxWidth, UInt iMaxHeight );
@@ -126,6 +132,7 @@ public:
   Void setEntropyCoder (TEncEntropy* entropyCoder) { m_pcEntropyCoder = entropyCoder; }
   
   Void setBitCounter        ( TComBitCounter* pcBitCounter ) { m_pcBitCounter = pcBitCounter; }
+  Void setSplitEncoder      ( TEncCu* pcSplitCu )            { m_pcSplitCu = pcSplitCu;       }
 #if RATE_CONTROL_LAMBDA_DOMAIN && !M0036_RC_IMPROVEMENT
   UInt getLCUPredictionSAD() { return m_LCUPredictionSAD; }
 #endif
@@ -139,6 +146,13 @@ protected:
 #else
   Void  xCompressCU         ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt uiDepth        );
 #endif
+#if AMP_ENC_SPEEDUP
+  Void  xCompressSubCUs     ( TComDataCU*& rpcTempCU, UInt uiDepth, Int iQP, Bool bBoundary, PartSize eParentPartSize );
+  Bool  xIsSameAMPParent    ( PartSize eParentPartSize, PartSize eOtherPartSize );
+#else
+  Void  xCompressSubCUs     ( TComDataCU*& rpcTempCU, UInt uiDepth, Int iQP, Bool bBoundary );
+#endif
+  Void  xTakeOverSplit      ( TComDataCU*& rpcTempCU, UInt uiDepth );
   Void  xEncodeCU           ( TComDataCU*  pcCU, UInt uiAbsPartIdx,           UInt uiDepth        );
   
   Int   xComputeQP          ( TComDataCU* pcCU, UInt uiDepth );
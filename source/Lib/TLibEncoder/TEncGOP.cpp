@@ -48,6 +48,7 @@
 #include "NALwrite.h"
 #include <time.h>
 #include <math.h>
+#include <cilk/cilk.h>
 
 using namespace std;
 //! \ingroup TLibEncoder
@@ -355,599 +356,74 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   UInt *accumBitsDU = NULL;
   UInt *accumNalsDU = NULL;
   SEIDecodingUnitInfo decodingUnitInfoSEI;
-  for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
+  std::vector<GOPPicture*> cWave;        // prepared pictures whose slices are compressed concurrently
+  UInt        uiWavePic  = 0;             // next picture of the wave to be filtered and written
+  GOPPicture* pcNextPic  = NULL;          // prepared picture referencing the wave, it starts the next wave
+  Int         iNextGOPid = 0;             // next picture of the GOP to be prepared
+  Int         iSlot      = 0;             // frame slot for the next picture to be prepared
+  while ( iNextGOPid < m_iGopSize || uiWavePic < cWave.size() || pcNextPic )
   {
-    UInt uiColDir = 1;
-    //-- For time output for each slice
-    long iBeforeTime = clock();
-    
-    //select uiColDir
-    Int iCloseLeft=1, iCloseRight=-1;
-    for(Int i = 0; i<m_pcCfg->getGOPEntry(iGOPid).m_numRefPics; i++)
-    {
-      Int iRef = m_pcCfg->getGOPEntry(iGOPid).m_referencePics[i];
-      if(iRef>0&&(iRef<iCloseRight||iCloseRight==-1))
-      {
-        iCloseRight=iRef;
-      }
-      else if(iRef<0&&(iRef>iCloseLeft||iCloseLeft==1))
-      {
-        iCloseLeft=iRef;
-      }
-    }
-    if(iCloseRight>-1)
-    {
-      iCloseRight=iCloseRight+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
-    }
-    if(iCloseLeft<1)
-    {
-      iCloseLeft=iCloseLeft+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
-      while(iCloseLeft<0)
-      {
-        iCloseLeft+=m_iGopSize;
-      }
-    }
-    Int iLeftQP=0, iRightQP=0;
-    for(Int i=0; i<m_iGopSize; i++)
-    {
-      if(m_pcCfg->getGOPEntry(i).m_POC==(iCloseLeft%m_iGopSize)+1)
-      {
-        iLeftQP= m_pcCfg->getGOPEntry(i).m_QPOffset;
-      }
-      if (m_pcCfg->getGOPEntry(i).m_POC==(iCloseRight%m_iGopSize)+1)
-      {
-        iRightQP=m_pcCfg->getGOPEntry(i).m_QPOffset;
-      }
-    }
-    if(iCloseRight>-1&&iRightQP<iLeftQP)
-    {
-      uiColDir=0;
-    }
-    
-    /////////////////////////////////////////////////////////////////////////////////////////////////// Initial to start encoding
-    Int iTimeOffset;
-    Int pocCurr;
-    
-    if(iPOCLast == 0) //case first frame or first top field
-    {
-      pocCurr=0;
-      iTimeOffset = 1;
-    }
-    else if(iPOCLast == 1 && isField) //case first bottom field, just like the first frame, the poc computation is not right anymore, we set the right value
-    {
-      pocCurr = 1;
-      iTimeOffset = 1;
-    }
-    else
-    {
-      pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - isField;
-      iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
-    }
-    
-    if(pocCurr>=m_pcCfg->getFramesToBeEncoded())
-    {
-      continue;
-    }
-    
-    if( getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
-    {
-      m_iLastIDR = pocCurr;
-    }
-    // start a new access unit: create an entry in the list of output access units
-    accessUnitsInGOP.push_back(AccessUnit());
-    AccessUnit& accessUnit = accessUnitsInGOP.back();
-    xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField);
-    
-    //  Slice data initialization
-    pcPic->clearSliceBuffer();
-    assert(pcPic->getNumAllocatedSlice() == 1);
-    m_pcSliceEncoder->setSliceIdx(0);
-    pcPic->setCurrSliceIdx(0);
-    
-    m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iNumPicRcvd, iGOPid, pcSlice, m_pcEncTop->getSPS(), m_pcEncTop->getPPS(), isField );
-    
-    //Set Frame/Field coding
-    pcSlice->getPic()->setField(isField);
-    
-    pcSlice->setLastIDR(m_iLastIDR);
-    pcSlice->setSliceIdx(0);
-    //set default slice level flag to the same as SPS level flag
-    pcSlice->setLFCrossSliceBoundaryFlag(  pcSlice->getPPS()->getLoopFilterAcrossSlicesEnabledFlag()  );
-    pcSlice->setScalingList ( m_pcEncTop->getScalingList()  );
-    if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_OFF)
-    {
-      m_pcEncTop->getTrQuant()->setFlatScalingList();
-      m_pcEncTop->getTrQuant()->setUseScalingList(false);
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-    }
-    else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_DEFAULT)
-    {
-      pcSlice->setDefaultScalingList ();
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getTrQuant()->setScalingList(pcSlice->getScalingList());
-      m_pcEncTop->getTrQuant()->setUseScalingList(true);
-    }
-    else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_FILE_READ)
-    {
-      if(pcSlice->getScalingList()->xParseScalingList(m_pcCfg->getScalingListFile()))
-      {
-        pcSlice->setDefaultScalingList ();
-      }
-      pcSlice->getScalingList()->checkDcOfMatrix();
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(pcSlice->checkDefaultScalingList());
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getTrQuant()->setScalingList(pcSlice->getScalingList());
-      m_pcEncTop->getTrQuant()->setUseScalingList(true);
-    }
-    else
-    {
-      printf("error : ScalingList == %d no support\n",m_pcEncTop->getUseScalingListId());
-      assert(0);
-    }
-    
-    if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='P')
-    {
-      pcSlice->setSliceType(P_SLICE);
-    }
-    // Set the nal unit type
-    pcSlice->setNalUnitType(getNalUnitType(pocCurr, m_iLastIDR));
-    if(pcSlice->getTemporalLayerNonReferenceFlag())
-    {
-      if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_R &&
-          !(m_iGopSize == 1 && pcSlice->getSliceType() == I_SLICE))
-        // Add this condition to avoid POC issues with encoder_intra_main.cfg configuration (see #1127 in bug tracker)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TRAIL_N);
-      }
-      if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RADL_R)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RADL_N);
-      }
-      if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RASL_R)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RASL_N);
-      }
-    }
-    
-    // Do decoding refresh marking if any
-    pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic);
-    m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
-    pcSlice->getRPS()->setNumberOfLongtermPictures(0);
-    
-#if FIX1071
-    if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0) || (pcSlice->isIRAP()))
-    {
-      pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP());
-    }
-#else
-    if(pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0)
-    {
-      pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS());
-    }
-#endif
-    pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
-    
-    if(pcSlice->getTLayer() > 0)
+    if ( uiWavePic == cWave.size() )
     {
-      if(pcSlice->isTemporalLayerSwitchingPoint(rcListPic) || pcSlice->getSPS()->getTemporalIdNestingFlag())
-      {
-        if(pcSlice->getTemporalLayerNonReferenceFlag())
-        {
-          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_N);
-        }
-        else
-        {
-          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TLA_R);
-        }
-      }
-      else if(pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
+      // prepare the next pictures in coding order until one of them references a picture of the wave, then
+      // compress the slices of the wave concurrently; filtering and writing stays in coding order
+      cWave.clear();
+      uiWavePic = 0;
+      if ( pcNextPic )
       {
-        Bool isSTSA=true;
-        for(Int ii=iGOPid+1;(ii<m_pcCfg->getGOPSize() && isSTSA==true);ii++)
-        {
-          Int lTid= m_pcCfg->getGOPEntry(ii).m_temporalId;
-          if(lTid==pcSlice->getTLayer())
-          {
-            TComReferencePictureSet* nRPS = pcSlice->getSPS()->getRPSList()->getReferencePictureSet(ii);
-            for(Int jj=0;jj<nRPS->getNumberOfPictures();jj++)
-            {
-              if(nRPS->getUsed(jj))
-              {
-                Int tPoc=m_pcCfg->getGOPEntry(ii).m_POC+nRPS->getDeltaPOC(jj);
-                Int kk=0;
-                for(kk=0;kk<m_pcCfg->getGOPSize();kk++)
-                {
-                  if(m_pcCfg->getGOPEntry(kk).m_POC==tPoc)
-                    break;
-                }
-                Int tTid=m_pcCfg->getGOPEntry(kk).m_temporalId;
-                if(tTid >= pcSlice->getTLayer())
-                {
-                  isSTSA=false;
-                  break;
-                }
-              }
-            }
-          }
-        }
-        if(isSTSA==true)
-        {
-          if(pcSlice->getTemporalLayerNonReferenceFlag())
-          {
-            pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_N);
-          }
-          else
-          {
-            pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_R);
-          }
-        }
+        cWave.push_back( pcNextPic );
+        pcNextPic = NULL;
       }
-    }
-    arrangeLongtermPicturesInRPS(pcSlice, rcListPic);
-    TComRefPicListModification* refPicListModification = pcSlice->getRefPicListModification();
-    refPicListModification->setRefPicListModificationFlagL0(0);
-    refPicListModification->setRefPicListModificationFlagL1(0);
-    pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
-    pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
-    
-#if ADAPTIVE_QP_SELECTION
-    pcSlice->setTrQuant( m_pcEncTop->getTrQuant() );
-#endif
-    
-    //  Set reference list
-    pcSlice->setRefPicList ( rcListPic );
-    
-    //  Slice info. refinement
-    if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
-    {
-      pcSlice->setSliceType ( P_SLICE );
-    }
-    
-    if (pcSlice->getSliceType() == B_SLICE)
-    {
-      pcSlice->setColFromL0Flag(1-uiColDir);
-      Bool bLowDelay = true;
-      Int  iCurrPOC  = pcSlice->getPOC();
-      Int iRefIdx = 0;
-      
-      for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_0) && bLowDelay; iRefIdx++)
+      while ( iNextGOPid < m_iGopSize && (Int)cWave.size() < m_pcCfg->getFrameParallelism() )
       {
-        if ( pcSlice->getRefPic(REF_PIC_LIST_0, iRefIdx)->getPOC() > iCurrPOC )
+        GOPPicture* pcGOPPic = new GOPPicture;
+        if ( !xPreparePicture( iPOCLast, iNumPicRcvd, iNextGOPid++, rcListPic, rcListPicYuvRecOut, accessUnitsInGOP, isField, m_pcEncTop->getFrameSliceEncoder( iSlot ), *pcGOPPic ) )
         {
-          bLowDelay = false;
+          delete pcGOPPic;
+          continue;
         }
-      }
-      for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_1) && bLowDelay; iRefIdx++)
-      {
-        if ( pcSlice->getRefPic(REF_PIC_LIST_1, iRefIdx)->getPOC() > iCurrPOC )
+        iSlot = ( iSlot + 1 ) % m_pcCfg->getFrameParallelism();
+        if ( xReferencesWave( pcGOPPic, cWave ) )
         {
-          bLowDelay = false;
+          pcNextPic = pcGOPPic;
+          break;
         }
+        cWave.push_back( pcGOPPic );
       }
-      
-      pcSlice->setCheckLDC(bLowDelay);
-    }
-    else
-    {
-      pcSlice->setCheckLDC(true);
-    }
-    
-    uiColDir = 1-uiColDir;
-    
-    //-------------------------------------------------------------
-    pcSlice->setRefPOCList();
-    
-    pcSlice->setList1IdxToList0Idx();
-    
-    if (m_pcEncTop->getTMVPModeId() == 2)
-    {
-      if (iGOPid == 0) // first picture in SOP (i.e. forward B)
-      {
-        pcSlice->setEnableTMVPFlag(0);
-      }
-      else
-      {
-        // Note: pcSlice->getColFromL0Flag() is assumed to be always 0 and getcolRefIdx() is always 0.
-        pcSlice->setEnableTMVPFlag(1);
-      }
-      pcSlice->getSPS()->setTMVPFlagsPresent(1);
-    }
-    else if (m_pcEncTop->getTMVPModeId() == 1)
-    {
-      pcSlice->getSPS()->setTMVPFlagsPresent(1);
-      pcSlice->setEnableTMVPFlag(1);
-    }
-    else
-    {
-      pcSlice->getSPS()->setTMVPFlagsPresent(0);
-      pcSlice->setEnableTMVPFlag(0);
-    }
-    /////////////////////////////////////////////////////////////////////////////////////////////////// Compress a slice
-    //  Slice compression
-    if (m_pcCfg->getUseASR())
-    {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
-    }
-    
-    Bool bGPBcheck=false;
-    if ( pcSlice->getSliceType() == B_SLICE)
-    {
-      if ( pcSlice->getNumRefIdx(RefPicList( 0 ) ) == pcSlice->getNumRefIdx(RefPicList( 1 ) ) )
+      if ( cWave.empty() )
       {
-        bGPBcheck=true;
-        Int i;
-        for ( i=0; i < pcSlice->getNumRefIdx(RefPicList( 1 ) ); i++ )
-        {
-          if ( pcSlice->getRefPOC(RefPicList(1), i) != pcSlice->getRefPOC(RefPicList(0), i) )
-          {
-            bGPBcheck=false;
-            break;
-          }
-        }
+        continue;
       }
-    }
-    if(bGPBcheck)
-    {
-      pcSlice->setMvdL1ZeroFlag(true);
-    }
-    else
-    {
-      pcSlice->setMvdL1ZeroFlag(false);
-    }
-    pcPic->getSlice(pcSlice->getSliceIdx())->setMvdL1ZeroFlag(pcSlice->getMvdL1ZeroFlag());
-    
+      xCompressWave( cWave );
+    }
+    
+    GOPPicture* pcGOPPic         = cWave[uiWavePic++];
+    Int         iGOPid           = pcGOPPic->m_iGOPid;
+    Int         pocCurr          = pcGOPPic->m_pocCurr;
+    long        iBeforeTime      = pcGOPPic->m_iBeforeTime;
+    AccessUnit& accessUnit       = *pcGOPPic->m_pcAccessUnit;
+    UInt        uiNumSlices      = pcGOPPic->m_uiNumSlices;
+    UInt        uiRealEndAddress = pcGOPPic->m_uiRealEndAddress;
+    Int         iLastIDR         = pcGOPPic->m_iLastIDR;
+    pcPic          = pcGOPPic->m_pcPic;
+    pcPicYuvRecOut = pcGOPPic->m_pcPicYuvRecOut;
+    m_storedStartCUAddrForEncodingSlice.swap       ( pcGOPPic->m_storedStartCUAddrForEncodingSlice );
+    m_storedStartCUAddrForEncodingSliceSegment.swap( pcGOPPic->m_storedStartCUAddrForEncodingSliceSegment );
 #if RATE_CONTROL_LAMBDA_DOMAIN
-    Double lambda            = 0.0;
+    Double lambda            = pcGOPPic->m_dLambda;
     Int actualHeadBits       = 0;
     Int actualTotalBits      = 0;
-    Int estimatedBits        = 0;
+    Int estimatedBits        = pcGOPPic->m_iEstimatedBits;
     Int tmpBitsBeforeWriting = 0;
-    if ( m_pcCfg->getUseRateCtrl() )
-    {
-      Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
-      if ( pcPic->getSlice(0)->getSliceType() == I_SLICE )
-      {
-        frameLevel = 0;
-      }
-      m_pcRateCtrl->initRCPic( frameLevel );
-      estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
-      
-      Int sliceQP = m_pcCfg->getInitialQP();
-      if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
-      {
-        Int    NumberBFrames = ( m_pcCfg->getGOPSize() - 1 );
-        Double dLambda_scale = 1.0 - Clip3( 0.0, 0.5, 0.05*(Double)NumberBFrames );
-        Double dQPFactor     = 0.57*dLambda_scale;
-        Int    SHIFT_QP      = 12;
-        Int    bitdepth_luma_qp_scale = 0;
-        Double qp_temp = (Double) sliceQP + bitdepth_luma_qp_scale - SHIFT_QP;
-        lambda = dQPFactor*pow( 2.0, qp_temp/3.0 );
-      }
-      else if ( frameLevel == 0 )   // intra case, but use the model
-      {
-#if RATE_CONTROL_INTRA
-        m_pcSliceEncoder->calCostSliceI(pcPic);
 #endif
-        if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
-        {
-          Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
-#if RATE_CONTROL_INTRA
-          bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
-#else
-          bits = m_pcRateCtrl->getRCSeq()->getRefineBitsForIntra( bits );
-#endif
-          if ( bits < 200 )
-          {
-            bits = 200;
-          }
-          m_pcRateCtrl->getRCPic()->setTargetBits( bits );
-        }
-        
-        list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
-#if RATE_CONTROL_INTRA
-        m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
-#else
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
-#endif
-        sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
-      }
-      else    // normal case
-      {
-        list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
-#if RATE_CONTROL_INTRA
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
-#else
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
-#endif
-        sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
-      }
-      
-      sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffsetY(), MAX_QP, sliceQP );
-      m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
-      
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
-    }
-#endif
-    
-    UInt uiNumSlices = 1;
-    
-    UInt uiInternalAddress = pcPic->getNumPartInCU()-4;
-    UInt uiExternalAddress = pcPic->getPicSym()->getNumberOfCUsInFrame()-1;
-    UInt uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
-    UInt uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
-    UInt uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
-    UInt uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
-    while(uiPosX>=uiWidth||uiPosY>=uiHeight)
-    {
-      uiInternalAddress--;
-      uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
-      uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
-    }
-    uiInternalAddress++;
-    if(uiInternalAddress==pcPic->getNumPartInCU())
-    {
-      uiInternalAddress = 0;
-      uiExternalAddress++;
-    }
-    UInt uiRealEndAddress = uiExternalAddress*pcPic->getNumPartInCU()+uiInternalAddress;
-    
-    UInt uiCummulativeTileWidth;
-    UInt uiCummulativeTileHeight;
-    Int  p, j;
-    UInt uiEncCUAddr;
-    
-    //set NumColumnsMinus1 and NumRowsMinus1
-    pcPic->getPicSym()->setNumColumnsMinus1( pcSlice->getPPS()->getNumColumnsMinus1() );
-    pcPic->getPicSym()->setNumRowsMinus1( pcSlice->getPPS()->getNumRowsMinus1() );
-    
-    //create the TComTileArray
-    pcPic->getPicSym()->xCreateTComTileArray();
-    
-    if( pcSlice->getPPS()->getUniformSpacingFlag() == 1 )
-    {
-      //set the width for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
-      {
-        for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1()+1; p++)
-        {
-          pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->
-          setTileWidth( (p+1)*pcPic->getPicSym()->getFrameWidthInCU()/(pcPic->getPicSym()->getNumColumnsMinus1()+1)
-                       - (p*pcPic->getPicSym()->getFrameWidthInCU())/(pcPic->getPicSym()->getNumColumnsMinus1()+1) );
-        }
-      }
-      
-      //set the height for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
-      {
-        for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1()+1; p++)
-        {
-          pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->
-          setTileHeight( (p+1)*pcPic->getPicSym()->getFrameHeightInCU()/(pcPic->getPicSym()->getNumRowsMinus1()+1)
-                        - (p*pcPic->getPicSym()->getFrameHeightInCU())/(pcPic->getPicSym()->getNumRowsMinus1()+1) );
-        }
-      }
-    }
-    else
-    {
-      //set the width for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
-      {
-        uiCummulativeTileWidth = 0;
-        for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1(); p++)
-        {
-          pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->setTileWidth( pcSlice->getPPS()->getColumnWidth(p) );
-          uiCummulativeTileWidth += pcSlice->getPPS()->getColumnWidth(p);
-        }
-        pcPic->getPicSym()->getTComTile(j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p)->setTileWidth( pcPic->getPicSym()->getFrameWidthInCU()-uiCummulativeTileWidth );
-      }
-      
-      //set the height for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
-      {
-        uiCummulativeTileHeight = 0;
-        for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1(); p++)
-        {
-          pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->setTileHeight( pcSlice->getPPS()->getRowHeight(p) );
-          uiCummulativeTileHeight += pcSlice->getPPS()->getRowHeight(p);
-        }
-        pcPic->getPicSym()->getTComTile(p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcPic->getPicSym()->getFrameHeightInCU()-uiCummulativeTileHeight );
-      }
-    }
-    //intialize each tile of the current picture
-    pcPic->getPicSym()->xInitTiles();
-    
-    // Allocate some coders, now we know how many tiles there are.
-    Int iNumSubstreams = pcSlice->getPPS()->getNumSubstreams();
-    
-    //generate the Coding Order Map and Inverse Coding Order Map
-    for(p=0, uiEncCUAddr=0; p<pcPic->getPicSym()->getNumberOfCUsInFrame(); p++, uiEncCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(uiEncCUAddr))
-    {
-      pcPic->getPicSym()->setCUOrderMap(p, uiEncCUAddr);
-      pcPic->getPicSym()->setInverseCUOrderMap(uiEncCUAddr, p);
-    }
-    pcPic->getPicSym()->setCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
-    pcPic->getPicSym()->setInverseCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
+    Int j;
     
     // Allocate some coders, now we know how many tiles there are.
+    Int iNumSubstreams = pcPic->getSlice(0)->getPPS()->getNumSubstreams();
     m_pcEncTop->createWPPCoders(iNumSubstreams);
     pcSbacCoders = m_pcEncTop->getSbacCoders();
     pcSubstreamsOut = new TComOutputBitstream[iNumSubstreams];
     
-    UInt startCUAddrSliceIdx = 0; // used to index "m_uiStoredStartCUAddrForEncodingSlice" containing locations of slice boundaries
-    UInt startCUAddrSlice    = 0; // used to keep track of current slice's starting CU addr.
-    pcSlice->setSliceCurStartCUAddr( startCUAddrSlice ); // Setting "start CU addr" for current slice
-    m_storedStartCUAddrForEncodingSlice.clear();
-    
-    UInt startCUAddrSliceSegmentIdx = 0; // used to index "m_uiStoredStartCUAddrForEntropyEncodingSlice" containing locations of slice boundaries
-    UInt startCUAddrSliceSegment    = 0; // used to keep track of current Dependent slice's starting CU addr.
-    pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment ); // Setting "start CU addr" for current Dependent slice
-    
-    m_storedStartCUAddrForEncodingSliceSegment.clear();
-    UInt nextCUAddr = 0;
-    m_storedStartCUAddrForEncodingSlice.push_back (nextCUAddr);
-    startCUAddrSliceIdx++;
-    m_storedStartCUAddrForEncodingSliceSegment.push_back(nextCUAddr);
-    startCUAddrSliceSegmentIdx++;
-    
-    while(nextCUAddr<uiRealEndAddress) // determine slice boundaries
-    {
-      pcSlice->setNextSlice       ( false );
-      pcSlice->setNextSliceSegment( false );
-      assert(pcPic->getNumAllocatedSlice() == startCUAddrSliceIdx);
-      m_pcSliceEncoder->precompressSlice( pcPic );
-      m_pcSliceEncoder->compressSlice   ( pcPic );
-      
-      Bool bNoBinBitConstraintViolated = (!pcSlice->isNextSlice() && !pcSlice->isNextSliceSegment());
-      if (pcSlice->isNextSlice() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceMode()==FIXED_NUMBER_OF_LCU))
-      {
-        startCUAddrSlice = pcSlice->getSliceCurEndCUAddr();
-        // Reconstruction slice
-        m_storedStartCUAddrForEncodingSlice.push_back(startCUAddrSlice);
-        startCUAddrSliceIdx++;
-        // Dependent slice
-        if (startCUAddrSliceSegmentIdx>0 && m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx-1] != startCUAddrSlice)
-        {
-          m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSlice);
-          startCUAddrSliceSegmentIdx++;
-        }
-        
-        if (startCUAddrSlice < uiRealEndAddress)
-        {
-          pcPic->allocateNewSlice();
-          pcPic->setCurrSliceIdx                  ( startCUAddrSliceIdx-1 );
-          m_pcSliceEncoder->setSliceIdx           ( startCUAddrSliceIdx-1 );
-          pcSlice = pcPic->getSlice               ( startCUAddrSliceIdx-1 );
-          pcSlice->copySliceInfo                  ( pcPic->getSlice(0)      );
-          pcSlice->setSliceIdx                    ( startCUAddrSliceIdx-1 );
-          pcSlice->setSliceCurStartCUAddr         ( startCUAddrSlice      );
-          pcSlice->setSliceSegmentCurStartCUAddr  ( startCUAddrSlice      );
-          pcSlice->setSliceBits(0);
-          uiNumSlices ++;
-        }
-      }
-      else if (pcSlice->isNextSliceSegment() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceSegmentMode()==FIXED_NUMBER_OF_LCU))
-      {
-        startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
-        m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSliceSegment);
-        startCUAddrSliceSegmentIdx++;
-        pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment );
-      }
-      else
-      {
-        startCUAddrSlice                                                            = pcSlice->getSliceCurEndCUAddr();
-        startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
-      }
-      
-      nextCUAddr = (startCUAddrSlice > startCUAddrSliceSegment) ? startCUAddrSlice : startCUAddrSliceSegment;
-    }
-    m_storedStartCUAddrForEncodingSlice.push_back( pcSlice->getSliceCurEndCUAddr());
-    startCUAddrSliceIdx++;
-    m_storedStartCUAddrForEncodingSliceSegment.push_back(pcSlice->getSliceCurEndCUAddr());
-    startCUAddrSliceSegmentIdx++;
-    
     pcSlice = pcPic->getSlice(0);
     
     // SAO parameter estimation using non-deblocked pixels for LCU bottom and right boundary areas
@@ -1068,7 +544,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         if ((SOPcurrPOC + deltaPOC) < m_pcCfg->getFramesToBeEncoded())
         {
           SOPcurrPOC += deltaPOC;
-          SOPDescriptionSEI.m_sopDescVclNaluType[i] = getNalUnitType(SOPcurrPOC, m_iLastIDR);
+          SOPDescriptionSEI.m_sopDescVclNaluType[i] = getNalUnitType(SOPcurrPOC, iLastIDR);
           SOPDescriptionSEI.m_sopDescTemporalId[i] = m_pcCfg->getGOPEntry(j).m_temporalId;
           SOPDescriptionSEI.m_sopDescStRpsIdx[i] = m_pcEncTop->getReferencePictureSetIdxForSOP(pcSlice, SOPcurrPOC, j);
           SOPDescriptionSEI.m_sopDescPocDelta[i] = deltaPOC;
@@ -1232,12 +708,9 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     /* use the main bitstream buffer for storing the marshalled picture */
     m_pcEntropyCoder->setBitstream(NULL);
     
-    startCUAddrSliceIdx = 0;
-    startCUAddrSlice    = 0;
-    
-    startCUAddrSliceSegmentIdx = 0;
-    startCUAddrSliceSegment    = 0;
-    nextCUAddr                 = 0;
+    UInt startCUAddrSliceIdx        = 0;
+    UInt startCUAddrSliceSegmentIdx = 0;
+    UInt nextCUAddr                 = 0;
     pcSlice = pcPic->getSlice(startCUAddrSliceIdx);
     
     Int processingState = (pcSlice->getSPS()->getUseSAO())?(EXECUTE_INLOOPFILTER):(ENCODE_SLICE);
@@ -1289,12 +762,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
           UInt uiDummyBoundingCUAddr;
           m_pcSliceEncoder->xDetermineStartAndBoundingCUAddr(uiDummyStartCUAddr,uiDummyBoundingCUAddr,pcPic,true);
           
-          uiInternalAddress = pcPic->getPicSym()->getPicSCUAddr(pcSlice->getSliceSegmentCurEndCUAddr()-1) % pcPic->getNumPartInCU();
-          uiExternalAddress = pcPic->getPicSym()->getPicSCUAddr(pcSlice->getSliceSegmentCurEndCUAddr()-1) / pcPic->getNumPartInCU();
-          uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
-          uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
-          uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
-          uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
+          UInt uiInternalAddress = pcPic->getPicSym()->getPicSCUAddr(pcSlice->getSliceSegmentCurEndCUAddr()-1) % pcPic->getNumPartInCU();
+          UInt uiExternalAddress = pcPic->getPicSym()->getPicSCUAddr(pcSlice->getSliceSegmentCurEndCUAddr()-1) / pcPic->getNumPartInCU();
+          UInt uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
+          UInt uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
+          UInt uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
+          UInt uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
           while(uiPosX>=uiWidth||uiPosY>=uiHeight)
           {
             uiInternalAddress--;
@@ -1510,6 +983,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         case EXECUTE_INLOOPFILTER:
         {
           // set entropy coder for RD
+          m_pcSbacCoder->init( (TEncBinIf*)m_pcBinCABAC );
           m_pcEntropyCoder->setEntropyCoder ( m_pcSbacCoder, pcSlice );
           if ( pcSlice->getSPS()->getUseSAO() )
           {
@@ -1567,27 +1041,28 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     //-- For time output for each slice
     Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
     
+    /* calculate the hash and the SSD of the entire reconstructed picture in one sweep */
+    SEIDecodedPictureHash sei_recon_picture_digest;
+    UInt64 auiSSD[3];
+    calcPicHashSSD(*pcPic->getPicYuvRec(), m_pcCfg->getDecodedPictureHashSEIEnabled(), sei_recon_picture_digest.digest, pcPic->getPicYuvOrg(),
+                   pcPic->getPicYuvRec()->getWidth() - m_pcEncTop->getPad(0), pcPic->getPicYuvRec()->getHeight() - m_pcEncTop->getPad(1), auiSSD);
+
     const Char* digestStr = NULL;
     if (m_pcCfg->getDecodedPictureHashSEIEnabled())
     {
-      /* calculate MD5sum for entire reconstructed picture */
-      SEIDecodedPictureHash sei_recon_picture_digest;
       if(m_pcCfg->getDecodedPictureHashSEIEnabled() == 1)
       {
         sei_recon_picture_digest.method = SEIDecodedPictureHash::MD5;
-        calcMD5(*pcPic->getPicYuvRec(), sei_recon_picture_digest.digest);
         digestStr = digestToString(sei_recon_picture_digest.digest, 16);
       }
       else if(m_pcCfg->getDecodedPictureHashSEIEnabled() == 2)
       {
         sei_recon_picture_digest.method = SEIDecodedPictureHash::CRC;
-        calcCRC(*pcPic->getPicYuvRec(), sei_recon_picture_digest.digest);
         digestStr = digestToString(sei_recon_picture_digest.digest, 2);
       }
       else if(m_pcCfg->getDecodedPictureHashSEIEnabled() == 3)
       {
         sei_recon_picture_digest.method = SEIDecodedPictureHash::CHECKSUM;
-        calcChecksum(*pcPic->getPicYuvRec(), sei_recon_picture_digest.digest);
         digestStr = digestToString(sei_recon_picture_digest.digest, 4);
       }
       OutputNALUnit nalu(NAL_UNIT_SUFFIX_SEI, pcSlice->getTLayer());
@@ -1626,7 +1101,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       accessUnit.insert(it, new NALUnitEBSP(nalu));
     }
     
-    xCalculateAddPSNR( pcPic, pcPic->getPicYuvRec(), accessUnit, dEncTime );
+    xCalculateAddPSNR( pcPic, pcPic->getPicYuvRec(), auiSSD, accessUnit, dEncTime, pcGOPPic->m_bReferenced );
     
     //In case of field coding, compute the interlaced PSNR for both fields
     if (isField && ((!pcPic->isTopField() && isTff) || (pcPic->isTopField() && !isTff)))
@@ -1868,6 +1343,8 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
     
     pcPic->setReconMark   ( true );
+    // a picture prepared before this one was filtered may have extended its borders already
+    pcPic->getPicYuvRec()->setBorderExtension( false );
     m_bFirst = false;
     m_iNumPicCoded++;
     m_totalCoded ++;
@@ -1876,6 +1353,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     fflush(stdout);
     
     delete[] pcSubstreamsOut;
+    delete pcGOPPic;
   }
 #if !RATE_CONTROL_LAMBDA_DOMAIN
   if(m_pcCfg->getUseRateCtrl())
@@ -1891,20 +1369,683 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   assert ( (m_iNumPicCoded == iNumPicRcvd) || (isField && iPOCLast == 1) );
 }
 
-Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, bool isField)
+/** Check whether a prepared picture references one of the pictures of a wave
+ * \param pcGOPPic  prepared picture
+ * \param rcWave    pictures whose slices have not been compressed yet
+ */
+Bool TEncGOP::xReferencesWave( GOPPicture* pcGOPPic, std::vector<GOPPicture*>& rcWave )
 {
-  assert (uiNumAllPicCoded == m_gcAnalyzeAll.getNumPic());
-  
-  
-  //--CFG_KDY
-  if(isField)
-  {
-    m_gcAnalyzeAll.setFrmRate( m_pcCfg->getFrameRate() * 2);
-    m_gcAnalyzeI.setFrmRate( m_pcCfg->getFrameRate() * 2);
-    m_gcAnalyzeP.setFrmRate( m_pcCfg->getFrameRate() * 2);
-    m_gcAnalyzeB.setFrmRate( m_pcCfg->getFrameRate() * 2);
-  }
-  else
+  TComSlice* pcSlice = pcGOPPic->m_pcPic->getSlice(0);
+  for ( UInt uiPic = 0; uiPic < rcWave.size(); uiPic++ )
+  {
+    for ( Int iList = 0; iList < 2; iList++ )
+    {
+      for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( iList ) ); iRefIdx++ )
+      {
+        if ( pcSlice->getRefPic( RefPicList( iList ), iRefIdx ) == rcWave[uiPic]->m_pcPic )
+        {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/** Compress the slices of the pictures of a wave, each one with the slice encoder of its frame slot
+ * \param rcWave  prepared pictures that do not reference each other
+ */
+Void TEncGOP::xCompressWave( std::vector<GOPPicture*>& rcWave )
+{
+  // references are complete now, extend the borders a picture of the wave could not extend when it was prepared
+  for ( UInt uiPic = 0; uiPic < rcWave.size(); uiPic++ )
+  {
+    TComSlice* pcSlice = rcWave[uiPic]->m_pcPic->getSlice(0);
+    for ( Int iList = 0; iList < 2; iList++ )
+    {
+      for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( iList ) ); iRefIdx++ )
+      {
+        pcSlice->getRefPic( RefPicList( iList ), iRefIdx )->getPicYuvRec()->extendPicBorder();
+      }
+    }
+  }
+  
+  cilk_for ( Int iPic = 0; iPic < (Int)rcWave.size(); iPic++ )
+  {
+    xCompressPicture( *rcWave[iPic] );
+  }
+}
+
+/** Set up the slices, reference lists and tiles of the next picture in coding order
+ * \param iGOPid          index of the picture in the GOP structure
+ * \param pcSliceEncoder  slice encoder of the frame slot that will compress the picture
+ * \param rcGOPPic        returns the state needed to compress and write the picture
+ * \returns false if the picture is beyond the number of frames to be encoded
+ */
+Bool TEncGOP::xPreparePicture( Int iPOCLast, Int iNumPicRcvd, Int iGOPid, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, std::list<AccessUnit>& accessUnitsInGOP, Bool isField, TEncSlice* pcSliceEncoder, GOPPicture& rcGOPPic )
+{
+  TComPic*        pcPic;
+  TComPicYuv*     pcPicYuvRecOut;
+  TComSlice*      pcSlice;
+  
+  UInt uiColDir = 1;
+  //-- For time output for each slice
+  long iBeforeTime = clock();
+  
+  //select uiColDir
+  Int iCloseLeft=1, iCloseRight=-1;
+  for(Int i = 0; i<m_pcCfg->getGOPEntry(iGOPid).m_numRefPics; i++)
+  {
+    Int iRef = m_pcCfg->getGOPEntry(iGOPid).m_referencePics[i];
+    if(iRef>0&&(iRef<iCloseRight||iCloseRight==-1))
+    {
+      iCloseRight=iRef;
+    }
+    else if(iRef<0&&(iRef>iCloseLeft||iCloseLeft==1))
+    {
+      iCloseLeft=iRef;
+    }
+  }
+  if(iCloseRight>-1)
+  {
+    iCloseRight=iCloseRight+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
+  }
+  if(iCloseLeft<1)
+  {
+    iCloseLeft=iCloseLeft+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
+    while(iCloseLeft<0)
+    {
+      iCloseLeft+=m_iGopSize;
+    }
+  }
+  Int iLeftQP=0, iRightQP=0;
+  for(Int i=0; i<m_iGopSize; i++)
+  {
+    if(m_pcCfg->getGOPEntry(i).m_POC==(iCloseLeft%m_iGopSize)+1)
+    {
+      iLeftQP= m_pcCfg->getGOPEntry(i).m_QPOffset;
+    }
+    if (m_pcCfg->getGOPEntry(i).m_POC==(iCloseRight%m_iGopSize)+1)
+    {
+      iRightQP=m_pcCfg->getGOPEntry(i).m_QPOffset;
+    }
+  }
+  if(iCloseRight>-1&&iRightQP<iLeftQP)
+  {
+    uiColDir=0;
+  }
+  
+  /////////////////////////////////////////////////////////////////////////////////////////////////// Initial to start encoding
+  Int iTimeOffset;
+  Int pocCurr;
+  
+  if(iPOCLast == 0) //case first frame or first top field
+  {
+    pocCurr=0;
+    iTimeOffset = 1;
+  }
+  else if(iPOCLast == 1 && isField) //case first bottom field, just like the first frame, the poc computation is not right anymore, we set the right value
+  {
+    pocCurr = 1;
+    iTimeOffset = 1;
+  }
+  else
+  {
+    pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - isField;
+    iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
+  }
+  
+  if(pocCurr>=m_pcCfg->getFramesToBeEncoded())
+  {
+    return false;
+  }
+  
+  if( getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
+  {
+    m_iLastIDR = pocCurr;
+  }
+  // start a new access unit: create an entry in the list of output access units
+  accessUnitsInGOP.push_back(AccessUnit());
+  rcGOPPic.m_pcAccessUnit = &accessUnitsInGOP.back();
+  xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField);
+  
+  //  Slice data initialization
+  pcPic->clearSliceBuffer();
+  assert(pcPic->getNumAllocatedSlice() == 1);
+  pcSliceEncoder->setSliceIdx(0);
+  pcPic->setCurrSliceIdx(0);
+  
+  pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iNumPicRcvd, iGOPid, pcSlice, m_pcEncTop->getSPS(), m_pcEncTop->getPPS(), isField );
+  
+  //Set Frame/Field coding
+  pcSlice->getPic()->setField(isField);
+  
+  pcSlice->setLastIDR(m_iLastIDR);
+  pcSlice->setSliceIdx(0);
+  //set default slice level flag to the same as SPS level flag
+  pcSlice->setLFCrossSliceBoundaryFlag(  pcSlice->getPPS()->getLoopFilterAcrossSlicesEnabledFlag()  );
+  pcSlice->setScalingList ( m_pcEncTop->getScalingList()  );
+  if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_OFF)
+  {
+    pcSliceEncoder->getTrQuant()->setFlatScalingList();
+    pcSliceEncoder->getTrQuant()->setUseScalingList(false);
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+  }
+  else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_DEFAULT)
+  {
+    pcSlice->setDefaultScalingList ();
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+    pcSliceEncoder->getTrQuant()->setScalingList(pcSlice->getScalingList());
+    pcSliceEncoder->getTrQuant()->setUseScalingList(true);
+  }
+  else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_FILE_READ)
+  {
+    if(pcSlice->getScalingList()->xParseScalingList(m_pcCfg->getScalingListFile()))
+    {
+      pcSlice->setDefaultScalingList ();
+    }
+    pcSlice->getScalingList()->checkDcOfMatrix();
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(pcSlice->checkDefaultScalingList());
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+    pcSliceEncoder->getTrQuant()->setScalingList(pcSlice->getScalingList());
+    pcSliceEncoder->getTrQuant()->setUseScalingList(true);
+  }
+  else
+  {
+    printf("error : ScalingList == %d no support\n",m_pcEncTop->getUseScalingListId());
+    assert(0);
+  }
+  
+  if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='P')
+  {
+    pcSlice->setSliceType(P_SLICE);
+  }
+  // Set the nal unit type
+  pcSlice->setNalUnitType(getNalUnitType(pocCurr, m_iLastIDR));
+  if(pcSlice->getTemporalLayerNonReferenceFlag())
+  {
+    if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_R &&
+        !(m_iGopSize == 1 && pcSlice->getSliceType() == I_SLICE))
+      // Add this condition to avoid POC issues with encoder_intra_main.cfg configuration (see #1127 in bug tracker)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TRAIL_N);
+    }
+    if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RADL_R)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RADL_N);
+    }
+    if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RASL_R)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RASL_N);
+    }
+  }
+  
+  // Do decoding refresh marking if any
+  pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic);
+  m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
+  pcSlice->getRPS()->setNumberOfLongtermPictures(0);
+  
+#if FIX1071
+  if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0) || (pcSlice->isIRAP()))
+  {
+    pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP());
+  }
+#else
+  if(pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0)
+  {
+    pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS());
+  }
+#endif
+  pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
+  
+  if(pcSlice->getTLayer() > 0)
+  {
+    if(pcSlice->isTemporalLayerSwitchingPoint(rcListPic) || pcSlice->getSPS()->getTemporalIdNestingFlag())
+    {
+      if(pcSlice->getTemporalLayerNonReferenceFlag())
+      {
+        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_N);
+      }
+      else
+      {
+        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TLA_R);
+      }
+    }
+    else if(pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
+    {
+      Bool isSTSA=true;
+      for(Int ii=iGOPid+1;(ii<m_pcCfg->getGOPSize() && isSTSA==true);ii++)
+      {
+        Int lTid= m_pcCfg->getGOPEntry(ii).m_temporalId;
+        if(lTid==pcSlice->getTLayer())
+        {
+          TComReferencePictureSet* nRPS = pcSlice->getSPS()->getRPSList()->getReferencePictureSet(ii);
+          for(Int jj=0;jj<nRPS->getNumberOfPictures();jj++)
+          {
+            if(nRPS->getUsed(jj))
+            {
+              Int tPoc=m_pcCfg->getGOPEntry(ii).m_POC+nRPS->getDeltaPOC(jj);
+              Int kk=0;
+              for(kk=0;kk<m_pcCfg->getGOPSize();kk++)
+              {
+                if(m_pcCfg->getGOPEntry(kk).m_POC==tPoc)
+                  break;
+              }
+              Int tTid=m_pcCfg->getGOPEntry(kk).m_temporalId;
+              if(tTid >= pcSlice->getTLayer())
+              {
+                isSTSA=false;
+                break;
+              }
+            }
+          }
+        }
+      }
+      if(isSTSA==true)
+      {
+        if(pcSlice->getTemporalLayerNonReferenceFlag())
+        {
+          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_N);
+        }
+        else
+        {
+          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_R);
+        }
+      }
+    }
+  }
+  arrangeLongtermPicturesInRPS(pcSlice, rcListPic);
+  TComRefPicListModification* refPicListModification = pcSlice->getRefPicListModification();
+  refPicListModification->setRefPicListModificationFlagL0(0);
+  refPicListModification->setRefPicListModificationFlagL1(0);
+  pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
+  pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
+  
+#if ADAPTIVE_QP_SELECTION
+  pcSlice->setTrQuant( pcSliceEncoder->getTrQuant() );
+#endif
+  
+  //  Set reference list
+  pcSlice->setRefPicList ( rcListPic );
+  
+  //  Slice info. refinement
+  if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
+  {
+    pcSlice->setSliceType ( P_SLICE );
+  }
+  
+  if (pcSlice->getSliceType() == B_SLICE)
+  {
+    pcSlice->setColFromL0Flag(1-uiColDir);
+    Bool bLowDelay = true;
+    Int  iCurrPOC  = pcSlice->getPOC();
+    Int iRefIdx = 0;
+    
+    for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_0) && bLowDelay; iRefIdx++)
+    {
+      if ( pcSlice->getRefPic(REF_PIC_LIST_0, iRefIdx)->getPOC() > iCurrPOC )
+      {
+        bLowDelay = false;
+      }
+    }
+    for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_1) && bLowDelay; iRefIdx++)
+    {
+      if ( pcSlice->getRefPic(REF_PIC_LIST_1, iRefIdx)->getPOC() > iCurrPOC )
+      {
+        bLowDelay = false;
+      }
+    }
+    
+    pcSlice->setCheckLDC(bLowDelay);
+  }
+  else
+  {
+    pcSlice->setCheckLDC(true);
+  }
+  
+  uiColDir = 1-uiColDir;
+  
+  //-------------------------------------------------------------
+  pcSlice->setRefPOCList();
+  
+  pcSlice->setList1IdxToList0Idx();
+  
+  if (m_pcEncTop->getTMVPModeId() == 2)
+  {
+    if (iGOPid == 0) // first picture in SOP (i.e. forward B)
+    {
+      pcSlice->setEnableTMVPFlag(0);
+    }
+    else
+    {
+      // Note: pcSlice->getColFromL0Flag() is assumed to be always 0 and getcolRefIdx() is always 0.
+      pcSlice->setEnableTMVPFlag(1);
+    }
+    pcSlice->getSPS()->setTMVPFlagsPresent(1);
+  }
+  else if (m_pcEncTop->getTMVPModeId() == 1)
+  {
+    pcSlice->getSPS()->setTMVPFlagsPresent(1);
+    pcSlice->setEnableTMVPFlag(1);
+  }
+  else
+  {
+    pcSlice->getSPS()->setTMVPFlagsPresent(0);
+    pcSlice->setEnableTMVPFlag(0);
+  }
+  /////////////////////////////////////////////////////////////////////////////////////////////////// Compress a slice
+  //  Slice compression
+  if (m_pcCfg->getUseASR())
+  {
+    pcSliceEncoder->setSearchRange(pcSlice);
+  }
+  
+  Bool bGPBcheck=false;
+  if ( pcSlice->getSliceType() == B_SLICE)
+  {
+    if ( pcSlice->getNumRefIdx(RefPicList( 0 ) ) == pcSlice->getNumRefIdx(RefPicList( 1 ) ) )
+    {
+      bGPBcheck=true;
+      Int i;
+      for ( i=0; i < pcSlice->getNumRefIdx(RefPicList( 1 ) ); i++ )
+      {
+        if ( pcSlice->getRefPOC(RefPicList(1), i) != pcSlice->getRefPOC(RefPicList(0), i) )
+        {
+          bGPBcheck=false;
+          break;
+        }
+      }
+    }
+  }
+  if(bGPBcheck)
+  {
+    pcSlice->setMvdL1ZeroFlag(true);
+  }
+  else
+  {
+    pcSlice->setMvdL1ZeroFlag(false);
+  }
+  pcPic->getSlice(pcSlice->getSliceIdx())->setMvdL1ZeroFlag(pcSlice->getMvdL1ZeroFlag());
+  
+#if RATE_CONTROL_LAMBDA_DOMAIN
+  Double lambda            = 0.0;
+  Int estimatedBits        = 0;
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
+    if ( pcPic->getSlice(0)->getSliceType() == I_SLICE )
+    {
+      frameLevel = 0;
+    }
+    m_pcRateCtrl->initRCPic( frameLevel );
+    estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
+    
+    Int sliceQP = m_pcCfg->getInitialQP();
+    if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
+    {
+      Int    NumberBFrames = ( m_pcCfg->getGOPSize() - 1 );
+      Double dLambda_scale = 1.0 - Clip3( 0.0, 0.5, 0.05*(Double)NumberBFrames );
+      Double dQPFactor     = 0.57*dLambda_scale;
+      Int    SHIFT_QP      = 12;
+      Int    bitdepth_luma_qp_scale = 0;
+      Double qp_temp = (Double) sliceQP + bitdepth_luma_qp_scale - SHIFT_QP;
+      lambda = dQPFactor*pow( 2.0, qp_temp/3.0 );
+    }
+    else if ( frameLevel == 0 )   // intra case, but use the model
+    {
+#if RATE_CONTROL_INTRA
+      pcSliceEncoder->calCostSliceI(pcPic);
+#endif
+      if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+      {
+        Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
+#if RATE_CONTROL_INTRA
+        bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
+#else
+        bits = m_pcRateCtrl->getRCSeq()->getRefineBitsForIntra( bits );
+#endif
+        if ( bits < 200 )
+        {
+          bits = 200;
+        }
+        m_pcRateCtrl->getRCPic()->setTargetBits( bits );
+      }
+      
+      list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+#if RATE_CONTROL_INTRA
+      m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
+#else
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
+#endif
+      sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
+    }
+    else    // normal case
+    {
+      list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+#if RATE_CONTROL_INTRA
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
+#else
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
+#endif
+      sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
+    }
+    
+    sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffsetY(), MAX_QP, sliceQP );
+    m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
+    
+    pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+  }
+#endif
+  
+  UInt uiInternalAddress = pcPic->getNumPartInCU()-4;
+  UInt uiExternalAddress = pcPic->getPicSym()->getNumberOfCUsInFrame()-1;
+  UInt uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
+  UInt uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
+  UInt uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
+  UInt uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
+  while(uiPosX>=uiWidth||uiPosY>=uiHeight)
+  {
+    uiInternalAddress--;
+    uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
+    uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
+  }
+  uiInternalAddress++;
+  if(uiInternalAddress==pcPic->getNumPartInCU())
+  {
+    uiInternalAddress = 0;
+    uiExternalAddress++;
+  }
+  rcGOPPic.m_uiRealEndAddress = uiExternalAddress*pcPic->getNumPartInCU()+uiInternalAddress;
+  
+  UInt uiCummulativeTileWidth;
+  UInt uiCummulativeTileHeight;
+  Int  p, j;
+  UInt uiEncCUAddr;
+  
+  //set NumColumnsMinus1 and NumRowsMinus1
+  pcPic->getPicSym()->setNumColumnsMinus1( pcSlice->getPPS()->getNumColumnsMinus1() );
+  pcPic->getPicSym()->setNumRowsMinus1( pcSlice->getPPS()->getNumRowsMinus1() );
+  
+  //create the TComTileArray
+  pcPic->getPicSym()->xCreateTComTileArray();
+  
+  if( pcSlice->getPPS()->getUniformSpacingFlag() == 1 )
+  {
+    //set the width for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
+    {
+      for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1()+1; p++)
+      {
+        pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->
+        setTileWidth( (p+1)*pcPic->getPicSym()->getFrameWidthInCU()/(pcPic->getPicSym()->getNumColumnsMinus1()+1)
+                     - (p*pcPic->getPicSym()->getFrameWidthInCU())/(pcPic->getPicSym()->getNumColumnsMinus1()+1) );
+      }
+    }
+    
+    //set the height for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
+    {
+      for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1()+1; p++)
+      {
+        pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->
+        setTileHeight( (p+1)*pcPic->getPicSym()->getFrameHeightInCU()/(pcPic->getPicSym()->getNumRowsMinus1()+1)
+                      - (p*pcPic->getPicSym()->getFrameHeightInCU())/(pcPic->getPicSym()->getNumRowsMinus1()+1) );
+      }
+    }
+  }
+  else
+  {
+    //set the width for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
+    {
+      uiCummulativeTileWidth = 0;
+      for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1(); p++)
+      {
+        pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->setTileWidth( pcSlice->getPPS()->getColumnWidth(p) );
+        uiCummulativeTileWidth += pcSlice->getPPS()->getColumnWidth(p);
+      }
+      pcPic->getPicSym()->getTComTile(j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p)->setTileWidth( pcPic->getPicSym()->getFrameWidthInCU()-uiCummulativeTileWidth );
+    }
+    
+    //set the height for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
+    {
+      uiCummulativeTileHeight = 0;
+      for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1(); p++)
+      {
+        pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->setTileHeight( pcSlice->getPPS()->getRowHeight(p) );
+        uiCummulativeTileHeight += pcSlice->getPPS()->getRowHeight(p);
+      }
+      pcPic->getPicSym()->getTComTile(p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcPic->getPicSym()->getFrameHeightInCU()-uiCummulativeTileHeight );
+    }
+  }
+  //intialize each tile of the current picture
+  pcPic->getPicSym()->xInitTiles();
+  
+  //generate the Coding Order Map and Inverse Coding Order Map
+  for(p=0, uiEncCUAddr=0; p<pcPic->getPicSym()->getNumberOfCUsInFrame(); p++, uiEncCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(uiEncCUAddr))
+  {
+    pcPic->getPicSym()->setCUOrderMap(p, uiEncCUAddr);
+    pcPic->getPicSym()->setInverseCUOrderMap(uiEncCUAddr, p);
+  }
+  pcPic->getPicSym()->setCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
+  pcPic->getPicSym()->setInverseCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
+  
+  rcGOPPic.m_iGOPid         = iGOPid;
+  rcGOPPic.m_pocCurr        = pocCurr;
+  rcGOPPic.m_iBeforeTime    = iBeforeTime;
+  rcGOPPic.m_pcPic          = pcPic;
+  rcGOPPic.m_pcPicYuvRecOut = pcPicYuvRecOut;
+  rcGOPPic.m_pcSliceEncoder = pcSliceEncoder;
+  rcGOPPic.m_uiNumSlices    = 1;
+  rcGOPPic.m_bReferenced    = pcSlice->isReferenced();
+  rcGOPPic.m_iLastIDR       = m_iLastIDR;
+#if RATE_CONTROL_LAMBDA_DOMAIN
+  rcGOPPic.m_dLambda        = lambda;
+  rcGOPPic.m_iEstimatedBits = estimatedBits;
+#endif
+  return true;
+}
+
+/** Determine the slice boundaries of a prepared picture and compress its slices
+ * \param rcGOPPic  picture prepared by xPreparePicture, compressed with the slice encoder of its frame slot
+ */
+Void TEncGOP::xCompressPicture( GOPPicture& rcGOPPic )
+{
+  TComPic*   pcPic          = rcGOPPic.m_pcPic;
+  TEncSlice* pcSliceEncoder = rcGOPPic.m_pcSliceEncoder;
+  TComSlice* pcSlice        = pcPic->getSlice(0);
+  
+  UInt startCUAddrSliceIdx = 0; // used to index "m_uiStoredStartCUAddrForEncodingSlice" containing locations of slice boundaries
+  UInt startCUAddrSlice    = 0; // used to keep track of current slice's starting CU addr.
+  pcSlice->setSliceCurStartCUAddr( startCUAddrSlice ); // Setting "start CU addr" for current slice
+  rcGOPPic.m_storedStartCUAddrForEncodingSlice.clear();
+  
+  UInt startCUAddrSliceSegmentIdx = 0; // used to index "m_uiStoredStartCUAddrForEntropyEncodingSlice" containing locations of slice boundaries
+  UInt startCUAddrSliceSegment    = 0; // used to keep track of current Dependent slice's starting CU addr.
+  pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment ); // Setting "start CU addr" for current Dependent slice
+  
+  rcGOPPic.m_storedStartCUAddrForEncodingSliceSegment.clear();
+  UInt nextCUAddr = 0;
+  rcGOPPic.m_storedStartCUAddrForEncodingSlice.push_back (nextCUAddr);
+  startCUAddrSliceIdx++;
+  rcGOPPic.m_storedStartCUAddrForEncodingSliceSegment.push_back(nextCUAddr);
+  startCUAddrSliceSegmentIdx++;
+  
+  while(nextCUAddr<rcGOPPic.m_uiRealEndAddress) // determine slice boundaries
+  {
+    pcSlice->setNextSlice       ( false );
+    pcSlice->setNextSliceSegment( false );
+    assert(pcPic->getNumAllocatedSlice() == startCUAddrSliceIdx);
+    pcSliceEncoder->precompressSlice( pcPic );
+    pcSliceEncoder->compressSlice   ( pcPic );
+    
+    Bool bNoBinBitConstraintViolated = (!pcSlice->isNextSlice() && !pcSlice->isNextSliceSegment());
+    if (pcSlice->isNextSlice() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceMode()==FIXED_NUMBER_OF_LCU))
+    {
+      startCUAddrSlice = pcSlice->getSliceCurEndCUAddr();
+      // Reconstruction slice
+      rcGOPPic.m_storedStartCUAddrForEncodingSlice.push_back(startCUAddrSlice);
+      startCUAddrSliceIdx++;
+      // Dependent slice
+      if (startCUAddrSliceSegmentIdx>0 && rcGOPPic.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx-1] != startCUAddrSlice)
+      {
+        rcGOPPic.m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSlice);
+        startCUAddrSliceSegmentIdx++;
+      }
+      
+      if (startCUAddrSlice < rcGOPPic.m_uiRealEndAddress)
+      {
+        pcPic->allocateNewSlice();
+        pcPic->setCurrSliceIdx                  ( startCUAddrSliceIdx-1 );
+        pcSliceEncoder->setSliceIdx             ( startCUAddrSliceIdx-1 );
+        pcSlice = pcPic->getSlice               ( startCUAddrSliceIdx-1 );
+        pcSlice->copySliceInfo                  ( pcPic->getSlice(0)      );
+        pcSlice->setSliceIdx                    ( startCUAddrSliceIdx-1 );
+        pcSlice->setSliceCurStartCUAddr         ( startCUAddrSlice      );
+        pcSlice->setSliceSegmentCurStartCUAddr  ( startCUAddrSlice      );
+        pcSlice->setSliceBits(0);
+        rcGOPPic.m_uiNumSlices++;
+      }
+    }
+    else if (pcSlice->isNextSliceSegment() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceSegmentMode()==FIXED_NUMBER_OF_LCU))
+    {
+      startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
+      rcGOPPic.m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSliceSegment);
+      startCUAddrSliceSegmentIdx++;
+      pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment );
+    }
+    else
+    {
+      startCUAddrSlice                                                            = pcSlice->getSliceCurEndCUAddr();
+      startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
+    }
+    
+    nextCUAddr = (startCUAddrSlice > startCUAddrSliceSegment) ? startCUAddrSlice : startCUAddrSliceSegment;
+  }
+  rcGOPPic.m_storedStartCUAddrForEncodingSlice.push_back( pcSlice->getSliceCurEndCUAddr());
+  startCUAddrSliceIdx++;
+  rcGOPPic.m_storedStartCUAddrForEncodingSliceSegment.push_back(pcSlice->getSliceCurEndCUAddr());
+  startCUAddrSliceSegmentIdx++;
+}
+
+Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, bool isField)
+{
+  assert (uiNumAllPicCoded == m_gcAnalyzeAll.getNumPic());
+  
+  
+  //--CFG_KDY
+  if(isField)
+  {
+    m_gcAnalyzeAll.setFrmRate( m_pcCfg->getFrameRate() * 2);
+    m_gcAnalyzeI.setFrmRate( m_pcCfg->getFrameRate() * 2);
+    m_gcAnalyzeP.setFrmRate( m_pcCfg->getFrameRate() * 2);
+    m_gcAnalyzeB.setFrmRate( m_pcCfg->getFrameRate() * 2);
+  }
+  else
   {
     m_gcAnalyzeAll.setFrmRate( m_pcCfg->getFrameRate() );
     m_gcAnalyzeI.setFrmRate( m_pcCfg->getFrameRate() );
@@ -2167,72 +2308,30 @@ static const Char* nalUnitTypeToString(NalUnitType type)
 }
 #endif
 
-Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit& accessUnit, Double dEncTime )
+/** Add the PSNR of a picture to the statistics and print its results
+ * \param pcPic picture
+ * \param pcPicD reconstructed picture
+ * \param auiSSD sum of squared differences of the planes, computed with the picture hash
+ * \param accessUnit access unit of the picture
+ * \param dEncTime encoding time
+ * \param bReferenced the picture is referenced
+ */
+Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const UInt64 auiSSD[3], const AccessUnit& accessUnit, Double dEncTime, Bool bReferenced )
 {
-  Int     x, y;
-  UInt64 uiSSDY  = 0;
-  UInt64 uiSSDU  = 0;
-  UInt64 uiSSDV  = 0;
+  UInt64 uiSSDY  = auiSSD[0];
+  UInt64 uiSSDU  = auiSSD[1];
+  UInt64 uiSSDV  = auiSSD[2];
   
   Double  dYPSNR  = 0.0;
   Double  dUPSNR  = 0.0;
   Double  dVPSNR  = 0.0;
   
   //===== calculate PSNR =====
-  Pel*  pOrg    = pcPic ->getPicYuvOrg()->getLumaAddr();
-  Pel*  pRec    = pcPicD->getLumaAddr();
-  Int   iStride = pcPicD->getStride();
-  
-  Int   iWidth;
-  Int   iHeight;
-  
-  iWidth  = pcPicD->getWidth () - m_pcEncTop->getPad(0);
-  iHeight = pcPicD->getHeight() - m_pcEncTop->getPad(1);
+  Int   iWidth  = pcPicD->getWidth () - m_pcEncTop->getPad(0);
+  Int   iHeight = pcPicD->getHeight() - m_pcEncTop->getPad(1);
   
   Int   iSize   = iWidth*iHeight;
   
-  for( y = 0; y < iHeight; y++ )
-  {
-    for( x = 0; x < iWidth; x++ )
-    {
-      Int iDiff = (Int)( pOrg[x] - pRec[x] );
-      uiSSDY   += iDiff * iDiff;
-    }
-    pOrg += iStride;
-    pRec += iStride;
-  }
-  
-  iHeight >>= 1;
-  iWidth  >>= 1;
-  iStride >>= 1;
-  pOrg  = pcPic ->getPicYuvOrg()->getCbAddr();
-  pRec  = pcPicD->getCbAddr();
-  
-  for( y = 0; y < iHeight; y++ )
-  {
-    for( x = 0; x < iWidth; x++ )
-    {
-      Int iDiff = (Int)( pOrg[x] - pRec[x] );
-      uiSSDU   += iDiff * iDiff;
-    }
-    pOrg += iStride;
-    pRec += iStride;
-  }
-  
-  pOrg  = pcPic ->getPicYuvOrg()->getCrAddr();
-  pRec  = pcPicD->getCrAddr();
-  
-  for( y = 0; y < iHeight; y++ )
-  {
-    for( x = 0; x < iWidth; x++ )
-    {
-      Int iDiff = (Int)( pOrg[x] - pRec[x] );
-      uiSSDV   += iDiff * iDiff;
-    }
-    pOrg += iStride;
-    pRec += iStride;
-  }
-  
   Int maxvalY = 255 << (g_bitDepthY-8);
   Int maxvalC = 255 << (g_bitDepthC-8);
   Double fRefValueY = (Double) maxvalY * maxvalY * iSize;
@@ -2278,7 +2377,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
   }
 
   Char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced()) c += 32;
+  if (!bReferenced) c += 32;
 
 #if ADAPTIVE_QP_SELECTION
   printf("POC %4d TId: %1d ( %c-SLICE, nQP %d QP %d ) %10d bits",
@@ -67,6 +67,28 @@ class TEncTop;
 // Class definition
 // ====================================================================================================================
 
+/// state of a picture between its preparation and the writing of its access unit
+struct GOPPicture
+{
+  Int               m_iGOPid;
+  Int               m_pocCurr;
+  long              m_iBeforeTime;                              ///< for time output of the picture
+  TComPic*          m_pcPic;
+  TComPicYuv*       m_pcPicYuvRecOut;
+  AccessUnit*       m_pcAccessUnit;
+  TEncSlice*        m_pcSliceEncoder;                           ///< slice encoder of the frame slot
+  UInt              m_uiNumSlices;
+  UInt              m_uiRealEndAddress;
+  Bool              m_bReferenced;                              ///< reference marking when prepared, later pictures of the wave may change it
+  Int               m_iLastIDR;                                 ///< POC of the last IDR when prepared, a later IDR of the wave changes m_iLastIDR
+  std::vector<Int>  m_storedStartCUAddrForEncodingSlice;
+  std::vector<Int>  m_storedStartCUAddrForEncodingSliceSegment;
+#if RATE_CONTROL_LAMBDA_DOMAIN
+  Double            m_dLambda;
+  Int               m_iEstimatedBits;
+#endif
+};
+
 /// GOP encoder class
 class TEncGOP
 {
@@ -151,7 +173,12 @@ protected:
   Void  xInitGOP          ( Int iPOC, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, bool isField );
   
-  Void  xCalculateAddPSNR ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime );
+  Bool  xPreparePicture   ( Int iPOCLast, Int iNumPicRcvd, Int iGOPid, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, std::list<AccessUnit>& accessUnitsInGOP, Bool isField, TEncSlice* pcSliceEncoder, GOPPicture& rcGOPPic );
+  Bool  xReferencesWave   ( GOPPicture* pcGOPPic, std::vector<GOPPicture*>& rcWave );
+  Void  xCompressWave     ( std::vector<GOPPicture*>& rcWave );
+  Void  xCompressPicture  ( GOPPicture& rcGOPPic );
+  
+  Void  xCalculateAddPSNR ( TComPic* pcPic, TComPicYuv* pcPicD, const UInt64 auiSSD[3], const AccessUnit&, Double dEncTime, Bool bReferenced );
   Void  xCalculateInterlacedAddPSNR( TComPic* pcPicOrgTop, TComPic* pcPicOrgBottom, TComPicYuv* pcPicRecTop, TComPicYuv* pcPicRecBottom, const AccessUnit& accessUnit, Double dEncTime );
   
   UInt64 xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1);
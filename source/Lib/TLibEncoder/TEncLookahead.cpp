@@ -0,0 +1,259 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncLookahead.cpp
+    \brief    background analysis of source pictures ahead of encoding
+*/
+
+#include <cmath>
+#include <algorithm>
+
+#include "TEncLookahead.h"
+
+using namespace std;
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define LOOKAHEAD_BLK_SIZE  8   ///< size of the luma blocks of the complexity and temporal difference metrics
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncLookahead::TEncLookahead()
+: m_pcPreanalyzer(NULL)
+, m_iDepth(0)
+, m_iNumPending(0)
+, m_bExit(false)
+, m_bRunning(false)
+, m_uiNumBlkInWidth(0)
+, m_uiNumBlkInHeight(0)
+, m_pdBlkMean(NULL)
+, m_bHasPrevPic(false)
+{
+}
+
+TEncLookahead::~TEncLookahead()
+{
+  destroy();
+}
+
+/** allocate the metric buffers and start the analysis thread, pictures are analyzed inline if it cannot be started
+ * \param iWidth source picture width
+ * \param iHeight source picture height
+ * \param iDepth maximum number of pictures waiting for analysis
+ * \param pcPreanalyzer adaptive QP analyzer, NULL if adaptive QP is off
+ */
+Void TEncLookahead::create( Int iWidth, Int iHeight, Int iDepth, TEncPreanalyzer* pcPreanalyzer )
+{
+  m_pcPreanalyzer    = pcPreanalyzer;
+  m_iDepth           = iDepth;
+  m_iNumPending      = 0;
+  m_bExit            = false;
+  m_uiNumBlkInWidth  = ( iWidth  + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE;
+  m_uiNumBlkInHeight = ( iHeight + LOOKAHEAD_BLK_SIZE - 1 ) / LOOKAHEAD_BLK_SIZE;
+  m_pdBlkMean        = new Double[ m_uiNumBlkInWidth * m_uiNumBlkInHeight ];
+  m_bHasPrevPic      = false;
+
+  pthread_mutex_init( &m_mutex, NULL );
+  pthread_cond_init( &m_condPic, NULL );
+  pthread_cond_init( &m_condDone, NULL );
+  m_bRunning = ( pthread_create( &m_thread, NULL, xThreadMain, this ) == 0 );
+}
+
+/** analyze the queued pictures, stop the analysis thread and free the metric buffers
+ */
+Void TEncLookahead::destroy()
+{
+  if ( m_pdBlkMean == NULL )
+  {
+    return;
+  }
+
+  if ( m_bRunning )
+  {
+    pthread_mutex_lock( &m_mutex );
+    m_bExit = true;
+    pthread_cond_signal( &m_condPic );
+    pthread_mutex_unlock( &m_mutex );
+    pthread_join( m_thread, NULL );
+    m_bRunning = false;
+  }
+  pthread_cond_destroy( &m_condDone );
+  pthread_cond_destroy( &m_condPic );
+  pthread_mutex_destroy( &m_mutex );
+
+  delete[] m_pdBlkMean;
+  m_pdBlkMean = NULL;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** queue a picture for analysis, the source samples must not change until the picture has been analyzed
+ * \param pcPic picture to be analyzed
+ */
+Void TEncLookahead::push( TEncPic* pcPic )
+{
+  if ( !m_bRunning )
+  {
+    xAnalyze( pcPic );
+    return;
+  }
+
+  pthread_mutex_lock( &m_mutex );
+  while ( m_iNumPending >= m_iDepth )
+  {
+    pthread_cond_wait( &m_condDone, &m_mutex );
+  }
+  m_cListPic.pushBack( pcPic );
+  m_iNumPending++;
+  pthread_cond_signal( &m_condPic );
+  pthread_mutex_unlock( &m_mutex );
+}
+
+/** wait until all queued pictures are analyzed, called before the pictures are handed to the GOP encoder
+ */
+Void TEncLookahead::flush()
+{
+  if ( !m_bRunning )
+  {
+    return;
+  }
+
+  pthread_mutex_lock( &m_mutex );
+  while ( m_iNumPending > 0 )
+  {
+    pthread_cond_wait( &m_condDone, &m_mutex );
+  }
+  pthread_mutex_unlock( &m_mutex );
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void* TEncLookahead::xThreadMain( Void* pArg )
+{
+  static_cast<TEncLookahead*>( pArg )->xRun();
+  return NULL;
+}
+
+/** analysis loop, runs until it is asked to terminate and the queue is empty
+ */
+Void TEncLookahead::xRun()
+{
+  pthread_mutex_lock( &m_mutex );
+  while ( true )
+  {
+    while ( m_cListPic.empty() && !m_bExit )
+    {
+      pthread_cond_wait( &m_condPic, &m_mutex );
+    }
+    if ( m_cListPic.empty() )
+    {
+      break;
+    }
+    TEncPic* pcPic = m_cListPic.popFront();
+    pthread_mutex_unlock( &m_mutex );
+
+    xAnalyze( pcPic );
+
+    pthread_mutex_lock( &m_mutex );
+    m_iNumPending--;
+    pthread_cond_broadcast( &m_condDone );
+  }
+  pthread_mutex_unlock( &m_mutex );
+}
+
+/** compute the adaptive QP activity and the complexity metrics of a picture, pictures are analyzed in input order
+ * \param pcPic picture to be analyzed
+ */
+Void TEncLookahead::xAnalyze( TEncPic* pcPic )
+{
+  if ( m_pcPreanalyzer )
+  {
+    m_pcPreanalyzer->xPreanalyze( pcPic );
+  }
+
+  TComPicYuv* pcPicYuv = pcPic->getPicYuvOrg();
+  const Int iWidth  = pcPicYuv->getWidth();
+  const Int iHeight = pcPicYuv->getHeight();
+  const Int iStride = pcPicYuv->getStride();
+  const Pel* pLineY = pcPicYuv->getLumaAddr();
+
+  // average block variance and mean absolute change of the block means to the previous picture
+  Double  dSumVar   = 0.0;
+  Double  dSumDiff  = 0.0;
+  Double* pdBlkMean = m_pdBlkMean;
+  for ( Int y = 0; y < iHeight; y += LOOKAHEAD_BLK_SIZE )
+  {
+    const Int iBlkHeight = min( LOOKAHEAD_BLK_SIZE, iHeight-y );
+    for ( Int x = 0; x < iWidth; x += LOOKAHEAD_BLK_SIZE, pdBlkMean++ )
+    {
+      const Int iBlkWidth = min( LOOKAHEAD_BLK_SIZE, iWidth-x );
+      const Pel* pBlkY = &pLineY[x];
+      UInt64 uiSum   = 0;
+      UInt64 uiSumSq = 0;
+      for ( Int by = 0; by < iBlkHeight; by++ )
+      {
+        for ( Int bx = 0; bx < iBlkWidth; bx++ )
+        {
+          uiSum   += pBlkY[bx];
+          uiSumSq += pBlkY[bx] * pBlkY[bx];
+        }
+        pBlkY += iStride;
+      }
+
+      const Int    iNumPix = iBlkWidth * iBlkHeight;
+      const Double dMean   = Double(uiSum) / iNumPix;
+      dSumVar += Double(uiSumSq) / iNumPix - dMean * dMean;
+      if ( m_bHasPrevPic )
+      {
+        dSumDiff += fabs( dMean - *pdBlkMean );
+      }
+      *pdBlkMean = dMean;
+    }
+    pLineY += iStride * iBlkHeight;
+  }
+
+  const Double dNumBlk = m_uiNumBlkInWidth * m_uiNumBlkInHeight;
+  pcPic->setSpatialActivity( dSumVar / dNumBlk );
+  pcPic->setTemporalDifference( dSumDiff / dNumBlk );
+  m_bHasPrevPic = true;
+}
+
+//! \}
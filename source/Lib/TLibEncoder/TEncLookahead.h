@@ -0,0 +1,96 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncLookahead.h
+    \brief    background analysis of source pictures ahead of encoding (header)
+*/
+
+#ifndef __TENCLOOKAHEAD__
+#define __TENCLOOKAHEAD__
+
+// Include files
+#include <pthread.h>
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComList.h"
+#include "TEncPic.h"
+#include "TEncPreanalyzer.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// analyzes the received source pictures on a background thread while the caller delivers the next ones
+class TEncLookahead
+{
+private:
+  TEncPreanalyzer*        m_pcPreanalyzer;                ///< adaptive QP analyzer, NULL if adaptive QP is off
+  Int                     m_iDepth;                       ///< maximum number of pictures waiting for analysis
+  TComList<TEncPic*>      m_cListPic;                     ///< pictures waiting for analysis, in input order
+  Int                     m_iNumPending;                  ///< pictures queued or being analyzed
+  Bool                    m_bExit;                        ///< thread is asked to terminate
+  Bool                    m_bRunning;                     ///< thread has been started
+
+  UInt                    m_uiNumBlkInWidth;              ///< number of analysis blocks in a row
+  UInt                    m_uiNumBlkInHeight;             ///< number of analysis blocks in a column
+  Double*                 m_pdBlkMean;                    ///< luma mean of each block of the last analyzed picture
+  Bool                    m_bHasPrevPic;                  ///< m_pdBlkMean holds a previous picture
+
+  pthread_t               m_thread;
+  pthread_mutex_t         m_mutex;
+  pthread_cond_t          m_condPic;                      ///< a picture was queued or the thread is asked to terminate
+  pthread_cond_t          m_condDone;                     ///< a picture has been analyzed
+
+  static Void*  xThreadMain         ( Void* pArg );
+  Void          xRun                ();
+  Void          xAnalyze            ( TEncPic* pcPic );
+
+public:
+  TEncLookahead();
+  virtual ~TEncLookahead();
+
+  Void    create              ( Int iWidth, Int iHeight, Int iDepth, TEncPreanalyzer* pcPreanalyzer );
+  Void    destroy             ();
+
+  /// queue a picture whose source samples are complete, blocks while the lookahead is full
+  Void    push                ( TEncPic* pcPic );
+  /// wait until all queued pictures are analyzed
+  Void    flush               ();
+};
+
+//! \}
+
+#endif // __TENCLOOKAHEAD__
@@ -105,6 +105,8 @@ Void TEncPicQPAdaptationLayer::destroy()
 TEncPic::TEncPic()
 : m_acAQLayer(NULL)
 , m_uiMaxAQDepth(0)
+, m_dSpatialActivity(0.0)
+, m_dTemporalDifference(0.0)
 {
 }
 
@@ -97,6 +97,8 @@ class TEncPic : public TComPic
 private:
   TEncPicQPAdaptationLayer* m_acAQLayer;
   UInt                      m_uiMaxAQDepth;
+  Double                    m_dSpatialActivity;     ///< average luma block variance, set by the lookahead
+  Double                    m_dTemporalDifference;  ///< mean absolute change of the luma block means to the previous source picture, set by the lookahead
 
 public:
   TEncPic();
@@ -108,6 +110,11 @@ public:
 
   TEncPicQPAdaptationLayer* getAQLayer( UInt uiDepth )  { return &m_acAQLayer[uiDepth]; }
   UInt                      getMaxAQDepth()             { return m_uiMaxAQDepth;        }
+
+  Double                    getSpatialActivity()        { return m_dSpatialActivity;    }
+  Double                    getTemporalDifference()     { return m_dTemporalDifference; }
+  Void                      setSpatialActivity( Double d )    { m_dSpatialActivity = d;    }
+  Void                      setTemporalDifference( Double d ) { m_dTemporalDifference = d; }
 };
 
 //! \}
@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <cilk/cilk.h>
 
 //! \ingroup TLibEncoder
 //! \{
@@ -53,6 +54,8 @@ TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
   m_iCount = NULL;     
   m_iOffset = NULL;      
   m_iOffsetOrg = NULL;  
+  m_countLcu = NULL;
+  m_offsetOrgLcu = NULL;
   m_iRate = NULL;       
   m_iDist = NULL;        
   m_dCost = NULL;        
@@ -530,6 +533,14 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
         {
           delete [] m_offsetOrg_PreDblk[i][j][k];
         }
+        if (m_countLcu [i][j][k])
+        {
+          delete [] m_countLcu [i][j][k]; 
+        }
+        if (m_offsetOrgLcu[i][j][k])
+        {
+          delete [] m_offsetOrgLcu[i][j][k];
+        }
       }
       if (m_count_PreDblk [i][j])
       {
@@ -539,6 +550,14 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
       {
         delete [] m_offsetOrg_PreDblk[i][j]; 
       }
+      if (m_countLcu [i][j])
+      {
+        delete [] m_countLcu [i][j]; 
+      }
+      if (m_offsetOrgLcu[i][j])
+      {
+        delete [] m_offsetOrgLcu[i][j]; 
+      }
     }
     if (m_count_PreDblk [i])
     {
@@ -548,6 +567,14 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
     {
       delete [] m_offsetOrg_PreDblk[i]; 
     }
+    if (m_countLcu [i])
+    {
+      delete [] m_countLcu [i]; 
+    }
+    if (m_offsetOrgLcu[i])
+    {
+      delete [] m_offsetOrgLcu[i]; 
+    }
   }
   if (m_count_PreDblk)
   {
@@ -557,6 +584,14 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
   {
     delete [] m_offsetOrg_PreDblk ; m_offsetOrg_PreDblk = NULL;
   }
+  if (m_countLcu)
+  {
+    delete [] m_countLcu  ; m_countLcu = NULL;
+  }
+  if (m_offsetOrgLcu)
+  {
+    delete [] m_offsetOrgLcu ; m_offsetOrgLcu = NULL;
+  }
 
   Int iMaxDepth = 4;
   Int iDepth;
@@ -616,20 +651,28 @@ Void TEncSampleAdaptiveOffset::createEncBuffer()
   Int numLcu = m_iNumCuInWidth * m_iNumCuInHeight;
   m_count_PreDblk  = new Int64 ***[numLcu];
   m_offsetOrg_PreDblk = new Int64 ***[numLcu];
+  m_countLcu  = new Int64 ***[numLcu];
+  m_offsetOrgLcu = new Int64 ***[numLcu];
   for (Int i=0; i<numLcu; i++)
   {
     m_count_PreDblk[i]  = new Int64 **[3];
     m_offsetOrg_PreDblk[i] = new Int64 **[3];
+    m_countLcu[i]  = new Int64 **[3];
+    m_offsetOrgLcu[i] = new Int64 **[3];
 
     for (Int j=0;j<3;j++)
     {
       m_count_PreDblk [i][j] = new Int64 *[MAX_NUM_SAO_TYPE]; 
       m_offsetOrg_PreDblk[i][j] = new Int64 *[MAX_NUM_SAO_TYPE]; 
+      m_countLcu [i][j] = new Int64 *[MAX_NUM_SAO_TYPE]; 
+      m_offsetOrgLcu[i][j] = new Int64 *[MAX_NUM_SAO_TYPE]; 
 
       for (Int k=0;k<MAX_NUM_SAO_TYPE;k++)
       {
         m_count_PreDblk [i][j][k]   = new Int64 [MAX_NUM_SAO_CLASS]; 
         m_offsetOrg_PreDblk[i][j][k]= new Int64 [MAX_NUM_SAO_CLASS]; 
+        m_countLcu [i][j][k]   = new Int64 [MAX_NUM_SAO_CLASS]; 
+        m_offsetOrgLcu[i][j][k]= new Int64 [MAX_NUM_SAO_CLASS]; 
       }
     }
   }
@@ -718,6 +761,11 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   UInt edgeType;
   Int x, y;
   Pel *pTableBo = (iYCbCr==0)?m_lumaTableBo:m_chromaTableBo;
+  Int aiUpBuff1[MAX_CU_SIZE+2];
+  Int aiUpBufft[MAX_CU_SIZE+2];
+  Int *upBuff1 = &aiUpBuff1[1];
+  Int *upBufft = &aiUpBufft[1];
+  Int *swapBuff;
 
   //--------- Band offset-----------//
   stats = ppStats[SAO_BO];
@@ -779,15 +827,15 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
 
   for (x=0; x< width; x++)
   {
-    m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
+    upBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
   }
   for (y=startY; y<endY; y++)
   {
     for (x=0; x< width; x++)
     {
       signDown     =  xSign(pRec[x] - pRec[x+stride]); 
-      edgeType    =  signDown + m_iUpBuff1[x] + 2;
-      m_iUpBuff1[x] = -signDown;
+      edgeType    =  signDown + upBuff1[x] + 2;
+      upBuff1[x] = -signDown;
 
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
@@ -810,7 +858,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   pRec += stride;
   for (x=startX; x< endX+1; x++)
   {
-    m_iUpBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
+    upBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
   }
 
   //1st line
@@ -818,7 +866,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_TL])
   {
     x= 0;
-    edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - m_iUpBuff1[x+1] + 2;
+    edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - upBuff1[x+1] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
   }
@@ -826,7 +874,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= 1; x< endX; x++)
     {
-      edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - m_iUpBuff1[x+1] + 2;
+      edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - upBuff1[x+1] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -840,17 +888,17 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
     for (x=startX; x<endX; x++)
     {
       signDown1      =  xSign(pRec[x] - pRec[x+ posShift]) ;
-      edgeType      =  signDown1 + m_iUpBuff1[x] + 2;
+      edgeType      =  signDown1 + upBuff1[x] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
 
-      m_iUpBufft[x+1] = -signDown1; 
+      upBufft[x+1] = -signDown1; 
     }
-    m_iUpBufft[startX] = xSign(pRec[stride+startX] - pRec[startX-1]);
+    upBufft[startX] = xSign(pRec[stride+startX] - pRec[startX-1]);
 
-    ipSwap     = m_iUpBuff1;
-    m_iUpBuff1 = m_iUpBufft;
-    m_iUpBufft = ipSwap;
+    swapBuff     = upBuff1;
+    upBuff1 = upBufft;
+    upBufft = swapBuff;
 
     pRec  += stride;
     pOrg  += stride;
@@ -861,7 +909,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= startX; x< width-1; x++)
     {
-      edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+      edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -869,7 +917,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_BR])
   {
     x= width -1;
-    edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+    edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
   }
@@ -889,7 +937,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   pRec += stride;
   for (x=startX-1; x< endX; x++)
   {
-    m_iUpBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
+    upBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
   }
 
 
@@ -899,7 +947,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= startX; x< width -1; x++)
     {
-      edgeType = xSign(pRec[x] - pRec[x- posShift]) -m_iUpBuff1[x-1] + 2;
+      edgeType = xSign(pRec[x] - pRec[x- posShift]) -upBuff1[x-1] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -907,7 +955,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_TR])
   {
     x= width-1;
-    edgeType = xSign(pRec[x] - pRec[x- posShift]) -m_iUpBuff1[x-1] + 2;
+    edgeType = xSign(pRec[x] - pRec[x- posShift]) -upBuff1[x-1] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
   }
@@ -920,14 +968,14 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
     for(x= startX; x< endX; x++)
     {
       signDown1      =  xSign(pRec[x] - pRec[x+ posShift]) ;
-      edgeType      =  signDown1 + m_iUpBuff1[x] + 2;
+      edgeType      =  signDown1 + upBuff1[x] + 2;
 
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
-      m_iUpBuff1[x-1] = -signDown1; 
+      upBuff1[x-1] = -signDown1; 
 
     }
-    m_iUpBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
+    upBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
 
     pRec  += stride;
     pOrg  += stride;
@@ -937,7 +985,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_BL])
   {
     x= 0;
-    edgeType = xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+    edgeType = xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
 
@@ -946,7 +994,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= 1; x< endX; x++)
     {
-      edgeType = xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+      edgeType = xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -957,16 +1005,24 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
  * \param  iAddr,  iPartIdx,  iYCbCr
  */
 Void TEncSampleAdaptiveOffset::calcSaoStatsCu(Int iAddr, Int iPartIdx, Int iYCbCr)
+{
+  calcSaoStatsCu(iAddr, iYCbCr, m_iOffsetOrg[iPartIdx], m_iCount[iPartIdx]);
+}
+
+/** Calculate SAO statistics for current LCU, LCUs may be processed concurrently
+ * \param  iAddr LCU address
+ * \param  iYCbCr color component index
+ * \param  ppStats statistics buffer
+ * \param  ppCount counter buffer
+ */
+Void TEncSampleAdaptiveOffset::calcSaoStatsCu(Int iAddr, Int iYCbCr, Int64** ppStats, Int64** ppCount)
 {
   if(!m_bUseNIF)
   {
-    calcSaoStatsCuOrg( iAddr, iPartIdx, iYCbCr);
+    calcSaoStatsCuOrg( iAddr, iYCbCr, ppStats, ppCount);
   }
   else
   {
-    Int64** ppStats = m_iOffsetOrg[iPartIdx];
-    Int64** ppCount = m_iCount    [iPartIdx];
-
     //parameters
     Int  isChroma = (iYCbCr != 0)? 1:0;
     Int  stride   = (iYCbCr != 0)?(m_pcPic->getCStride()):(m_pcPic->getStride());
@@ -997,9 +1053,9 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCu(Int iAddr, Int iPartIdx, Int iYCbC
 }
 
 /** Calculate SAO statistics for current LCU without non-crossing slice
- * \param  iAddr,  iPartIdx,  iYCbCr
+ * \param  iAddr,  iYCbCr,  ppStats,  ppCount
  */
-Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iYCbCr)
+Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iYCbCr, Int64** ppStats, Int64** ppCount)
 {
   Int x,y;
   TComDataCU *pTmpCu = m_pcPic->getCU(iAddr);
@@ -1024,6 +1080,11 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
   Int iEndX;
   Int iEndY;
   Pel* pTableBo = (iYCbCr==0)?m_lumaTableBo:m_chromaTableBo;
+  Int  aiUpBuff1[MAX_CU_SIZE+2];
+  Int  aiUpBufft[MAX_CU_SIZE+2];
+  Int* upBuff1 = &aiUpBuff1[1];
+  Int* upBufft = &aiUpBufft[1];
+  Int* swapBuff;
 
   Int iIsChroma = (iYCbCr!=0)? 1:0;
   Int numSkipLine = iIsChroma? 2:4;
@@ -1060,8 +1121,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
       numSkipLine = iIsChroma? 1:3;
       numSkipLineRight = iIsChroma? 2:4;
     }
-    iStats = m_iOffsetOrg[iPartIdx][SAO_BO];
-    iCount = m_iCount    [iPartIdx][SAO_BO];
+    iStats = ppStats[SAO_BO];
+    iCount = ppCount[SAO_BO];
 
     pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
     pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1101,8 +1162,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
         numSkipLine = iIsChroma? 1:3;
         numSkipLineRight = iIsChroma? 3:5;
       }
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_0];
-      iCount = m_iCount    [iPartIdx][SAO_EO_0];
+      iStats = ppStats[SAO_EO_0];
+      iCount = ppCount[SAO_EO_0];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1133,8 +1194,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
         numSkipLine = iIsChroma? 2:4;
         numSkipLineRight = iIsChroma? 2:4;
       }
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_1];
-      iCount = m_iCount    [iPartIdx][SAO_EO_1];
+      iStats = ppStats[SAO_EO_1];
+      iCount = ppCount[SAO_EO_1];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1150,15 +1211,15 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
 
       for (x=0; x< iLcuWidth; x++)
       {
-        m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-iStride]);
+        upBuff1[x] = xSign(pRec[x] - pRec[x-iStride]);
       }
       for (y=iStartY; y<iEndY; y++)
       {
         for (x=0; x<iEndX; x++)
         {
           iSignDown     =  xSign(pRec[x] - pRec[x+iStride]); 
-          uiEdgeType    =  iSignDown + m_iUpBuff1[x] + 2;
-          m_iUpBuff1[x] = -iSignDown;
+          uiEdgeType    =  iSignDown + upBuff1[x] + 2;
+          upBuff1[x] = -iSignDown;
 
           iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
           iCount[m_auiEoTable[uiEdgeType]] ++;
@@ -1174,8 +1235,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
         numSkipLine = iIsChroma? 2:4;
         numSkipLineRight = iIsChroma? 3:5;
       }
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_2];
-      iCount = m_iCount    [iPartIdx][SAO_EO_2];
+      iStats = ppStats[SAO_EO_2];
+      iCount = ppCount[SAO_EO_2];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1193,7 +1254,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
 
       for (x=iStartX; x<iEndX; x++)
       {
-        m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-iStride-1]);
+        upBuff1[x] = xSign(pRec[x] - pRec[x-iStride-1]);
       }
       for (y=iStartY; y<iEndY; y++)
       {
@@ -1201,15 +1262,15 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
         for (x=iStartX; x<iEndX; x++)
         {
           iSignDown1      =  xSign(pRec[x] - pRec[x+iStride+1]) ;
-          uiEdgeType      =  iSignDown1 + m_iUpBuff1[x] + 2;
-          m_iUpBufft[x+1] = -iSignDown1; 
+          uiEdgeType      =  iSignDown1 + upBuff1[x] + 2;
+          upBufft[x+1] = -iSignDown1; 
           iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
           iCount[m_auiEoTable[uiEdgeType]] ++;
         }
-        m_iUpBufft[iStartX] = iSignDown2;
-        ipSwap     = m_iUpBuff1;
-        m_iUpBuff1 = m_iUpBufft;
-        m_iUpBufft = ipSwap;
+        upBufft[iStartX] = iSignDown2;
+        swapBuff     = upBuff1;
+        upBuff1 = upBufft;
+        upBufft = swapBuff;
 
         pRec += iStride;
         pOrg += iStride;
@@ -1222,8 +1283,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
         numSkipLine = iIsChroma? 2:4;
         numSkipLineRight = iIsChroma? 3:5;
       }
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_3];
-      iCount = m_iCount    [iPartIdx][SAO_EO_3];
+      iStats = ppStats[SAO_EO_3];
+      iCount = ppCount[SAO_EO_3];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1241,7 +1302,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
 
       for (x=iStartX-1; x<iEndX; x++)
       {
-        m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-iStride+1]);
+        upBuff1[x] = xSign(pRec[x] - pRec[x-iStride+1]);
       }
 
       for (y=iStartY; y<iEndY; y++)
@@ -1249,12 +1310,12 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
         for (x=iStartX; x<iEndX; x++)
         {
           iSignDown1      =  xSign(pRec[x] - pRec[x+iStride-1]) ;
-          uiEdgeType      =  iSignDown1 + m_iUpBuff1[x] + 2;
-          m_iUpBuff1[x-1] = -iSignDown1; 
+          uiEdgeType      =  iSignDown1 + upBuff1[x] + 2;
+          upBuff1[x-1] = -iSignDown1; 
           iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
           iCount[m_auiEoTable[uiEdgeType]] ++;
         }
-        m_iUpBuff1[iEndX-1] = xSign(pRec[iEndX-1 + iStride] - pRec[iEndX]);
+        upBuff1[iEndX-1] = xSign(pRec[iEndX-1 + iStride] - pRec[iEndX]);
 
         pRec += iStride;
         pOrg += iStride;
@@ -1263,10 +1324,24 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Int iY
   }
 }
 
-
+/** Calculate SAO statistics of the LCUs before deblocking, concurrently
+ * \param  pcPic picture
+ */
 Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic )
 {
-  Int addr, yCbCr;
+  cilk_for (Int addr = 0; addr < m_iNumCuInWidth*m_iNumCuInHeight; addr++)
+  {
+    calcSaoStatsCu_BeforeDblk( pcPic, addr );
+  }
+}
+
+/** Calculate SAO statistics of one LCU before deblocking, LCUs may be processed concurrently
+ * \param  pcPic picture
+ * \param  addr LCU address
+ */
+Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic, Int addr )
+{
+  Int yCbCr;
   Int x,y;
   TComSPS *pTmpSPS =  pcPic->getSlice(0)->getSPS();
 
@@ -1288,10 +1363,6 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic )
   Int endY;
   Int firstX, firstY;
 
-  Int idxY;
-  Int idxX;
-  Int frameHeightInCU = m_iNumCuInHeight;
-  Int frameWidthInCU  = m_iNumCuInWidth;
   Int j, k;
 
   Int isChroma;
@@ -1300,270 +1371,266 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic )
   UInt lPelX, tPelY;
   TComDataCU *pTmpCu;
   Pel* pTableBo;
+  Int  aiUpBuff1[MAX_CU_SIZE+2];
+  Int  aiUpBufft[MAX_CU_SIZE+2];
+  Int* upBuff1 = &aiUpBuff1[1];
+  Int* upBufft = &aiUpBufft[1];
+  Int* swapBuff;
 
-  for (idxY = 0; idxY< frameHeightInCU; idxY++)
+  pTmpCu = pcPic->getCU(addr);
+  lPelX   = pTmpCu->getCUPelX();
+  tPelY   = pTmpCu->getCUPelY();
+  for( yCbCr = 0; yCbCr < 3; yCbCr++ )
   {
-    for (idxX = 0; idxX< frameWidthInCU; idxX++)
+    isChroma = (yCbCr!=0)? 1:0;
+
+    for ( j=0;j<MAX_NUM_SAO_TYPE;j++)
     {
-      lcuHeight = pTmpSPS->getMaxCUHeight();
-      lcuWidth  = pTmpSPS->getMaxCUWidth();
-      addr     = idxX  + frameWidthInCU*idxY;
-      pTmpCu = pcPic->getCU(addr);
-      lPelX   = pTmpCu->getCUPelX();
-      tPelY   = pTmpCu->getCUPelY();
-      for( yCbCr = 0; yCbCr < 3; yCbCr++ )
+      for ( k=0;k< MAX_NUM_SAO_CLASS;k++)
       {
-        isChroma = (yCbCr!=0)? 1:0;
+        m_count_PreDblk    [addr][yCbCr][j][k] = 0;
+        m_offsetOrg_PreDblk[addr][yCbCr][j][k] = 0;
+      }  
+    }
+    if( yCbCr == 0 )
+    {
+      picWidthTmp  = m_iPicWidth;
+      picHeightTmp = m_iPicHeight;
+    }
+    else if( yCbCr == 1 )
+    {
+      picWidthTmp  = m_iPicWidth  >> isChroma;
+      picHeightTmp = m_iPicHeight >> isChroma;
+      lcuWidth     = lcuWidth    >> isChroma;
+      lcuHeight    = lcuHeight   >> isChroma;
+      lPelX       = lPelX      >> isChroma;
+      tPelY       = tPelY      >> isChroma;
+    }
+    rPelX       = lPelX + lcuWidth  ;
+    bPelY       = tPelY + lcuHeight ;
+    rPelX       = rPelX > picWidthTmp  ? picWidthTmp  : rPelX;
+    bPelY       = bPelY > picHeightTmp ? picHeightTmp : bPelY;
+    lcuWidth     = rPelX - lPelX;
+    lcuHeight    = bPelY - tPelY;
 
-        for ( j=0;j<MAX_NUM_SAO_TYPE;j++)
-        {
-          for ( k=0;k< MAX_NUM_SAO_CLASS;k++)
-          {
-            m_count_PreDblk    [addr][yCbCr][j][k] = 0;
-            m_offsetOrg_PreDblk[addr][yCbCr][j][k] = 0;
-          }  
-        }
-        if( yCbCr == 0 )
-        {
-          picWidthTmp  = m_iPicWidth;
-          picHeightTmp = m_iPicHeight;
-        }
-        else if( yCbCr == 1 )
-        {
-          picWidthTmp  = m_iPicWidth  >> isChroma;
-          picHeightTmp = m_iPicHeight >> isChroma;
-          lcuWidth     = lcuWidth    >> isChroma;
-          lcuHeight    = lcuHeight   >> isChroma;
-          lPelX       = lPelX      >> isChroma;
-          tPelY       = tPelY      >> isChroma;
-        }
-        rPelX       = lPelX + lcuWidth  ;
-        bPelY       = tPelY + lcuHeight ;
-        rPelX       = rPelX > picWidthTmp  ? picWidthTmp  : rPelX;
-        bPelY       = bPelY > picHeightTmp ? picHeightTmp : bPelY;
-        lcuWidth     = rPelX - lPelX;
-        lcuHeight    = bPelY - tPelY;
+    stride    =  (yCbCr == 0)? pcPic->getStride(): pcPic->getCStride();
+    pTableBo = (yCbCr==0)?m_lumaTableBo:m_chromaTableBo;
 
-        stride    =  (yCbCr == 0)? pcPic->getStride(): pcPic->getCStride();
-        pTableBo = (yCbCr==0)?m_lumaTableBo:m_chromaTableBo;
+    //if(iSaoType == BO)
 
-        //if(iSaoType == BO)
+    numSkipLine = isChroma? 1:3;
+    numSkipLineRight = isChroma? 2:4;
 
-        numSkipLine = isChroma? 1:3;
-        numSkipLineRight = isChroma? 2:4;
+    stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_BO];
+    count = m_count_PreDblk[addr][yCbCr][SAO_BO];
 
-        stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_BO];
-        count = m_count_PreDblk[addr][yCbCr][SAO_BO];
+    pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
+    pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
+    startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
+    startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
+    for (y=0; y<lcuHeight; y++)
+    {
+      for (x=0; x<lcuWidth; x++)
+      {
+        if( x < startX && y < startY )
+          continue;
 
-        for (y=0; y<lcuHeight; y++)
+        classIdx = pTableBo[pRec[x]];
+        if (classIdx)
         {
-          for (x=0; x<lcuWidth; x++)
-          {
-            if( x < startX && y < startY )
-              continue;
-
-            classIdx = pTableBo[pRec[x]];
-            if (classIdx)
-            {
-              stats[classIdx] += (pOrg[x] - pRec[x]); 
-              count[classIdx] ++;
-            }
-          }
-          pOrg += stride;
-          pRec += stride;
+          stats[classIdx] += (pOrg[x] - pRec[x]); 
+          count[classIdx] ++;
         }
+      }
+      pOrg += stride;
+      pRec += stride;
+    }
 
-        Int signLeft;
-        Int signRight;
-        Int signDown;
-        Int signDown1;
-        Int signDown2;
+    Int signLeft;
+    Int signRight;
+    Int signDown;
+    Int signDown1;
+    Int signDown2;
 
-        UInt uiEdgeType;
+    UInt uiEdgeType;
 
-        //if (iSaoType == EO_0)
+    //if (iSaoType == EO_0)
 
-        numSkipLine = isChroma? 1:3;
-        numSkipLineRight = isChroma? 3:5;
+    numSkipLine = isChroma? 1:3;
+    numSkipLineRight = isChroma? 3:5;
 
-        stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_0];
-        count = m_count_PreDblk[addr][yCbCr][SAO_EO_0];
+    stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_0];
+    count = m_count_PreDblk[addr][yCbCr][SAO_EO_0];
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
+    pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
+    pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
-        firstX   = (lPelX == 0) ? 1 : 0;
-        endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
+    startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
+    startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
+    firstX   = (lPelX == 0) ? 1 : 0;
+    endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
 
-        for (y=0; y<lcuHeight; y++)
-        {
-          signLeft = xSign(pRec[firstX] - pRec[firstX-1]);
-          for (x=firstX; x< endX; x++)
-          {
-            signRight =  xSign(pRec[x] - pRec[x+1]); 
-            uiEdgeType =  signRight + signLeft + 2;
-            signLeft  = -signRight;
+    for (y=0; y<lcuHeight; y++)
+    {
+      signLeft = xSign(pRec[firstX] - pRec[firstX-1]);
+      for (x=firstX; x< endX; x++)
+      {
+        signRight =  xSign(pRec[x] - pRec[x+1]); 
+        uiEdgeType =  signRight + signLeft + 2;
+        signLeft  = -signRight;
 
-            if( x < startX && y < startY )
-              continue;
+        if( x < startX && y < startY )
+          continue;
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          pOrg += stride;
-          pRec += stride;
-        }
+        stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+        count[m_auiEoTable[uiEdgeType]] ++;
+      }
+      pOrg += stride;
+      pRec += stride;
+    }
 
-        //if (iSaoType == EO_1)
+    //if (iSaoType == EO_1)
 
-        numSkipLine = isChroma? 2:4;
-        numSkipLineRight = isChroma? 2:4;
+    numSkipLine = isChroma? 2:4;
+    numSkipLineRight = isChroma? 2:4;
 
-        stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_1];
-        count = m_count_PreDblk[addr][yCbCr][SAO_EO_1];
+    stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_1];
+    count = m_count_PreDblk[addr][yCbCr][SAO_EO_1];
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
+    pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
+    pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
-        firstY = (tPelY == 0) ? 1 : 0;
-        endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
-        if (firstY == 1)
-        {
-          pOrg += stride;
-          pRec += stride;
-        }
-
-        for (x=0; x< lcuWidth; x++)
-        {
-          m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
-        }
-        for (y=firstY; y<endY; y++)
-        {
-          for (x=0; x<lcuWidth; x++)
-          {
-            signDown     =  xSign(pRec[x] - pRec[x+stride]); 
-            uiEdgeType    =  signDown + m_iUpBuff1[x] + 2;
-            m_iUpBuff1[x] = -signDown;
+    startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
+    startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
+    firstY = (tPelY == 0) ? 1 : 0;
+    endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
+    if (firstY == 1)
+    {
+      pOrg += stride;
+      pRec += stride;
+    }
 
-            if( x < startX && y < startY )
-              continue;
+    for (x=0; x< lcuWidth; x++)
+    {
+      upBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
+    }
+    for (y=firstY; y<endY; y++)
+    {
+      for (x=0; x<lcuWidth; x++)
+      {
+        signDown     =  xSign(pRec[x] - pRec[x+stride]); 
+        uiEdgeType    =  signDown + upBuff1[x] + 2;
+        upBuff1[x] = -signDown;
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          pOrg += stride;
-          pRec += stride;
-        }
+        if( x < startX && y < startY )
+          continue;
 
-        //if (iSaoType == EO_2)
+        stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+        count[m_auiEoTable[uiEdgeType]] ++;
+      }
+      pOrg += stride;
+      pRec += stride;
+    }
 
-        numSkipLine = isChroma? 2:4;
-        numSkipLineRight = isChroma? 3:5;
+    //if (iSaoType == EO_2)
 
-        stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_2];
-        count = m_count_PreDblk[addr][yCbCr][SAO_EO_2];
+    numSkipLine = isChroma? 2:4;
+    numSkipLineRight = isChroma? 3:5;
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
+    stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_2];
+    count = m_count_PreDblk[addr][yCbCr][SAO_EO_2];
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
-        firstX   = (lPelX == 0) ? 1 : 0;
-        firstY = (tPelY == 0) ? 1 : 0;
-        endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
-        endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
-        if (firstY == 1)
-        {
-          pOrg += stride;
-          pRec += stride;
-        }
+    pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
+    pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
 
-        for (x=firstX; x<endX; x++)
-        {
-          m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride-1]);
-        }
-        for (y=firstY; y<endY; y++)
-        {
-          signDown2 = xSign(pRec[stride+startX] - pRec[startX-1]);
-          for (x=firstX; x<endX; x++)
-          {
-            signDown1      =  xSign(pRec[x] - pRec[x+stride+1]) ;
-            uiEdgeType      =  signDown1 + m_iUpBuff1[x] + 2;
-            m_iUpBufft[x+1] = -signDown1; 
+    startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
+    startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
+    firstX   = (lPelX == 0) ? 1 : 0;
+    firstY = (tPelY == 0) ? 1 : 0;
+    endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
+    endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
+    if (firstY == 1)
+    {
+      pOrg += stride;
+      pRec += stride;
+    }
 
-            if( x < startX && y < startY )
-              continue;
+    for (x=firstX; x<endX; x++)
+    {
+      upBuff1[x] = xSign(pRec[x] - pRec[x-stride-1]);
+    }
+    for (y=firstY; y<endY; y++)
+    {
+      signDown2 = xSign(pRec[stride+startX] - pRec[startX-1]);
+      for (x=firstX; x<endX; x++)
+      {
+        signDown1      =  xSign(pRec[x] - pRec[x+stride+1]) ;
+        uiEdgeType      =  signDown1 + upBuff1[x] + 2;
+        upBufft[x+1] = -signDown1; 
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          m_iUpBufft[firstX] = signDown2;
-          ipSwap     = m_iUpBuff1;
-          m_iUpBuff1 = m_iUpBufft;
-          m_iUpBufft = ipSwap;
+        if( x < startX && y < startY )
+          continue;
 
-          pRec += stride;
-          pOrg += stride;
-        }
+        stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+        count[m_auiEoTable[uiEdgeType]] ++;
+      }
+      upBufft[firstX] = signDown2;
+      swapBuff     = upBuff1;
+      upBuff1 = upBufft;
+      upBufft = swapBuff;
 
-        //if (iSaoType == EO_3)
+      pRec += stride;
+      pOrg += stride;
+    }
 
-        numSkipLine = isChroma? 2:4;
-        numSkipLineRight = isChroma? 3:5;
+    //if (iSaoType == EO_3)
 
-        stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_3];
-        count = m_count_PreDblk[addr][yCbCr][SAO_EO_3];
+    numSkipLine = isChroma? 2:4;
+    numSkipLineRight = isChroma? 3:5;
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
+    stats = m_offsetOrg_PreDblk[addr][yCbCr][SAO_EO_3];
+    count = m_count_PreDblk[addr][yCbCr][SAO_EO_3];
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
-        firstX   = (lPelX == 0) ? 1 : 0;
-        firstY = (tPelY == 0) ? 1 : 0;
-        endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
-        endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
-        if (firstY == 1)
-        {
-          pOrg += stride;
-          pRec += stride;
-        }
+    pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), yCbCr, addr);
+    pRec = getPicYuvAddr(pcPic->getPicYuvRec(), yCbCr, addr);
 
-        for (x=firstX-1; x<endX; x++)
-        {
-          m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride+1]);
-        }
+    startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
+    startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
+    firstX   = (lPelX == 0) ? 1 : 0;
+    firstY = (tPelY == 0) ? 1 : 0;
+    endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
+    endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
+    if (firstY == 1)
+    {
+      pOrg += stride;
+      pRec += stride;
+    }
 
-        for (y=firstY; y<endY; y++)
-        {
-          for (x=firstX; x<endX; x++)
-          {
-            signDown1      =  xSign(pRec[x] - pRec[x+stride-1]) ;
-            uiEdgeType      =  signDown1 + m_iUpBuff1[x] + 2;
-            m_iUpBuff1[x-1] = -signDown1; 
+    for (x=firstX-1; x<endX; x++)
+    {
+      upBuff1[x] = xSign(pRec[x] - pRec[x-stride+1]);
+    }
 
-            if( x < startX && y < startY )
-              continue;
+    for (y=firstY; y<endY; y++)
+    {
+      for (x=firstX; x<endX; x++)
+      {
+        signDown1      =  xSign(pRec[x] - pRec[x+stride-1]) ;
+        uiEdgeType      =  signDown1 + upBuff1[x] + 2;
+        upBuff1[x-1] = -signDown1; 
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          m_iUpBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
+        if( x < startX && y < startY )
+          continue;
 
-          pRec += stride;
-          pOrg += stride;
-        }
+        stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+        count[m_auiEoTable[uiEdgeType]] ++;
       }
+      upBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
+
+      pRec += stride;
+      pOrg += stride;
     }
   }
 }
@@ -1720,15 +1787,7 @@ Void TEncSampleAdaptiveOffset::SAOProcess(SAOParam *pcSaoParam, Double dLambda)
       assignSaoUnitSyntax(pcSaoParam->saoLcuParam[0],  pcSaoParam->psSaoPart[0], pcSaoParam->oneUnitFlag[0], 0);
     }
   }
-  if (pcSaoParam->bSaoFlag[0])
-  {
-    processSaoUnitAll( pcSaoParam->saoLcuParam[0], pcSaoParam->oneUnitFlag[0], 0);
-  }
-  if (pcSaoParam->bSaoFlag[1])
-  {
-    processSaoUnitAll( pcSaoParam->saoLcuParam[1], pcSaoParam->oneUnitFlag[1], 1);
-    processSaoUnitAll( pcSaoParam->saoLcuParam[2], pcSaoParam->oneUnitFlag[2], 2);
-  }
+  processSaoPicRows( pcSaoParam, pcSaoParam->bSaoFlag[0], pcSaoParam->bSaoFlag[1], 0, m_pcPic->getFrameHeightInCU());
 }
 /** Check merge SAO unit
  * \param saoUnitCurr current SAO unit 
@@ -1902,6 +1961,8 @@ Void TEncSampleAdaptiveOffset::rdoSaoUnitAll(SAOParam *saoParam, Double lambda,
 #endif
 #endif
 
+  calcSaoStatsLcus(saoParam);
+
   for (idxY = 0; idxY< frameHeightInCU; idxY++)
   {
     for (idxX = 0; idxX< frameWidthInCU; idxX++)
@@ -1950,7 +2011,7 @@ Void TEncSampleAdaptiveOffset::rdoSaoUnitAll(SAOParam *saoParam, Double lambda,
         m_pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(0);
       }
       m_pcRDGoOnSbacCoder->store( m_pppcRDSbacCoder[0][CI_TEMP_BEST] );
-      // reset stats Y, Cb, Cr
+      // stats Y, Cb, Cr of the LCU
       for ( compIdx=0;compIdx<3;compIdx++)
       {
         for ( j=0;j<MAX_NUM_SAO_TYPE;j++)
@@ -1958,28 +2019,14 @@ Void TEncSampleAdaptiveOffset::rdoSaoUnitAll(SAOParam *saoParam, Double lambda,
           for ( k=0;k< MAX_NUM_SAO_CLASS;k++)
           {
             m_iOffset   [compIdx][j][k] = 0;
-            if( m_saoLcuBasedOptimization && m_saoLcuBoundary ){
-              m_iCount    [compIdx][j][k] = m_count_PreDblk    [addr][compIdx][j][k];
-              m_iOffsetOrg[compIdx][j][k] = m_offsetOrg_PreDblk[addr][compIdx][j][k];
-            }
-            else
-            {
-              m_iCount    [compIdx][j][k] = 0;
-              m_iOffsetOrg[compIdx][j][k] = 0;
-            }
+            m_iCount    [compIdx][j][k] = m_countLcu    [addr][compIdx][j][k];
+            m_iOffsetOrg[compIdx][j][k] = m_offsetOrgLcu[addr][compIdx][j][k];
           }  
         }
         saoParam->saoLcuParam[compIdx][addr].typeIdx       =  -1;
         saoParam->saoLcuParam[compIdx][addr].mergeUpFlag   = 0;
         saoParam->saoLcuParam[compIdx][addr].mergeLeftFlag = 0;
         saoParam->saoLcuParam[compIdx][addr].subTypeIdx    = 0;
-#if SAO_ENCODING_CHOICE
-  if( (compIdx ==0 && saoParam->bSaoFlag[0])|| (compIdx >0 && saoParam->bSaoFlag[1]) )
-#endif
-        {
-          calcSaoStatsCu(addr, compIdx,  compIdx);
-
-       }
       }
       saoComponentParamDist(allowMergeLeft, allowMergeUp, saoParam, addr, addrUp, addrLeft, 0,  lambda, &mergeSaoParam[0][0], &compDistortion[0]);
       sao2ChromaParamDist(allowMergeLeft, allowMergeUp, saoParam, addr, addrUp, addrLeft, lambdaChroma, &mergeSaoParam[1][0], &mergeSaoParam[2][0], &compDistortion[0]);
@@ -2095,6 +2142,41 @@ if( saoParam->saoLcuParam[1][addr].typeIdx == -1)
 #endif
 
 }
+/** Calculate the SAO statistics of all the LCUs for rdoSaoUnitAll, the LCUs are processed concurrently
+ * \param saoParam SAO parameters
+ */
+Void TEncSampleAdaptiveOffset::calcSaoStatsLcus(SAOParam *saoParam)
+{
+  cilk_for (Int addr = 0; addr < saoParam->numCuInWidth*saoParam->numCuInHeight; addr++)
+  {
+    for (Int compIdx=0;compIdx<3;compIdx++)
+    {
+      for (Int j=0;j<MAX_NUM_SAO_TYPE;j++)
+      {
+        for (Int k=0;k< MAX_NUM_SAO_CLASS;k++)
+        {
+          if( m_saoLcuBasedOptimization && m_saoLcuBoundary )
+          {
+            m_countLcu    [addr][compIdx][j][k] = m_count_PreDblk    [addr][compIdx][j][k];
+            m_offsetOrgLcu[addr][compIdx][j][k] = m_offsetOrg_PreDblk[addr][compIdx][j][k];
+          }
+          else
+          {
+            m_countLcu    [addr][compIdx][j][k] = 0;
+            m_offsetOrgLcu[addr][compIdx][j][k] = 0;
+          }
+        }
+      }
+#if SAO_ENCODING_CHOICE
+      if( (compIdx ==0 && saoParam->bSaoFlag[0])|| (compIdx >0 && saoParam->bSaoFlag[1]) )
+#endif
+      {
+        calcSaoStatsCu(addr, compIdx, m_offsetOrgLcu[addr][compIdx], m_countLcu[addr][compIdx]);
+      }
+    }
+  }
+}
+
 /** rate distortion optimization of SAO unit 
  * \param saoParam SAO parameters
  * \param addr address 
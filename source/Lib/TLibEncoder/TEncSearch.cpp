@@ -39,7 +39,9 @@
 #include "TLibCommon/TComRom.h"
 #include "TLibCommon/TComMotionInfo.h"
 #include "TEncSearch.h"
+#include "TEncWorker.h"
 #include <math.h>
+#include <cilk/cilk.h>
 
 //! \ingroup TLibEncoder
 //! \{
@@ -111,6 +113,13 @@ TEncSearch::TEncSearch()
   m_puhQTTempTransformSkipFlag[0] = NULL;
   m_puhQTTempTransformSkipFlag[1] = NULL;
   m_puhQTTempTransformSkipFlag[2] = NULL;
+  m_pcRefSearch   = NULL;
+  m_pcRefRdCost   = NULL;
+  m_iNumRefSearch = 0;
+  m_pIntraModePred    = NULL;
+  m_pcIntraContexts   = NULL;
+  m_iNumIntraContexts = 0;
+  m_bPrivateRecIPred  = false;
   setWpScalingDistParam( NULL, -1, REF_PIC_LIST_X );
 }
 
@@ -122,7 +131,12 @@ TEncSearch::~TEncSearch()
     m_pTempPel = NULL;
   }
   
-  if ( m_pcEncCfg )
+  delete[] m_pcRefSearch;
+  delete[] m_pcRefRdCost;
+  delete[] m_pcIntraContexts;
+  delete[] m_pIntraModePred;
+
+  if ( m_ppcQTTempCoeffY )
   {
     const UInt uiNumLayersAllocated = m_pcEncCfg->getQuadtreeTULog2MaxSize()-m_pcEncCfg->getQuadtreeTULog2MinSize()+1;
     for( UInt ui = 0; ui < uiNumLayersAllocated; ++ui )
@@ -284,6 +298,81 @@ void TEncSearch::init(TEncCfg*      pcEncCfg,
   m_tmpYuvPred.create(MAX_CU_SIZE, MAX_CU_SIZE);
 }
 
+/** allocate the private contexts of the concurrent searches, only needed by the searches that compress CUs
+ * \note must be called after init()
+ */
+Void TEncSearch::createParallelContexts()
+{
+  // private ME contexts for the reference pictures of both lists
+  if ( m_pcEncCfg->getParallelRefME() && m_pcRefSearch == NULL )
+  {
+    for ( Int i = 0; i < m_pcEncCfg->getGOPSize(); i++ )
+    {
+      m_iNumRefSearch = std::max( m_iNumRefSearch, m_pcEncCfg->getGOPEntry(i).m_numRefPicsActive );
+    }
+    m_pcRefSearch = new TEncSearch[2*m_iNumRefSearch];
+    m_pcRefRdCost = new TComRdCost[2*m_iNumRefSearch];
+    for ( Int i = 0; i < 2*m_iNumRefSearch; i++ )
+    {
+      m_pcRefSearch[i].xInitRefSearch( this, &m_pcRefRdCost[i] );
+    }
+  }
+
+  // rough mode decision buffers and private RD contexts for the full RD candidates of the fast intra search
+  if ( m_pcEncCfg->getParallelIntraModes() && m_bUseSBACRD && m_pcIntraContexts == NULL )
+  {
+    m_pIntraModePred = new Pel[NUM_INTRA_MODE*MAX_CU_SIZE*MAX_CU_SIZE];
+
+    for ( Int i = 0; i < MAX_CU_DEPTH; i++ )
+    {
+      m_iNumIntraContexts = std::max( m_iNumIntraContexts, (Int)g_aucIntraModeNumFast[i] );
+    }
+#if FAST_UDI_USE_MPM
+    m_iNumIntraContexts += 3;
+#endif
+    m_iNumIntraContexts = std::min( m_iNumIntraContexts, FAST_UDI_MAX_RDMODE_NUM );
+    m_pcIntraContexts = new TEncIntraContext[m_iNumIntraContexts];
+    for ( Int i = 0; i < m_iNumIntraContexts; i++ )
+    {
+      m_pcIntraContexts[i].create( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight );
+      m_pcIntraContexts[i].init( m_pcEncCfg, m_pcTrQuant );
+      m_pcIntraContexts[i].getPredSearch()->m_bPrivateRecIPred = true;
+    }
+  }
+}
+
+/** copy the slice-level state into the private intra contexts
+ * \param pcSlice slice to be compressed
+ */
+Void TEncSearch::initTileContexts( TComSlice* pcSlice )
+{
+  for ( Int i = 0; i < m_iNumIntraContexts; i++ )
+  {
+    m_pcIntraContexts[i].initTile( pcSlice, m_pcTrQuant );
+  }
+}
+
+/** set up a private ME context, only the interpolation buffers are allocated
+ * \param pcSearch search whose ME parameters are shared
+ * \param pcRdCost private RD cost class, its lambda is copied per prediction unit
+ */
+Void TEncSearch::xInitRefSearch( TEncSearch* pcSearch, TComRdCost* pcRdCost )
+{
+  m_pcEncCfg          = pcSearch->m_pcEncCfg;
+  m_pcTrQuant         = pcSearch->m_pcTrQuant;
+  m_iSearchRange      = pcSearch->m_iSearchRange;
+  m_bipredSearchRange = pcSearch->m_bipredSearchRange;
+  m_iFastSearch       = pcSearch->m_iFastSearch;
+  m_iMaxDeltaQP       = pcSearch->m_iMaxDeltaQP;
+  m_pcRdCost          = pcRdCost;
+  m_pppcRDSbacCoder   = NULL;
+  m_pcRDGoOnSbacCoder = NULL;
+  m_bUseSBACRD        = false;
+  m_puiDFilter        = s_auiDFilter + 4;
+
+  initTempBuff();
+}
+
 #if FASTME_SMOOTHER_MV
 #define FIRSTSEARCHSTOP     1
 #else
@@ -1033,6 +1122,12 @@ TEncSearch::xIntraCodingLumaBlk( TComDataCU* pcCU,
   UInt    uiZOrder          = pcCU->getZorderIdxInCU() + uiAbsPartIdx;
   Pel*    piRecIPred        = pcCU->getPic()->getPicYuvRec()->getLumaAddr( pcCU->getAddr(), uiZOrder );
   UInt    uiRecIPredStride  = pcCU->getPic()->getPicYuvRec()->getStride  ();
+  if ( m_bPrivateRecIPred )
+  {
+    // candidate checked concurrently with others, no further TU of it is predicted from this one
+    piRecIPred              = piRecQt;
+    uiRecIPredStride        = uiRecQtStride;
+  }
   Bool    useTransformSkip  = pcCU->getTransformSkip(uiAbsPartIdx, TEXT_LUMA);
   //===== init availability pattern =====
   Bool  bAboveAvail = false;
@@ -1930,6 +2025,12 @@ TEncSearch::xLoadIntraResultQT( TComDataCU* pcCU,
     m_pcQTTempTransformSkipTComYuv.copyPartToPartChroma( &m_pcQTTempTComYuv[ uiQTLayer ], uiAbsPartIdx, 1 << uiLog2TrSizeChroma, 1 << uiLog2TrSizeChroma );
   }
 
+  // the picture is only written by the selected candidate
+  if ( m_bPrivateRecIPred )
+  {
+    return;
+  }
+
   UInt    uiZOrder          = pcCU->getZorderIdxInCU() + uiAbsPartIdx;
   Pel*    piRecIPred        = pcCU->getPic()->getPicYuvRec()->getLumaAddr( pcCU->getAddr(), uiZOrder );
   UInt    uiRecIPredStride  = pcCU->getPic()->getPicYuvRec()->getStride  ();
@@ -2418,6 +2519,96 @@ TEncSearch::preestChromaPredMode( TComDataCU* pcCU,
   pcCU->setChromIntraDirSubParts( uiBestMode, 0, pcCU->getDepth( 0 ) );
 }
 
+/** prediction and Hadamard cost of every intra luma mode of a PU, the modes are predicted concurrently
+ * \param pcCU pointer to CU data structure with the intra pattern of the PU
+ * \param iNumModes number of intra modes
+ * \param piOrg pointer to the original luma samples of the PU
+ * \param uiStride stride of the original and prediction buffers
+ * \param uiWidth width of the PU
+ * \param uiHeight height of the PU
+ * \param bAboveAvail above neighbours are available
+ * \param bLeftAvail left neighbours are available
+ * \param puiSad output Hadamard cost of each mode
+ * \returns Void
+ */
+Void TEncSearch::xRoughIntraModeCosts( TComDataCU* pcCU, Int iNumModes, Pel* piOrg, UInt uiStride, UInt uiWidth, UInt uiHeight, Bool bAboveAvail, Bool bLeftAvail, UInt* puiSad )
+{
+  cilk_for ( Int iMode = 0; iMode < iNumModes; iMode++ )
+  {
+    Pel* piPred = m_pIntraModePred + iMode*MAX_CU_SIZE*MAX_CU_SIZE;
+    predIntraLumaAng( pcCU->getPattern(), iMode, piPred, uiStride, uiWidth, uiHeight, bAboveAvail, bLeftAvail );
+    puiSad[iMode] = m_pcRdCost->calcHAD( g_bitDepthY, piOrg, uiStride, piPred, uiStride, uiWidth, uiHeight );
+  }
+}
+
+#if HHI_RQT_INTRA_SPEEDUP
+/** checks whether the first RQT check of an intra PU codes a single TU, as decided by xRecurIntraCodingQT
+ * \param pcCU pointer to CU data structure
+ * \param uiTrDepth transform depth of the PU
+ * \returns Bool
+ */
+Bool TEncSearch::xIsSingleIntraTU( TComDataCU* pcCU, UInt uiTrDepth )
+{
+  UInt uiFullDepth  = pcCU->getDepth( 0 ) + uiTrDepth;
+  UInt uiLog2TrSize = g_aucConvertToBit[ pcCU->getSlice()->getSPS()->getMaxCUWidth() >> uiFullDepth ] + 2;
+  Int  maxTuSize    = pcCU->getSlice()->getSPS()->getQuadtreeTULog2MaxSize();
+  Bool bCheckFull   = ( uiLog2TrSize <= maxTuSize );
+  Bool noSplitIntraMaxTuSize = bCheckFull;
+  if( m_pcEncCfg->getRDpenalty() && pcCU->getSlice()->getSliceType() != I_SLICE )
+  {
+    noSplitIntraMaxTuSize = ( uiLog2TrSize <= min(maxTuSize,4) );
+    if( m_pcEncCfg->getRDpenalty() == 2 )
+    {
+      bCheckFull = ( uiLog2TrSize <= min(maxTuSize,4) );
+    }
+  }
+  return bCheckFull && noSplitIntraMaxTuSize;
+}
+
+/** first RQT check of the full-RD intra luma candidates of a PU, the candidates are checked concurrently on the
+ *  private intra contexts and only their costs are returned
+ * \param pcCU pointer to CU data structure
+ * \param uiTrDepth transform depth of the PU
+ * \param uiAbsPartIdx part index of the PU
+ * \param pcOrgYuv pointer to the original samples
+ * \param iNumCand number of candidates
+ * \param puiCandModes intra modes of the candidates
+ * \param pdCandCosts output RD cost of each candidate
+ * \returns Void
+ */
+Void TEncSearch::xCheckIntraCandidates( TComDataCU* pcCU, UInt uiTrDepth, UInt uiAbsPartIdx, TComYuv* pcOrgYuv, Int iNumCand, UInt* puiCandModes, Double* pdCandCosts )
+{
+  UInt uiDepth = pcCU->getDepth( 0 );
+  
+  for( Int i = 0; i < min( iNumCand, m_iNumIntraContexts ); i++ )
+  {
+    TComDataCU* pcCandCU = m_pcIntraContexts[i].getCU();
+    pcCandCU->initEstData( pcCU, uiDepth, pcCU->getQP( 0 ) );
+    pcCandCU->copyPartFrom( pcCU, 0, uiDepth );
+    m_pcIntraContexts[i].getRdCost()->copyLambda( m_pcRdCost );
+  }
+  
+  for( Int iFirst = 0; iFirst < iNumCand; iFirst += m_iNumIntraContexts )
+  {
+    Int iLast = min( iFirst + m_iNumIntraContexts, iNumCand );
+    cilk_for ( Int i = iFirst; i < iLast; i++ )
+    {
+      TEncIntraContext* pcContext = &m_pcIntraContexts[i - iFirst];
+      TEncSearch*       pcSearch  = pcContext->getPredSearch();
+      TComDataCU*       pcCandCU  = pcContext->getCU();
+      
+      pcCandCU->setLumaIntraDirSubParts( puiCandModes[i], uiAbsPartIdx, uiDepth + uiTrDepth );
+      pcSearch->m_pcRDGoOnSbacCoder->load( m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST] );
+      
+      UInt uiDistY = 0;
+      UInt uiDistC = 0;
+      pdCandCosts[i] = 0.0;
+      pcSearch->xRecurIntraCodingQT( pcCandCU, uiTrDepth, uiAbsPartIdx, true, pcOrgYuv, pcContext->getPredYuv( uiDepth ), pcContext->getResiYuv( uiDepth ), uiDistY, uiDistC, true, pdCandCosts[i] );
+    }
+  }
+}
+#endif
+
 Void 
 TEncSearch::estIntraPredQT( TComDataCU* pcCU, 
                            TComYuv*    pcOrgYuv, 
@@ -2478,14 +2669,26 @@ TEncSearch::estIntraPredQT( TComDataCU* pcCU,
       }
       CandNum = 0;
       
+      // the modes of larger PUs are predicted concurrently, the candidate list is still built in mode order
+      UInt auiSad[NUM_INTRA_MODE];
+      Bool bParallelRough = m_pIntraModePred != NULL && uiWidth >= 16;
+      if ( bParallelRough )
+      {
+        xRoughIntraModeCosts( pcCU, numModesAvailable, piOrg, uiStride, uiWidth, uiHeight, bAboveAvail, bLeftAvail, auiSad );
+      }
+      
       for( Int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
       {
         UInt uiMode = modeIdx;
+        UInt uiSad  = auiSad[uiMode];
 
-        predIntraLumaAng( pcCU->getPattern(), uiMode, piPred, uiStride, uiWidth, uiHeight, bAboveAvail, bLeftAvail );
-        
-        // use hadamard transform here
-        UInt uiSad = m_pcRdCost->calcHAD(g_bitDepthY, piOrg, uiStride, piPred, uiStride, uiWidth, uiHeight );
+        if ( !bParallelRough )
+        {
+          predIntraLumaAng( pcCU->getPattern(), uiMode, piPred, uiStride, uiWidth, uiHeight, bAboveAvail, bLeftAvail );
+          
+          // use hadamard transform here
+          uiSad = m_pcRdCost->calcHAD(g_bitDepthY, piOrg, uiStride, piPred, uiStride, uiWidth, uiHeight );
+        }
         
         UInt   iModeBits = xModeBitsIntra( pcCU, uiMode, uiPU, uiPartOffset, uiDepth, uiInitTrDepth );
         Double cost      = (Double)uiSad + (Double)iModeBits * m_pcRdCost->getSqrtLambda();
@@ -2537,8 +2740,50 @@ TEncSearch::estIntraPredQT( TComDataCU* pcCU,
     UInt    uiBestPUDistY = 0;
     UInt    uiBestPUDistC = 0;
     Double  dBestPUCost   = MAX_DOUBLE;
+    
+#if HHI_RQT_INTRA_SPEEDUP
+    // the first RQT check of each candidate is a single TU that no other candidate depends on, the candidates are
+    // checked concurrently on private contexts and only the best one is coded again here to keep its results
+    Int    iBestCand       = -1;
+#if HHI_RQT_INTRA_SPEEDUP_MOD
+    UInt   uiSecondCand    = MAX_UINT;
+    Double dSecondCandCost = MAX_DOUBLE;
+#endif
+    if ( m_pcIntraContexts && bLumaOnly && numModesForFullRD > 1 && xIsSingleIntraTU( pcCU, uiInitTrDepth ) )
+    {
+      Double adCandCost[FAST_UDI_MAX_RDMODE_NUM];
+      xCheckIntraCandidates( pcCU, uiInitTrDepth, uiPartOffset, pcOrgYuv, numModesForFullRD, uiRdModeList, adCandCost );
+      
+      Double dBestCandCost = MAX_DOUBLE;
+      for( Int i = 0; i < numModesForFullRD; i++ )
+      {
+        if( adCandCost[i] < dBestCandCost )
+        {
+#if HHI_RQT_INTRA_SPEEDUP_MOD
+          uiSecondCand    = iBestCand < 0 ? 0 : uiRdModeList[iBestCand];
+          dSecondCandCost = dBestCandCost;
+#endif
+          dBestCandCost = adCandCost[i];
+          iBestCand     = i;
+        }
+#if HHI_RQT_INTRA_SPEEDUP_MOD
+        else if( adCandCost[i] < dSecondCandCost )
+        {
+          uiSecondCand    = uiRdModeList[i];
+          dSecondCandCost = adCandCost[i];
+        }
+#endif
+      }
+    }
+#endif
     for( UInt uiMode = 0; uiMode < numModesForFullRD; uiMode++ )
     {
+#if HHI_RQT_INTRA_SPEEDUP
+      if( iBestCand >= 0 && uiMode != iBestCand )
+      {
+        continue;
+      }
+#endif
       // set luma prediction mode
       UInt uiOrgMode = uiRdModeList[uiMode];
       
@@ -2594,6 +2839,11 @@ TEncSearch::estIntraPredQT( TComDataCU* pcCU,
     
 #if HHI_RQT_INTRA_SPEEDUP
 #if HHI_RQT_INTRA_SPEEDUP_MOD
+    if( iBestCand >= 0 )
+    {
+      uiSecondBestMode  = uiSecondCand;
+      dSecondBestPUCost = dSecondCandCost;
+    }
     for( UInt ui =0; ui < 2; ++ui )
 #endif
     {
@@ -3222,6 +3472,11 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*&
 #endif
 
     //  Uni-directional prediction
+    UInt          auiBitsTemp[2][33];
+    UInt          auiCostTemp[2][33];
+    Bool          abSearch[2][33];
+
+    // AMVP of every reference picture
     for ( Int iRefList = 0; iRefList < iNumPredDir; iRefList++ )
     {
       RefPicList  eRefPicList = ( iRefList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
@@ -3269,35 +3524,80 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*&
           }          
         }
 #endif
-        
+        xCopyAMVPInfo(pcCU->getCUMvField(eRefPicList)->getAMVPInfo(), &aacAMVPInfo[iRefList][iRefIdxTemp]); // must always be done ( also when AMVP_MODE = AM_NONE )
+        auiBitsTemp[iRefList][iRefIdxTemp] = uiBitsTemp;
 #if GPB_SIMPLE_UNI
-        if ( iRefList == 1 )    // list 1
+        // a list 1 picture that is also in list 0 reuses the list 0 search
+        abSearch[iRefList][iRefIdxTemp] = iRefList == 0 || pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp ) < 0;
+#else
+        abSearch[iRefList][iRefIdxTemp] = true;
+#endif
+      }
+    }
+
+    // motion estimation: the searches only share read-only data, each one runs on a private ME context
+    if ( m_pcRefSearch && pcCU->getSlice()->getNumRefIdx(REF_PIC_LIST_0) <= m_iNumRefSearch &&
+         ( iNumPredDir == 1 || pcCU->getSlice()->getNumRefIdx(REF_PIC_LIST_1) <= m_iNumRefSearch ) )
+    {
+      cilk_for ( Int iSearch = 0; iSearch < iNumPredDir*m_iNumRefSearch; iSearch++ )
+      {
+        Int         iRefList    = iSearch / m_iNumRefSearch;
+        Int         iRefIdxTemp = iSearch % m_iNumRefSearch;
+        RefPicList  eRefPicList = ( iRefList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+        if ( iRefIdxTemp < pcCU->getSlice()->getNumRefIdx(eRefPicList) && abSearch[iRefList][iRefIdxTemp] )
         {
-          if ( pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp ) >= 0 )
-          {
-            cMvTemp[1][iRefIdxTemp] = cMvTemp[0][pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp )];
-            uiCostTemp = uiCostTempL0[pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp )];
-            /*first subtract the bit-rate part of the cost of the other list*/
-            uiCostTemp -= m_pcRdCost->getCost( uiBitsTempL0[pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp )] );
-            /*correct the bit-rate part of the current ref*/
-            m_pcRdCost->setPredictor  ( cMvPred[iRefList][iRefIdxTemp] );
-            uiBitsTemp += m_pcRdCost->getBits( cMvTemp[1][iRefIdxTemp].getHor(), cMvTemp[1][iRefIdxTemp].getVer() );
-            /*calculate the correct cost*/
-            uiCostTemp += m_pcRdCost->getCost( uiBitsTemp );
-          }
-          else
+          TEncSearch* pcSearch = &m_pcRefSearch[iSearch];
+          pcSearch->m_pcRdCost->copyLambda( m_pcRdCost );
+          pcSearch->m_aaiAdaptSR[iRefList][iRefIdxTemp] = m_aaiAdaptSR[iRefList][iRefIdxTemp];
+          pcSearch->xMotionEstimation ( pcCU, pcOrgYuv, iPartIdx, eRefPicList, &cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp],
+                                        auiBitsTemp[iRefList][iRefIdxTemp], auiCostTemp[iRefList][iRefIdxTemp] );
+        }
+      }
+
+      // leave the motion cost as a serial search does
+      m_pcRdCost->getMotionCost( 1, 0 );
+      m_pcRdCost->setCostScale ( 0 );
+    }
+    else
+    {
+      for ( Int iRefList = 0; iRefList < iNumPredDir; iRefList++ )
+      {
+        RefPicList  eRefPicList = ( iRefList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+        for ( Int iRefIdxTemp = 0; iRefIdxTemp < pcCU->getSlice()->getNumRefIdx(eRefPicList); iRefIdxTemp++ )
+        {
+          if ( abSearch[iRefList][iRefIdxTemp] )
           {
-            xMotionEstimation ( pcCU, pcOrgYuv, iPartIdx, eRefPicList, &cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp );
+            xMotionEstimation ( pcCU, pcOrgYuv, iPartIdx, eRefPicList, &cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp],
+                                auiBitsTemp[iRefList][iRefIdxTemp], auiCostTemp[iRefList][iRefIdxTemp] );
           }
         }
-        else
+      }
+    }
+
+    // MVP refinement and selection of the best reference picture of each list
+    for ( Int iRefList = 0; iRefList < iNumPredDir; iRefList++ )
+    {
+      RefPicList  eRefPicList = ( iRefList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+      
+      for ( Int iRefIdxTemp = 0; iRefIdxTemp < pcCU->getSlice()->getNumRefIdx(eRefPicList); iRefIdxTemp++ )
+      {
+        uiBitsTemp = auiBitsTemp[iRefList][iRefIdxTemp];
+        uiCostTemp = auiCostTemp[iRefList][iRefIdxTemp];
+#if GPB_SIMPLE_UNI
+        if ( !abSearch[iRefList][iRefIdxTemp] )
         {
-          xMotionEstimation ( pcCU, pcOrgYuv, iPartIdx, eRefPicList, &cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp );
+          cMvTemp[1][iRefIdxTemp] = cMvTemp[0][pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp )];
+          uiCostTemp = uiCostTempL0[pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp )];
+          /*first subtract the bit-rate part of the cost of the other list*/
+          uiCostTemp -= m_pcRdCost->getCost( uiBitsTempL0[pcCU->getSlice()->getList1IdxToList0Idx( iRefIdxTemp )] );
+          /*correct the bit-rate part of the current ref*/
+          m_pcRdCost->setPredictor  ( cMvPred[iRefList][iRefIdxTemp] );
+          uiBitsTemp += m_pcRdCost->getBits( cMvTemp[1][iRefIdxTemp].getHor(), cMvTemp[1][iRefIdxTemp].getVer() );
+          /*calculate the correct cost*/
+          uiCostTemp += m_pcRdCost->getCost( uiBitsTemp );
         }
-#else
-        xMotionEstimation ( pcCU, pcOrgYuv, iPartIdx, eRefPicList, &cMvPred[iRefList][iRefIdxTemp], iRefIdxTemp, cMvTemp[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp );
 #endif
-        xCopyAMVPInfo(pcCU->getCUMvField(eRefPicList)->getAMVPInfo(), &aacAMVPInfo[iRefList][iRefIdxTemp]); // must always be done ( also when AMVP_MODE = AM_NONE )
+        xCopyAMVPInfo(&aacAMVPInfo[iRefList][iRefIdxTemp], pcCU->getCUMvField(eRefPicList)->getAMVPInfo());
         xCheckBestMVP(pcCU, eRefPicList, cMvTemp[iRefList][iRefIdxTemp], cMvPred[iRefList][iRefIdxTemp], aaiMvpIdx[iRefList][iRefIdxTemp], uiBitsTemp, uiCostTemp);
 
         if ( iRefList == 0 )
@@ -4032,7 +4332,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
   m_iSearchRange = m_aaiAdaptSR[eRefPicList][iRefIdxPred];
   
   Int           iSrchRng      = ( bBi ? m_bipredSearchRange : m_iSearchRange );
-  TComPattern*  pcPatternKey  = pcCU->getPattern        ();
+  TComPattern*  pcPatternKey  = &m_cPatternKey;
   
   Double        fWeight       = 1.0;
   
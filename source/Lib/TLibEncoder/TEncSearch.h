@@ -53,6 +53,7 @@
 //! \{
 
 class TEncCu;
+class TEncIntraContext;
 
 // ====================================================================================================================
 // Class definition
@@ -124,6 +125,18 @@ protected:
   // AMVP cost computation
   // UInt            m_auiMVPIdxCost[AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS];
   UInt            m_auiMVPIdxCost[AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS+1]; //th array bounds
+
+  // concurrent uni-directional ME
+  TComPattern     m_cPatternKey;                    ///< search key pattern of the motion estimation
+  TEncSearch*     m_pcRefSearch;                    ///< private ME contexts, one per reference picture of each list
+  TComRdCost*     m_pcRefRdCost;                    ///< RD cost classes of m_pcRefSearch
+  Int             m_iNumRefSearch;                  ///< number of reference pictures per list covered by m_pcRefSearch
+
+  // concurrent intra mode decision
+  Pel*            m_pIntraModePred;                 ///< rough mode decision: luma prediction of every intra mode
+  TEncIntraContext* m_pcIntraContexts;              ///< private RD contexts of the intra luma mode candidates
+  Int             m_iNumIntraContexts;              ///< number of candidates checked at the same time
+  Bool            m_bPrivateRecIPred;               ///< the intra reconstruction is not written into the picture
   
 public:
   TEncSearch();
@@ -140,6 +153,12 @@ public:
             TEncSbac***   pppcRDSbacCoder,
             TEncSbac*     pcRDGoOnSbacCoder );
   
+  /// allocate the private contexts of the concurrent searches enabled in the configuration
+  Void createParallelContexts();
+  
+  /// refresh the slice-level state of the private intra contexts before compressing a tile
+  Void initTileContexts( TComSlice* pcSlice );
+  
 protected:
   
   /// sub-function for motion vector refinement used in fractional-pel accuracy
@@ -290,6 +309,27 @@ protected:
 #endif
                                    Double&      dRDCost );
   
+  Void  xRoughIntraModeCosts      ( TComDataCU*  pcCU,
+                                    Int          iNumModes,
+                                    Pel*         piOrg,
+                                    UInt         uiStride,
+                                    UInt         uiWidth,
+                                    UInt         uiHeight,
+                                    Bool         bAboveAvail,
+                                    Bool         bLeftAvail,
+                                    UInt*        puiSad );
+#if HHI_RQT_INTRA_SPEEDUP
+  Bool  xIsSingleIntraTU          ( TComDataCU*  pcCU,
+                                    UInt         uiTrDepth );
+  Void  xCheckIntraCandidates     ( TComDataCU*  pcCU,
+                                    UInt         uiTrDepth,
+                                    UInt         uiAbsPartIdx,
+                                    TComYuv*     pcOrgYuv,
+                                    Int          iNumCand,
+                                    UInt*        puiCandModes,
+                                    Double*      pdCandCosts );
+#endif
+  
   Void  xSetIntraResultQT         ( TComDataCU*  pcCU,
                                     UInt         uiTrDepth,
                                     UInt         uiAbsPartIdx,
@@ -394,6 +434,9 @@ protected:
   // motion estimation
   // -------------------------------------------------------------------------------------------------------------------
   
+  Void xInitRefSearch             ( TEncSearch*   pcSearch,
+                                    TComRdCost*   pcRdCost );
+
   Void xMotionEstimation          ( TComDataCU*   pcCU,
                                     TComYuv*      pcYuvOrg,
                                     Int           iPartIdx,
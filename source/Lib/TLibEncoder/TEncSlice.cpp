@@ -61,6 +61,9 @@ TEncSlice::TEncSlice()
   m_pcBufferBinCoderCABACs  = NULL;
   m_pcBufferLowLatSbacCoders    = NULL;
   m_pcBufferLowLatBinCoderCABACs  = NULL;
+  m_pcWorkers     = NULL;
+  m_pcWppSbacCoders     = NULL;
+  m_pcWppBinCoderCABACs = NULL;
 }
 
 TEncSlice::~TEncSlice()
@@ -96,6 +99,18 @@ Void TEncSlice::create( Int iWidth, Int iHeight, UInt iMaxCUWidth, UInt iMaxCUHe
     m_apcPicYuvResi  = new TComPicYuv;
     m_apcPicYuvResi->create( iWidth, iHeight, iMaxCUWidth, iMaxCUHeight, uhTotalDepth );
   }
+
+  // WPP context storage, one per LCU row
+  if ( m_pcWppSbacCoders == NULL )
+  {
+    UInt uiHeightInLCUs = ( iHeight + iMaxCUHeight - 1 ) / iMaxCUHeight;
+    m_pcWppSbacCoders     = new TEncSbac    [uiHeightInLCUs];
+    m_pcWppBinCoderCABACs = new TEncBinCABAC[uiHeightInLCUs];
+    for ( UInt ui = 0; ui < uiHeightInLCUs; ui++ )
+    {
+      m_pcWppSbacCoders[ui].init( &m_pcWppBinCoderCABACs[ui] );
+    }
+  }
 }
 
 Void TEncSlice::destroy()
@@ -121,6 +136,13 @@ Void TEncSlice::destroy()
   if ( m_pdRdPicQp     ) { xFree( m_pdRdPicQp     ); m_pdRdPicQp     = NULL; }
   if ( m_piRdPicQp     ) { xFree( m_piRdPicQp     ); m_piRdPicQp     = NULL; }
 
+  if ( m_pcWppSbacCoders )
+  {
+    delete[] m_pcWppSbacCoders;
+    delete[] m_pcWppBinCoderCABACs;
+    m_pcWppSbacCoders     = NULL;
+    m_pcWppBinCoderCABACs = NULL;
+  }
   if ( m_pcBufferSbacCoders )
   {
     delete[] m_pcBufferSbacCoders;
@@ -160,6 +182,23 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pdRdPicQp         = (Double*)xMalloc( Double, m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_piRdPicQp         = (Int*   )xMalloc( Int,    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
+  m_pcWorkers         = pcEncTop->getWorker( 0 );
+}
+
+/** wire the slice encoder of an additional frame slot, it compresses a picture concurrently with the master slice encoder
+ * \param pcEncTop       pointer of encoder class
+ * \param pcFrameContext transform, RD cost and search state of the frame slot
+ * \param pcWorkers      tile workers of the frame slot
+ * \note the entropy coders for writing stay shared, encodeSlice() is only called on the master slice encoder
+ */
+Void TEncSlice::initFrameSlot( TEncTop* pcEncTop, TEncFrameContext* pcFrameContext, TEncWorker* pcWorkers )
+{
+  init( pcEncTop );
+  
+  m_pcPredSearch      = pcFrameContext->getPredSearch();
+  m_pcTrQuant         = pcFrameContext->getTrQuant();
+  m_pcRdCost          = pcFrameContext->getRdCost();
+  m_pcWorkers         = pcWorkers;
 }
 
 /**
@@ -804,82 +843,32 @@ Void TEncSlice::calCostSliceI(TComPic*& rpcPic)
 }
 #endif
 
-Void TEncSlice::processTile(TComBitCounter bitCounter, UInt uiEncCUOrder, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice, pthread_mutex_t &lock)
+/** compress one job of compressSlice: the LCUs of a tile
+ * \param pcWorker         private coding objects used by this job
+ * \param uiJob            index of the job in m_jobEncCUOrders
+ * \param rpcPic           picture class
+ * \param uiBoundingCUAddr bounding address of the slice
+ * \param pcSlice          slice to be compressed
+ * \param lock             protects the picture statistics
+ */
+Void TEncSlice::processJob(TEncWorker* pcWorker, UInt uiJob, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice, pthread_mutex_t &lock)
 {
+  UInt uiEncCUOrder = m_jobEncCUOrders[uiJob];
   UInt uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(uiEncCUOrder);
 
-  bitCounter.resetBits();
-
   UInt uiPicTotalBits = 0;
   UInt dPicRdCost = 0;
   UInt uiPicDist = 0;
 
-  TEncTop* pcEncTop = (TEncTop*) m_pcCfg;
-  TEncCu cuEncoder;
-  TEncEntropy* entropyCoder;
-  TEncSbac*** pppcRDSbacCoder;
-  TEncBinCABACCounter*** pppcBinCoderCABAC;
-  TEncSbac* pcRDGoOnSbacCoder;
-  TEncSbac* sbacCoder;
-  TEncBinCABAC* binCABAC;
-
-  pppcRDSbacCoder = new TEncSbac** [g_uiMaxCUDepth+1];
-  pppcBinCoderCABAC = new TEncBinCABACCounter** [g_uiMaxCUDepth+1];
-  for (Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ ) {
-    pppcRDSbacCoder[iDepth] = new TEncSbac* [CI_NUM];
-    pppcBinCoderCABAC[iDepth] = new TEncBinCABACCounter* [CI_NUM];
-    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ ) {
-      pppcRDSbacCoder[iDepth][iCIIdx] = new TEncSbac;
-      pppcBinCoderCABAC[iDepth][iCIIdx] = new TEncBinCABACCounter;
-      pppcRDSbacCoder[iDepth][iCIIdx]->init( pppcBinCoderCABAC[iDepth][iCIIdx] );
-    }
-  }
-
-  entropyCoder = new TEncEntropy;
-  sbacCoder = new TEncSbac;
-  binCABAC = new TEncBinCABAC;
-
-  sbacCoder->init(binCABAC);
-  entropyCoder->setEntropyCoder(sbacCoder, pcSlice);
-  entropyCoder->resetEntropy();
-  pppcRDSbacCoder[0][CI_CURR_BEST]->load(sbacCoder);
-
-  pcRDGoOnSbacCoder = sbacCoder;
-
-  cuEncoder.create(g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight);
-  cuEncoder.init_new(pcEncTop, entropyCoder, pppcRDSbacCoder, pcRDGoOnSbacCoder);
-
   bool first = true;
   for( ; uiEncCUOrder < (uiBoundingCUAddr+(rpcPic->getNumPartInCU()-1))/rpcPic->getNumPartInCU() &&
-         (first || uiCUAddr != rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr())
+         (first || !xIsJobStart(rpcPic, uiCUAddr))
        ; uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(++uiEncCUOrder) )
   {
-    TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );
-    pcCU->initCU( rpcPic, uiCUAddr );
+    xCompressLCU( pcWorker, uiJob, uiCUAddr, first, rpcPic, pcSlice );
+    first = false;
 
-    // if RD based on SBAC is used
-    if( m_pcCfg->getUseSBACRD() )
-    {
-      // set go-on entropy coder
-      entropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder, pcSlice );
-      if (first) {
-        first = false;
-        entropyCoder->resetEntropy();
-      }
-      
-      entropyCoder->setBitstream( &bitCounter );
-      
-      ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag(true);
-
-      // run CU encoder
-      cuEncoder.compressCU( pcCU );
-
-      // restore entropy coder to an initial stage
-      entropyCoder->setEntropyCoder ( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
-      entropyCoder->setBitstream( &bitCounter );
-      cuEncoder.encodeCU( pcCU );
-    }
-   
+    TComDataCU* pcCU = rpcPic->getCU( uiCUAddr );
     uiPicTotalBits += pcCU->getTotalBits();
     dPicRdCost     += pcCU->getTotalCost();
     uiPicDist      += pcCU->getTotalDistortion();
@@ -890,144 +879,456 @@ Void TEncSlice::processTile(TComBitCounter bitCounter, UInt uiEncCUOrder, TComPi
   m_dPicRdCost     += dPicRdCost;
   m_uiPicDist      += uiPicDist;
   pthread_mutex_unlock(&lock);
+}
 
-  // free
-//  cuEncoder.destroy();
-
-  for (Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ ) {
-    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ ) {
-      free(pppcRDSbacCoder[iDepth][iCIIdx]);
-      free(pppcBinCoderCABAC[iDepth][iCIIdx]);
-    }
-    free(pppcRDSbacCoder[iDepth]);
-    free(pppcBinCoderCABAC[iDepth]);
+/** compress the LCU of a WPP job that belongs to one wavefront step
+ * \param uiJob            index of the job in m_jobEncCUOrders, i.e. the LCU row within the slice
+ * \param uiCol            LCU column of the step in this row
+ * \param rpcPic           picture class
+ * \param uiBoundingCUAddr bounding address of the slice
+ * \param pcSlice          slice to be compressed
+ * \param lock             protects the picture statistics
+ */
+Void TEncSlice::processWppStep(UInt uiJob, UInt uiCol, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice, pthread_mutex_t &lock)
+{
+  UInt uiWidthInLCUs = rpcPic->getPicSym()->getFrameWidthInCU();
+  UInt uiFirstCol = rpcPic->getPicSym()->getCUOrderMap(m_jobEncCUOrders[uiJob]) % uiWidthInLCUs;
+  if ( uiCol < uiFirstCol )
+  {
+    return;
   }
-  free(pppcRDSbacCoder);
-  free(pppcBinCoderCABAC);
+  UInt uiEncCUOrder = m_jobEncCUOrders[uiJob] + uiCol - uiFirstCol;
+  if ( uiEncCUOrder >= (uiBoundingCUAddr+(rpcPic->getNumPartInCU()-1))/rpcPic->getNumPartInCU() )
+  {
+    return;
+  }
+  UInt uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(uiEncCUOrder);
+
+  // the rows active in one step are consecutive and fewer than the workers, so they never share one
+  xCompressLCU( &m_pcWorkers[uiJob % ((TEncTop*)m_pcCfg)->getNumWorkers()], uiJob, uiCUAddr, uiCol == uiFirstCol, rpcPic, pcSlice );
 
-  free(entropyCoder);
-  free(sbacCoder);
-  free(binCABAC);
+  TComDataCU* pcCU = rpcPic->getCU( uiCUAddr );
+  pthread_mutex_lock(&lock);
+  m_uiPicTotalBits += pcCU->getTotalBits();
+  m_dPicRdCost     += pcCU->getTotalCost();
+  m_uiPicDist      += pcCU->getTotalDistortion();
+  pthread_mutex_unlock(&lock);
 }
 
-Void TEncSlice::compressSlice( TComPic*& rpcPic )
+/** compress one LCU on the coding objects of a worker
+ * \param pcWorker private coding objects used by the job
+ * \param uiJob    index of the job in m_jobEncCUOrders
+ * \param uiCUAddr raster address of the LCU
+ * \param bFirst   first LCU of the job: the worker is reset, and with WPP synchronized with the row above
+ * \param rpcPic   picture class
+ * \param pcSlice  slice to be compressed
+ */
+Void TEncSlice::xCompressLCU( TEncWorker* pcWorker, UInt uiJob, UInt uiCUAddr, Bool bFirst, TComPic*& rpcPic, TComSlice* pcSlice )
 {
-  UInt  uiCUAddr;
-  UInt  uiStartCUAddr;
-  UInt  uiBoundingCUAddr;
-  rpcPic->getSlice(getSliceIdx())->setSliceSegmentBits(0);
-  TComSlice* pcSlice            = rpcPic->getSlice(getSliceIdx());
-  xDetermineStartAndBoundingCUAddr ( uiStartCUAddr, uiBoundingCUAddr, rpcPic, false );
-  
-  // initialize cost values
-  m_uiPicTotalBits  = 0;
-  m_dPicRdCost      = 0;
-  m_uiPicDist       = 0;
-  
-  // set entropy coder
-  if( m_pcCfg->getUseSBACRD() )
+  UInt uiWidthInLCUs = rpcPic->getPicSym()->getFrameWidthInCU();
+  UInt uiCol = uiCUAddr % uiWidthInLCUs;
+
+  TEncCu* cuEncoder = pcWorker->getCuEncoder();
+  TEncEntropy* entropyCoder = pcWorker->getEntropyCoder();
+  TComBitCounter* bitCounter = pcWorker->getBitCounter();
+  TEncSbac*** pppcRDSbacCoder = pcWorker->getRDSbacCoder();
+  TEncSbac* pcRDGoOnSbacCoder = pcWorker->getRDGoOnSbacCoder();
+
+  if ( bFirst )
   {
-    m_pcSbacCoder->init( m_pcBinCABAC );
-    m_pcEntropyCoder->setEntropyCoder   ( m_pcSbacCoder, pcSlice );
-    m_pcEntropyCoder->resetEntropy      ();
-    m_pppcRDSbacCoder[0][CI_CURR_BEST]->load(m_pcSbacCoder);
+    // the worker owns all the coders, only their state is reset here
+    pcWorker->initTile( pcSlice, m_pcTrQuant, m_pcRdCost, m_pcPredSearch );
   }
-  else
+
+  TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );
+  pcCU->initCU( rpcPic, uiCUAddr );
+
+  // if RD based on SBAC is used
+  if( m_pcCfg->getUseSBACRD() )
   {
-    m_pcEntropyCoder->setEntropyCoder ( m_pcCavlcCoder, pcSlice );
-    m_pcEntropyCoder->resetEntropy      ();
-    m_pcEntropyCoder->setBitstream    ( m_pcBitCounter );
+    // set go-on entropy coder
+    entropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder, pcSlice );
+    if ( bFirst )
+    {
+      entropyCoder->resetEntropy();
+
+      // WPP: synchronize with the contexts stored after the second LCU of the row above if it is in the slice
+      if ( m_pcCfg->getWaveFrontsynchro() && uiJob > 0 && uiWidthInLCUs > 1 &&
+           rpcPic->getPicSym()->getCUOrderMap(m_jobEncCUOrders[uiJob-1]) % uiWidthInLCUs <= 1 )
+      {
+        pppcRDSbacCoder[0][CI_CURR_BEST]->loadContexts( &m_pcWppSbacCoders[uiJob-1] );
+      }
+    }
+
+    entropyCoder->setBitstream( bitCounter );
+
+    ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag(true);
+
+    // run CU encoder
+    cuEncoder->compressCU( pcCU );
+
+    // restore entropy coder to an initial stage
+    entropyCoder->setEntropyCoder ( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+    entropyCoder->setBitstream( bitCounter );
+    cuEncoder->encodeCU( pcCU );
+
+    // store the contexts after the second LCU of the row for the row below
+    if ( m_pcCfg->getWaveFrontsynchro() && uiCol == 1 )
+    {
+      m_pcWppSbacCoders[uiJob].loadContexts( pppcRDSbacCoder[0][CI_CURR_BEST] );
+    }
   }
-  
-  TEncTop* pcEncTop = (TEncTop*) m_pcCfg;
-  TEncSbac**** ppppcRDSbacCoders    = pcEncTop->getRDSbacCoders();
-  TComBitCounter* pcBitCounters     = pcEncTop->getBitCounters();
-  Int  iNumSubstreams = 1;
-  UInt uiTilesAcross  = 0;
+}
 
-  if( m_pcCfg->getUseSBACRD() )
+/** write the SAO syntax and the coding tree of one LCU
+ * \param pcEntropyCoder entropy coder bound to the substream of the LCU
+ * \param pcCuEncoder    CU encoder writing through pcEntropyCoder
+ * \param rpcPic         picture class
+ * \param pcSlice        slice to be encoded
+ * \param uiCUAddr       raster address of the LCU
+ */
+Void TEncSlice::xEncodeLCU( TEncEntropy* pcEntropyCoder, TEncCu* pcCuEncoder, TComPic*& rpcPic, TComSlice* pcSlice, UInt uiCUAddr )
+{
+  TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );
+  if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
   {
-    iNumSubstreams = pcSlice->getPPS()->getNumSubstreams();
-    uiTilesAcross = rpcPic->getPicSym()->getNumColumnsMinus1()+1;
-    delete[] m_pcBufferSbacCoders;
-    delete[] m_pcBufferBinCoderCABACs;
-    m_pcBufferSbacCoders     = new TEncSbac    [uiTilesAcross];
-    m_pcBufferBinCoderCABACs = new TEncBinCABAC[uiTilesAcross];
-    for (Int ui = 0; ui < uiTilesAcross; ui++)
+    SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
+    Int iNumCuInWidth     = saoParam->numCuInWidth;
+    Int iCUAddrInSlice    = uiCUAddr - rpcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/rpcPic->getNumPartInCU());
+    Int iCUAddrUpInSlice  = iCUAddrInSlice - iNumCuInWidth;
+    Int rx = uiCUAddr % iNumCuInWidth;
+    Int ry = uiCUAddr / iNumCuInWidth;
+    Int allowMergeLeft = 1;
+    Int allowMergeUp   = 1;
+    if (rx!=0)
     {
-      m_pcBufferSbacCoders[ui].init( &m_pcBufferBinCoderCABACs[ui] );
+      if (rpcPic->getPicSym()->getTileIdxMap(uiCUAddr-1) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))
+      {
+        allowMergeLeft = 0;
+      }
     }
-    for (UInt ui = 0; ui < uiTilesAcross; ui++)
+    if (ry!=0)
     {
-      m_pcBufferSbacCoders[ui].load(m_pppcRDSbacCoder[0][CI_CURR_BEST]);  //init. state
+      if (rpcPic->getPicSym()->getTileIdxMap(uiCUAddr-iNumCuInWidth) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))
+      {
+        allowMergeUp = 0;
+      }
     }
+    Int addr = pcCU->getAddr();
+    allowMergeLeft = allowMergeLeft && (rx>0) && (iCUAddrInSlice!=0);
+    allowMergeUp = allowMergeUp && (ry>0) && (iCUAddrUpInSlice>=0);
+    if( saoParam->bSaoFlag[0] || saoParam->bSaoFlag[1] )
+    {
+      Int mergeLeft = saoParam->saoLcuParam[0][addr].mergeLeftFlag;
+      Int mergeUp = saoParam->saoLcuParam[0][addr].mergeUpFlag;
+      if (allowMergeLeft)
+      {
+        pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeLeft); 
+      }
+      else
+      {
+        mergeLeft = 0;
+      }
+      if(mergeLeft == 0)
+      {
+        if (allowMergeUp)
+        {
+          pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeUp);
+        }
+        else
+        {
+          mergeUp = 0;
+        }
+        if(mergeUp == 0)
+        {
+          for (Int compIdx=0;compIdx<3;compIdx++)
+          {
+          if( (compIdx == 0 && saoParam->bSaoFlag[0]) || (compIdx > 0 && saoParam->bSaoFlag[1]))
+            {
+              pcEntropyCoder->encodeSaoOffset(&saoParam->saoLcuParam[compIdx][addr], compIdx);
+            }
+          }
+        }
+      }
+    }
+  }
+  else if (pcSlice->getSPS()->getUseSAO())
+  {
+    Int addr = pcCU->getAddr();
+    SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
+    for (Int cIdx=0; cIdx<3; cIdx++)
+    {
+      SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
+      if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
+      {
+        saoLcuParam->mergeUpFlag   = 0;
+        saoLcuParam->mergeLeftFlag = 0;
+        saoLcuParam->subTypeIdx    = 0;
+        saoLcuParam->typeIdx       = -1;
+        saoLcuParam->offset[0]     = 0;
+        saoLcuParam->offset[1]     = 0;
+        saoLcuParam->offset[2]     = 0;
+        saoLcuParam->offset[3]     = 0;
+      }
+    }
+  }
+#if ENC_DEC_TRACE
+  g_bJustDoIt = g_bEncDecTraceEnable;
+#endif
+  pcCuEncoder->encodeCU( pcCU );
+#if ENC_DEC_TRACE
+  g_bJustDoIt = g_bEncDecTraceDisable;
+#endif
+}
+
+/** write the substreams of a slice concurrently, used with tiles or WPP when dependent slice segments are disabled
+ * \param rpcPic           picture class
+ * \param pcSlice          slice to be encoded
+ * \param pcSubstreams     one bitstream per substream
+ * \param uiStartCUAddr    start address of the slice segment
+ * \param uiBoundingCUAddr bounding address of the slice segment
+ * \note every substream has its own CABAC engine in TEncTop::getSbacCoders(), the entry points are still derived from
+ *       the substream sizes by TEncGOP. The master entropy coder ends up in the state of the last substream, as with the
+ *       sequential writing
+ */
+Void TEncSlice::xEncodeSubstreams( TComPic*& rpcPic, TComSlice* pcSlice, TComOutputBitstream* pcSubstreams, UInt uiStartCUAddr, UInt uiBoundingCUAddr )
+{
+  TEncSbac* pcSbacCoders = ((TEncTop*)m_pcCfg)->getSbacCoders();
+  UInt uiNumJobs = xDetermineJobs( rpcPic, uiStartCUAddr, uiBoundingCUAddr );
 
-    for ( UInt ui = 0 ; ui < iNumSubstreams ; ui++ ) //init all sbac coders for RD optimization
+  // state of the first substream of each job before writing, needed for the tile locations
+  std::vector<UInt> auiBitsBefore( uiNumJobs );
+  std::vector<UInt> auiEmulationsBefore( uiNumJobs );
+  for ( UInt i = 0; i < uiNumJobs; i++ )
+  {
+    UInt uiSubStrm = xGetSubstream( rpcPic, pcSlice, rpcPic->getPicSym()->getCUOrderMap(m_jobEncCUOrders[i]) );
+    auiBitsBefore[i]       = pcSubstreams[uiSubStrm].getNumberOfWrittenBits();
+    auiEmulationsBefore[i] = pcSubstreams[uiSubStrm].countStartCodeEmulations();
+  }
+
+  if ( m_pcCfg->getWaveFrontsynchro() )
+  {
+    // same wavefront as in compressSlice: the LCU in column c of row j is written in step c+2j
+    assert( rpcPic->getPicSym()->getNumColumnsMinus1() == 0 && rpcPic->getPicSym()->getNumRowsMinus1() == 0 );
+    UInt uiWidthInLCUs = rpcPic->getPicSym()->getFrameWidthInCU();
+    UInt uiNumSteps = uiWidthInLCUs + 2*(uiNumJobs-1);
+    for ( UInt uiStep = 0; uiStep < uiNumSteps; uiStep++ )
     {
-      ppppcRDSbacCoders[ui][0][CI_CURR_BEST]->load(m_pppcRDSbacCoder[0][CI_CURR_BEST]);
+      UInt uiFirstJob = uiStep < uiWidthInLCUs ? 0 : (uiStep - uiWidthInLCUs)/2 + 1;
+      UInt uiLastJob  = std::min( uiStep/2, uiNumJobs-1 );
+      cilk_for (UInt i = uiFirstJob; i <= uiLastJob; i++) {
+        xEncodeWppStep(i, uiStep - 2*i, rpcPic, uiBoundingCUAddr, pcSlice, pcSubstreams);
+      }
     }
   }
-  //if( m_pcCfg->getUseSBACRD() )
+  else
   {
-    delete[] m_pcBufferLowLatSbacCoders;
-    delete[] m_pcBufferLowLatBinCoderCABACs;
-    m_pcBufferLowLatSbacCoders     = new TEncSbac    [uiTilesAcross];
-    m_pcBufferLowLatBinCoderCABACs = new TEncBinCABAC[uiTilesAcross];
-    for (Int ui = 0; ui < uiTilesAcross; ui++)
+    // jobs are tiles, each one has a single substream
+    assert( uiNumJobs <= ((TEncTop*)m_pcCfg)->getNumWorkers() );
+    cilk_for (UInt i = 0; i < uiNumJobs; i++) {
+      xEncodeJob(&m_pcWorkers[i], i, rpcPic, uiBoundingCUAddr, pcSlice, pcSubstreams);
+    }
+
+    // a tile starts after the bits written into the substreams of the tiles before it
+    UInt uiAccumulatedSubstreamLength = 0;
+    for ( UInt i = 1; i < uiNumJobs; i++ )
     {
-      m_pcBufferLowLatSbacCoders[ui].init( &m_pcBufferLowLatBinCoderCABACs[ui] );
+      UInt uiSubStrm = xGetSubstream( rpcPic, pcSlice, rpcPic->getPicSym()->getCUOrderMap(m_jobEncCUOrders[i-1]) );
+      uiAccumulatedSubstreamLength += pcSubstreams[uiSubStrm].getNumberOfWrittenBits() - auiBitsBefore[i-1];
+      pcSlice->addTileLocation( ((pcSlice->getTileOffstForMultES() + uiAccumulatedSubstreamLength) >> 3) + auiEmulationsBefore[i] );
     }
-    for (UInt ui = 0; ui < uiTilesAcross; ui++)
-      m_pcBufferLowLatSbacCoders[ui].load(m_pppcRDSbacCoder[0][CI_CURR_BEST]);  //init. state
   }
-  UInt uiWidthInLCUs  = rpcPic->getPicSym()->getFrameWidthInCU();
-  //UInt uiHeightInLCUs = rpcPic->getPicSym()->getFrameHeightInCU();
-  UInt uiSubStrm=0;
-  UInt uiTileStartLCU = 0;
-  Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
-  uiCUAddr = rpcPic->getPicSym()->getCUOrderMap( uiStartCUAddr /rpcPic->getNumPartInCU());
-  uiTileStartLCU = rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr();
 
-  // initialize partition order.
-  UInt* piTmp = &g_auiZscanToRaster[0];
-  initZscanToRaster( g_uiMaxCUDepth + 1, 1, 0, piTmp);
-  initRasterToZscan( g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth + 1 );
-          
-  // initialize conversion matrix from partition index to pel
-  initRasterToPelXY( g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth + 1 );
+  UInt uiLastCUAddr = rpcPic->getPicSym()->getCUOrderMap( (uiBoundingCUAddr+rpcPic->getNumPartInCU()-1)/rpcPic->getNumPartInCU()-1 );
+  UInt uiLastSubStrm = xGetSubstream( rpcPic, pcSlice, uiLastCUAddr );
+  m_pcSbacCoder->load( &pcSbacCoders[uiLastSubStrm] );
+  m_pcEntropyCoder->setBitstream( &pcSubstreams[uiLastSubStrm] );
+}
 
-  // for every CU in slice
-  pthread_mutex_t lock;
-  UInt uiEncCUOrder;
-  Int tileNum = 0;
-  UInt numTiles = (rpcPic->getPicSym()->getNumColumnsMinus1()+1) * (rpcPic->getPicSym()->getNumRowsMinus1()+1);
-  UInt* tile_uiEncCUOrders;
-  TComBitCounter* bitCounters;
+/** write the LCUs of a tile job into its substream
+ * \param pcWorker         worker whose entropy and CU encoders write the job
+ * \param uiJob            index of the job in m_jobEncCUOrders
+ * \param rpcPic           picture class
+ * \param uiBoundingCUAddr bounding address of the slice segment
+ * \param pcSlice          slice to be encoded
+ * \param pcSubstreams     one bitstream per substream
+ */
+Void TEncSlice::xEncodeJob( TEncWorker* pcWorker, UInt uiJob, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice, TComOutputBitstream* pcSubstreams )
+{
+  UInt uiEncCUOrder = m_jobEncCUOrders[uiJob];
+  UInt uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(uiEncCUOrder);
+  Bool bFirst = true;
+  for( ; uiEncCUOrder < (uiBoundingCUAddr+(rpcPic->getNumPartInCU()-1))/rpcPic->getNumPartInCU() &&
+         (bFirst || !xIsJobStart(rpcPic, uiCUAddr))
+       ; uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(++uiEncCUOrder) )
+  {
+    xEncodeSubstreamLCU( pcWorker, uiJob, uiCUAddr, bFirst, rpcPic, pcSlice, pcSubstreams );
+    bFirst = false;
+  }
+}
+
+/** write the LCU of a WPP job that belongs to one wavefront step
+ * \param uiJob            index of the job in m_jobEncCUOrders, i.e. the LCU row within the slice segment
+ * \param uiCol            LCU column of the step in this row
+ * \param rpcPic           picture class
+ * \param uiBoundingCUAddr bounding address of the slice segment
+ * \param pcSlice          slice to be encoded
+ * \param pcSubstreams     one bitstream per substream
+ */
+Void TEncSlice::xEncodeWppStep( UInt uiJob, UInt uiCol, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice, TComOutputBitstream* pcSubstreams )
+{
+  UInt uiWidthInLCUs = rpcPic->getPicSym()->getFrameWidthInCU();
+  UInt uiFirstCol = rpcPic->getPicSym()->getCUOrderMap(m_jobEncCUOrders[uiJob]) % uiWidthInLCUs;
+  if ( uiCol < uiFirstCol )
+  {
+    return;
+  }
+  UInt uiEncCUOrder = m_jobEncCUOrders[uiJob] + uiCol - uiFirstCol;
+  if ( uiEncCUOrder >= (uiBoundingCUAddr+(rpcPic->getNumPartInCU()-1))/rpcPic->getNumPartInCU() )
+  {
+    return;
+  }
+  UInt uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(uiEncCUOrder);
 
-  bitCounters = new TComBitCounter[numTiles];
-  tile_uiEncCUOrders = new UInt[numTiles];
+  xEncodeSubstreamLCU( &m_pcWorkers[uiJob % ((TEncTop*)m_pcCfg)->getNumWorkers()], uiJob, uiCUAddr, uiCol == uiFirstCol, rpcPic, pcSlice, pcSubstreams );
+}
 
-  pthread_mutex_init(&lock, NULL);
-  for( uiEncCUOrder = uiStartCUAddr/rpcPic->getNumPartInCU();
+/** write one LCU into its substream with the CABAC engine of the substream
+ * \param pcWorker     worker whose entropy and CU encoders write the LCU
+ * \param uiJob        index of the job in m_jobEncCUOrders
+ * \param uiCUAddr     raster address of the LCU
+ * \param bFirst       first LCU of the job: with WPP the contexts are synchronized with the row above
+ * \param rpcPic       picture class
+ * \param pcSlice      slice to be encoded
+ * \param pcSubstreams one bitstream per substream
+ */
+Void TEncSlice::xEncodeSubstreamLCU( TEncWorker* pcWorker, UInt uiJob, UInt uiCUAddr, Bool bFirst, TComPic*& rpcPic, TComSlice* pcSlice, TComOutputBitstream* pcSubstreams )
+{
+  UInt uiWidthInLCUs = rpcPic->getPicSym()->getFrameWidthInCU();
+  UInt uiSubStrm = xGetSubstream( rpcPic, pcSlice, uiCUAddr );
+  TEncSbac* pcSbacCoder = &((TEncTop*)m_pcCfg)->getSbacCoders()[uiSubStrm];
+  TEncEntropy* entropyCoder = pcWorker->getEntropyCoder();
+  TEncCu* cuEncoder = pcWorker->getCuEncoder();
+
+  entropyCoder->setEntropyCoder( pcSbacCoder, pcSlice );
+  entropyCoder->setBitstream( &pcSubstreams[uiSubStrm] );
+
+  // WPP: synchronize with the contexts stored after the second LCU of the row above if it is in the slice
+  if ( bFirst && m_pcCfg->getWaveFrontsynchro() && uiJob > 0 && uiWidthInLCUs > 1 &&
+       rpcPic->getPicSym()->getCUOrderMap(m_jobEncCUOrders[uiJob-1]) % uiWidthInLCUs <= 1 )
+  {
+    pcSbacCoder->loadContexts( &m_pcWppSbacCoders[uiJob-1] );
+  }
+
+  // no slice end is searched for while writing
+  cuEncoder->setBitCounter( NULL );
+  xEncodeLCU( entropyCoder, cuEncoder, rpcPic, pcSlice, uiCUAddr );
+  cuEncoder->setBitCounter( pcWorker->getBitCounter() );
+
+  // store the contexts after the second LCU of the row for the row below
+  if ( m_pcCfg->getWaveFrontsynchro() && uiCUAddr % uiWidthInLCUs == 1 )
+  {
+    m_pcWppSbacCoders[uiJob].loadContexts( pcSbacCoder );
+  }
+}
+
+/** substream of an LCU
+ * \param pcPic    picture class
+ * \param pcSlice  slice of the LCU
+ * \param uiCUAddr raster address of the LCU
+ * \returns index of the substream, substreams are per tile and with WPP per LCU row of the tile
+ */
+UInt TEncSlice::xGetSubstream( TComPic* pcPic, TComSlice* pcSlice, UInt uiCUAddr )
+{
+  Int iNumSubstreamsPerTile = pcSlice->getPPS()->getNumSubstreams()/pcPic->getPicSym()->getNumTiles();
+  UInt uiLin = uiCUAddr / pcPic->getPicSym()->getFrameWidthInCU();
+  return pcPic->getPicSym()->getTileIdxMap(uiCUAddr)*iNumSubstreamsPerTile + uiLin%iNumSubstreamsPerTile;
+}
+
+/** split the LCUs of a slice into jobs, the result is stored in m_jobEncCUOrders
+ * \param rpcPic           picture class
+ * \param uiStartCUAddr    start address of the slice
+ * \param uiBoundingCUAddr bounding address of the slice
+ * \returns number of jobs
+ */
+UInt TEncSlice::xDetermineJobs( TComPic*& rpcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr )
+{
+  m_jobEncCUOrders.clear();
+  for( UInt uiEncCUOrder = uiStartCUAddr/rpcPic->getNumPartInCU();
        uiEncCUOrder < (uiBoundingCUAddr+(rpcPic->getNumPartInCU()-1))/rpcPic->getNumPartInCU();
-       uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(++uiEncCUOrder) )
+       uiEncCUOrder++ )
   {
-    if( uiCUAddr == rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr())                                    // must be first CU of tile
+    if( uiEncCUOrder == uiStartCUAddr/rpcPic->getNumPartInCU() || xIsJobStart( rpcPic, rpcPic->getPicSym()->getCUOrderMap(uiEncCUOrder) ) )
     {
-      tile_uiEncCUOrders[tileNum++] = uiEncCUOrder;
-      //cilk_spawn processTile(tileNum++, uiEncCUOrder, rpcPic, uiBoundingCUAddr, pcSlice, lock);
+      m_jobEncCUOrders.push_back( uiEncCUOrder );
     }
   }
+  return (UInt)m_jobEncCUOrders.size();
+}
 
-  cilk_for (UInt i = 0; i < numTiles; i++) {
-    processTile(bitCounters[i], tile_uiEncCUOrders[i], rpcPic, uiBoundingCUAddr, pcSlice, lock);
+/** check whether a job of compressSlice or encodeSlice starts at an LCU
+ * \param pcPic    picture class
+ * \param uiCUAddr raster address of the LCU
+ * \returns true for the first LCU of a tile, or with WPP for the first LCU of a row inside a tile
+ */
+Bool TEncSlice::xIsJobStart( TComPic* pcPic, UInt uiCUAddr )
+{
+  TComTile* pcTile = pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(uiCUAddr));
+  if ( m_pcCfg->getWaveFrontsynchro() )
+  {
+    UInt uiWidthInLCUs = pcPic->getPicSym()->getFrameWidthInCU();
+    return uiCUAddr % uiWidthInLCUs == pcTile->getFirstCUAddr() % uiWidthInLCUs;
   }
+  return uiCUAddr == pcTile->getFirstCUAddr();
+}
 
-  //free(bitCounters);
-  free(tile_uiEncCUOrders);
+Void TEncSlice::compressSlice( TComPic*& rpcPic )
+{
+  UInt  uiStartCUAddr;
+  UInt  uiBoundingCUAddr;
+  rpcPic->getSlice(getSliceIdx())->setSliceSegmentBits(0);
+  TComSlice* pcSlice            = rpcPic->getSlice(getSliceIdx());
+  xDetermineStartAndBoundingCUAddr ( uiStartCUAddr, uiBoundingCUAddr, rpcPic, false );
+  
+  // initialize cost values
+  m_uiPicTotalBits  = 0;
+  m_dPicRdCost      = 0;
+  m_uiPicDist       = 0;
+  
+  // the entropy coders of the workers are reset per job, the master coders are not touched so that
+  // several slice encoders can compress pictures concurrently
+  UInt uiWidthInLCUs  = rpcPic->getPicSym()->getFrameWidthInCU();
+  Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
 
-  //cilk_sync;
-  m_pcEntropyCoder->setBitstream( &pcBitCounters[uiSubStrm] );
+  // for every CU in slice
+  pthread_mutex_t lock;
+  UInt uiNumJobs = xDetermineJobs( rpcPic, uiStartCUAddr, uiBoundingCUAddr );
+
+  pthread_mutex_init(&lock, NULL);
+  if ( m_pcCfg->getWaveFrontsynchro() )
+  {
+    // jobs are the LCU rows of the slice (WPP excludes tiles). The LCU in column c of row j is compressed in step
+    // c+2j, so its left, above and above-right neighbours belong to earlier steps and the LCUs of a step are
+    // independent: no job ever waits for another one
+    assert( rpcPic->getPicSym()->getNumColumnsMinus1() == 0 && rpcPic->getPicSym()->getNumRowsMinus1() == 0 );
+    UInt uiNumSteps = uiWidthInLCUs + 2*(uiNumJobs-1);
+    for ( UInt uiStep = 0; uiStep < uiNumSteps; uiStep++ )
+    {
+      UInt uiFirstJob = uiStep < uiWidthInLCUs ? 0 : (uiStep - uiWidthInLCUs)/2 + 1;
+      UInt uiLastJob  = std::min( uiStep/2, uiNumJobs-1 );
+      cilk_for (UInt i = uiFirstJob; i <= uiLastJob; i++) {
+        processWppStep(i, uiStep - 2*i, rpcPic, uiBoundingCUAddr, pcSlice, lock);
+      }
+    }
+  }
+  else
+  {
+    // jobs are tiles, which are independent
+    assert( uiNumJobs <= ((TEncTop*)m_pcCfg)->getNumWorkers() );
+    cilk_for (UInt i = 0; i < uiNumJobs; i++) {
+      processJob(&m_pcWorkers[i], i, rpcPic, uiBoundingCUAddr, pcSlice, lock);
+    }
+  }
   pthread_mutex_destroy(&lock);
 
   if ((pcSlice->getPPS()->getNumSubstreams() > 1) && !depSliceSegmentsEnabled)
@@ -1083,6 +1384,19 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
   UInt uiBitsOriginallyInSubstreams = 0;
   {
     UInt uiTilesAcross = rpcPic->getPicSym()->getNumColumnsMinus1()+1;
+    delete[] m_pcBufferSbacCoders;
+    delete[] m_pcBufferBinCoderCABACs;
+    m_pcBufferSbacCoders     = new TEncSbac    [uiTilesAcross];
+    m_pcBufferBinCoderCABACs = new TEncBinCABAC[uiTilesAcross];
+    delete[] m_pcBufferLowLatSbacCoders;
+    delete[] m_pcBufferLowLatBinCoderCABACs;
+    m_pcBufferLowLatSbacCoders     = new TEncSbac    [uiTilesAcross];
+    m_pcBufferLowLatBinCoderCABACs = new TEncBinCABAC[uiTilesAcross];
+    for (UInt ui = 0; ui < uiTilesAcross; ui++)
+    {
+      m_pcBufferSbacCoders[ui].init( &m_pcBufferBinCoderCABACs[ui] );
+      m_pcBufferLowLatSbacCoders[ui].init( &m_pcBufferLowLatBinCoderCABACs[ui] );
+    }
     for (UInt ui = 0; ui < uiTilesAcross; ui++)
     {
       m_pcBufferSbacCoders[ui].load(m_pcSbacCoder); //init. state
@@ -1144,208 +1458,123 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
     }
   }
 
-  UInt uiEncCUOrder;
-  for( uiEncCUOrder = uiStartCUAddr /rpcPic->getNumPartInCU();
-       uiEncCUOrder < (uiBoundingCUAddr+rpcPic->getNumPartInCU()-1)/rpcPic->getNumPartInCU();
-       uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(++uiEncCUOrder) )
+  Bool bParallelSubstreams = m_pcCfg->getUseSBACRD() && iNumSubstreams > 1 && !depSliceSegmentsEnabled;
+#if ENC_DEC_TRACE
+  bParallelSubstreams = false; // the trace is written in coding order
+#endif
+  if( bParallelSubstreams )
   {
-    if( m_pcCfg->getUseSBACRD() )
-    {
-      uiTileCol = rpcPic->getPicSym()->getTileIdxMap(uiCUAddr) % (rpcPic->getPicSym()->getNumColumnsMinus1()+1); // what column of tiles are we in?
-      uiTileStartLCU = rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr();
-      uiTileLCUX = uiTileStartLCU % uiWidthInLCUs;
-      //UInt uiSliceStartLCU = pcSlice->getSliceCurStartCUAddr();
-      uiCol     = uiCUAddr % uiWidthInLCUs;
-      uiLin     = uiCUAddr / uiWidthInLCUs;
-      if (pcSlice->getPPS()->getNumSubstreams() > 1)
-      {
-        // independent tiles => substreams are "per tile".  iNumSubstreams has already been multiplied.
-        Int iNumSubstreamsPerTile = iNumSubstreams/rpcPic->getPicSym()->getNumTiles();
-        uiSubStrm = rpcPic->getPicSym()->getTileIdxMap(uiCUAddr)*iNumSubstreamsPerTile
-                      + uiLin%iNumSubstreamsPerTile;
-      }
-      else
-      {
-        // dependent tiles => substreams are "per frame".
-        uiSubStrm = uiLin % iNumSubstreams;
-      }
-
-      m_pcEntropyCoder->setBitstream( &pcSubstreams[uiSubStrm] );
-      // Synchronize cabac probabilities with upper-right LCU if it's available and we're at the start of a line.
-      if (((pcSlice->getPPS()->getNumSubstreams() > 1) || depSliceSegmentsEnabled) && (uiCol == uiTileLCUX) && m_pcCfg->getWaveFrontsynchro())
-      {
-        // We'll sync if the TR is available.
-        TComDataCU *pcCUUp = rpcPic->getCU( uiCUAddr )->getCUAbove();
-        UInt uiWidthInCU = rpcPic->getFrameWidthInCU();
-        UInt uiMaxParts = 1<<(pcSlice->getSPS()->getMaxCUDepth()<<1);
-        TComDataCU *pcCUTR = NULL;
-        if ( pcCUUp && ((uiCUAddr%uiWidthInCU+1) < uiWidthInCU)  )
-        {
-          pcCUTR = rpcPic->getCU( uiCUAddr - uiWidthInCU + 1 );
-        }
-        if ( (true/*bEnforceSliceRestriction*/ &&
-             ((pcCUTR==NULL) || (pcCUTR->getSlice()==NULL) || 
-             (pcCUTR->getSCUAddr()+uiMaxParts-1 < pcSlice->getSliceCurStartCUAddr()) ||
-             ((rpcPic->getPicSym()->getTileIdxMap( pcCUTR->getAddr() ) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr)))
-             ))
-           )
-        {
-          // TR not available.
-        }
-        else
-        {
-          // TR is available, we use it.
-          pcSbacCoders[uiSubStrm].loadContexts( &m_pcBufferSbacCoders[uiTileCol] );
-        }
-      }
-      m_pcSbacCoder->load(&pcSbacCoders[uiSubStrm]);  //this load is used to simplify the code (avoid to change all the call to m_pcSbacCoder)
-    }
-    // reset the entropy coder
-    if( uiCUAddr == rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr() &&                                   // must be first CU of tile
-        uiCUAddr!=0 &&                                                                                                                                    // cannot be first CU of picture
-        uiCUAddr!=rpcPic->getPicSym()->getPicSCUAddr(rpcPic->getSlice(rpcPic->getCurrSliceIdx())->getSliceSegmentCurStartCUAddr())/rpcPic->getNumPartInCU() &&
-        uiCUAddr!=rpcPic->getPicSym()->getPicSCUAddr(rpcPic->getSlice(rpcPic->getCurrSliceIdx())->getSliceCurStartCUAddr())/rpcPic->getNumPartInCU())     // cannot be first CU of slice
+    // independent substreams: each one is written by its own CABAC engine, concurrently with the others
+    xEncodeSubstreams( rpcPic, pcSlice, pcSubstreams, uiStartCUAddr, uiBoundingCUAddr );
+  }
+  else
+  {
+    UInt uiEncCUOrder;
+    for( uiEncCUOrder = uiStartCUAddr /rpcPic->getNumPartInCU();
+         uiEncCUOrder < (uiBoundingCUAddr+rpcPic->getNumPartInCU()-1)/rpcPic->getNumPartInCU();
+         uiCUAddr = rpcPic->getPicSym()->getCUOrderMap(++uiEncCUOrder) )
     {
+      if( m_pcCfg->getUseSBACRD() )
       {
-        // We're crossing into another tile, tiles are independent.
-        // When tiles are independent, we have "substreams per tile".  Each substream has already been terminated, and we no longer
-        // have to perform it here.
+        uiTileCol = rpcPic->getPicSym()->getTileIdxMap(uiCUAddr) % (rpcPic->getPicSym()->getNumColumnsMinus1()+1); // what column of tiles are we in?
+        uiTileStartLCU = rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr();
+        uiTileLCUX = uiTileStartLCU % uiWidthInLCUs;
+        //UInt uiSliceStartLCU = pcSlice->getSliceCurStartCUAddr();
+        uiCol     = uiCUAddr % uiWidthInLCUs;
+        uiLin     = uiCUAddr / uiWidthInLCUs;
         if (pcSlice->getPPS()->getNumSubstreams() > 1)
         {
-          ; // do nothing.
+          // independent tiles => substreams are "per tile".  iNumSubstreams has already been multiplied.
+          Int iNumSubstreamsPerTile = iNumSubstreams/rpcPic->getPicSym()->getNumTiles();
+          uiSubStrm = rpcPic->getPicSym()->getTileIdxMap(uiCUAddr)*iNumSubstreamsPerTile
+                        + uiLin%iNumSubstreamsPerTile;
         }
         else
         {
-          SliceType sliceType  = pcSlice->getSliceType();
-          if (!pcSlice->isIntra() && pcSlice->getPPS()->getCabacInitPresentFlag() && pcSlice->getPPS()->getEncCABACTableIdx()!=I_SLICE)
-          {
-            sliceType = (SliceType) pcSlice->getPPS()->getEncCABACTableIdx();
-          }
-          m_pcEntropyCoder->updateContextTables( sliceType, pcSlice->getSliceQp() );
-          // Byte-alignment in slice_data() when new tile
-          pcSubstreams[uiSubStrm].writeByteAlignment();
+          // dependent tiles => substreams are "per frame".
+          uiSubStrm = uiLin % iNumSubstreams;
         }
-      }
-      {
-        UInt numStartCodeEmulations = pcSubstreams[uiSubStrm].countStartCodeEmulations();
-        UInt uiAccumulatedSubstreamLength = 0;
-        for (Int iSubstrmIdx=0; iSubstrmIdx < iNumSubstreams; iSubstrmIdx++)
-        {
-          uiAccumulatedSubstreamLength += pcSubstreams[iSubstrmIdx].getNumberOfWrittenBits();
-        }
-        // add bits coded in previous dependent slices + bits coded so far
-        // add number of emulation prevention byte count in the tile
-        pcSlice->addTileLocation( ((pcSlice->getTileOffstForMultES() + uiAccumulatedSubstreamLength - uiBitsOriginallyInSubstreams) >> 3) + numStartCodeEmulations );
-      }
-    }
 
-    TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );    
-    if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
-    {
-      SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
-      Int iNumCuInWidth     = saoParam->numCuInWidth;
-      Int iCUAddrInSlice    = uiCUAddr - rpcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/rpcPic->getNumPartInCU());
-      Int iCUAddrUpInSlice  = iCUAddrInSlice - iNumCuInWidth;
-      Int rx = uiCUAddr % iNumCuInWidth;
-      Int ry = uiCUAddr / iNumCuInWidth;
-      Int allowMergeLeft = 1;
-      Int allowMergeUp   = 1;
-      if (rx!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(uiCUAddr-1) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))
-        {
-          allowMergeLeft = 0;
-        }
-      }
-      if (ry!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(uiCUAddr-iNumCuInWidth) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))
+        m_pcEntropyCoder->setBitstream( &pcSubstreams[uiSubStrm] );
+        // Synchronize cabac probabilities with upper-right LCU if it's available and we're at the start of a line.
+        if (((pcSlice->getPPS()->getNumSubstreams() > 1) || depSliceSegmentsEnabled) && (uiCol == uiTileLCUX) && m_pcCfg->getWaveFrontsynchro())
         {
-          allowMergeUp = 0;
+          // We'll sync if the TR is available.
+          TComDataCU *pcCUUp = rpcPic->getCU( uiCUAddr )->getCUAbove();
+          UInt uiWidthInCU = rpcPic->getFrameWidthInCU();
+          UInt uiMaxParts = 1<<(pcSlice->getSPS()->getMaxCUDepth()<<1);
+          TComDataCU *pcCUTR = NULL;
+          if ( pcCUUp && ((uiCUAddr%uiWidthInCU+1) < uiWidthInCU)  )
+          {
+            pcCUTR = rpcPic->getCU( uiCUAddr - uiWidthInCU + 1 );
+          }
+          if ( (true/*bEnforceSliceRestriction*/ &&
+               ((pcCUTR==NULL) || (pcCUTR->getSlice()==NULL) || 
+               (pcCUTR->getSCUAddr()+uiMaxParts-1 < pcSlice->getSliceCurStartCUAddr()) ||
+               ((rpcPic->getPicSym()->getTileIdxMap( pcCUTR->getAddr() ) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr)))
+               ))
+             )
+          {
+            // TR not available.
+          }
+          else
+          {
+            // TR is available, we use it.
+            pcSbacCoders[uiSubStrm].loadContexts( &m_pcBufferSbacCoders[uiTileCol] );
+          }
         }
+        m_pcSbacCoder->load(&pcSbacCoders[uiSubStrm]);  //this load is used to simplify the code (avoid to change all the call to m_pcSbacCoder)
       }
-      Int addr = pcCU->getAddr();
-      allowMergeLeft = allowMergeLeft && (rx>0) && (iCUAddrInSlice!=0);
-      allowMergeUp = allowMergeUp && (ry>0) && (iCUAddrUpInSlice>=0);
-      if( saoParam->bSaoFlag[0] || saoParam->bSaoFlag[1] )
+      // reset the entropy coder
+      if( uiCUAddr == rpcPic->getPicSym()->getTComTile(rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr() &&                                   // must be first CU of tile
+          uiCUAddr!=0 &&                                                                                                                                    // cannot be first CU of picture
+          uiCUAddr!=rpcPic->getPicSym()->getPicSCUAddr(rpcPic->getSlice(rpcPic->getCurrSliceIdx())->getSliceSegmentCurStartCUAddr())/rpcPic->getNumPartInCU() &&
+          uiCUAddr!=rpcPic->getPicSym()->getPicSCUAddr(rpcPic->getSlice(rpcPic->getCurrSliceIdx())->getSliceCurStartCUAddr())/rpcPic->getNumPartInCU())     // cannot be first CU of slice
       {
-        Int mergeLeft = saoParam->saoLcuParam[0][addr].mergeLeftFlag;
-        Int mergeUp = saoParam->saoLcuParam[0][addr].mergeUpFlag;
-        if (allowMergeLeft)
         {
-          m_pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeLeft); 
-        }
-        else
-        {
-          mergeLeft = 0;
-        }
-        if(mergeLeft == 0)
-        {
-          if (allowMergeUp)
+          // We're crossing into another tile, tiles are independent.
+          // When tiles are independent, we have "substreams per tile".  Each substream has already been terminated, and we no longer
+          // have to perform it here.
+          if (pcSlice->getPPS()->getNumSubstreams() > 1)
           {
-            m_pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeUp);
+            ; // do nothing.
           }
           else
           {
-            mergeUp = 0;
-          }
-          if(mergeUp == 0)
-          {
-            for (Int compIdx=0;compIdx<3;compIdx++)
+            SliceType sliceType  = pcSlice->getSliceType();
+            if (!pcSlice->isIntra() && pcSlice->getPPS()->getCabacInitPresentFlag() && pcSlice->getPPS()->getEncCABACTableIdx()!=I_SLICE)
             {
-            if( (compIdx == 0 && saoParam->bSaoFlag[0]) || (compIdx > 0 && saoParam->bSaoFlag[1]))
-              {
-                m_pcEntropyCoder->encodeSaoOffset(&saoParam->saoLcuParam[compIdx][addr], compIdx);
-              }
+              sliceType = (SliceType) pcSlice->getPPS()->getEncCABACTableIdx();
             }
+            m_pcEntropyCoder->updateContextTables( sliceType, pcSlice->getSliceQp() );
+            // Byte-alignment in slice_data() when new tile
+            pcSubstreams[uiSubStrm].writeByteAlignment();
           }
         }
-      }
-    }
-    else if (pcSlice->getSPS()->getUseSAO())
-    {
-      Int addr = pcCU->getAddr();
-      SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
-      for (Int cIdx=0; cIdx<3; cIdx++)
-      {
-        SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
-        if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
         {
-          saoLcuParam->mergeUpFlag   = 0;
-          saoLcuParam->mergeLeftFlag = 0;
-          saoLcuParam->subTypeIdx    = 0;
-          saoLcuParam->typeIdx       = -1;
-          saoLcuParam->offset[0]     = 0;
-          saoLcuParam->offset[1]     = 0;
-          saoLcuParam->offset[2]     = 0;
-          saoLcuParam->offset[3]     = 0;
+          UInt numStartCodeEmulations = pcSubstreams[uiSubStrm].countStartCodeEmulations();
+          UInt uiAccumulatedSubstreamLength = 0;
+          for (Int iSubstrmIdx=0; iSubstrmIdx < iNumSubstreams; iSubstrmIdx++)
+          {
+            uiAccumulatedSubstreamLength += pcSubstreams[iSubstrmIdx].getNumberOfWrittenBits();
+          }
+          // add bits coded in previous dependent slices + bits coded so far
+          // add number of emulation prevention byte count in the tile
+          pcSlice->addTileLocation( ((pcSlice->getTileOffstForMultES() + uiAccumulatedSubstreamLength - uiBitsOriginallyInSubstreams) >> 3) + numStartCodeEmulations );
         }
       }
-    }
-#if ENC_DEC_TRACE
-    g_bJustDoIt = g_bEncDecTraceEnable;
-#endif
-    if ( (m_pcCfg->getSliceMode()!=0 || m_pcCfg->getSliceSegmentMode()!=0) &&
-      uiCUAddr == rpcPic->getPicSym()->getCUOrderMap((uiBoundingCUAddr+rpcPic->getNumPartInCU()-1)/rpcPic->getNumPartInCU()-1) )
-    {
-      m_pcCuEncoder->encodeCU( pcCU );
-    }
-    else
-    {
-      m_pcCuEncoder->encodeCU( pcCU );
-    }
-#if ENC_DEC_TRACE
-    g_bJustDoIt = g_bEncDecTraceDisable;
-#endif    
-    if( m_pcCfg->getUseSBACRD() )
-    {
-       pcSbacCoders[uiSubStrm].load(m_pcSbacCoder);   //load back status of the entropy coder after encoding the LCU into relevant bitstream entropy coder
-       
 
-       //Store probabilties of second LCU in line into buffer
-       if ( (depSliceSegmentsEnabled || (pcSlice->getPPS()->getNumSubstreams() > 1)) && (uiCol == uiTileLCUX+1) && m_pcCfg->getWaveFrontsynchro())
+      xEncodeLCU( m_pcEntropyCoder, m_pcCuEncoder, rpcPic, pcSlice, uiCUAddr );
+      if( m_pcCfg->getUseSBACRD() )
       {
-        m_pcBufferSbacCoders[uiTileCol].loadContexts( &pcSbacCoders[uiSubStrm] );
+         pcSbacCoders[uiSubStrm].load(m_pcSbacCoder);   //load back status of the entropy coder after encoding the LCU into relevant bitstream entropy coder
+       
+
+         //Store probabilties of second LCU in line into buffer
+         if ( (depSliceSegmentsEnabled || (pcSlice->getPPS()->getNumSubstreams() > 1)) && (uiCol == uiTileLCUX+1) && m_pcCfg->getWaveFrontsynchro())
+        {
+          m_pcBufferSbacCoders[uiTileCol].loadContexts( &pcSbacCoders[uiSubStrm] );
+        }
       }
     }
   }
@@ -52,6 +52,8 @@
 
 class TEncTop;
 class TEncGOP;
+class TEncWorker;
+class TEncFrameContext;
 
 // ====================================================================================================================
 // Class definition
@@ -100,8 +102,12 @@ private:
   TEncBinCABAC*           m_pcBufferLowLatBinCoderCABACs;       ///< dependent tiles: line of bin coder CABAC
   TEncSbac*               m_pcBufferLowLatSbacCoders;           ///< dependent tiles: line to store temporary contexts
   TEncRateCtrl*           m_pcRateCtrl;                         ///< Rate control manager
+  TEncWorker*             m_pcWorkers;                          ///< tile workers of the frame slot of this slice encoder
+  TEncSbac*               m_pcWppSbacCoders;                    ///< WPP: contexts after the second LCU of each LCU row of the slice
+  TEncBinCABAC*           m_pcWppBinCoderCABACs;                ///< WPP: bin coder CABAC of the stored contexts
   UInt                    m_uiSliceIdx;
   std::vector<TEncSbac*> CTXMem;
+  std::vector<UInt>       m_jobEncCUOrders;                     ///< encoding order index of the first LCU of each compressSlice or encodeSlice job
 public:
   TEncSlice();
   virtual ~TEncSlice();
@@ -109,6 +115,7 @@ public:
   Void    create              ( Int iWidth, Int iHeight, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
   Void    init                ( TEncTop* pcEncTop );
+  Void    initFrameSlot       ( TEncTop* pcEncTop, TEncFrameContext* pcFrameContext, TEncWorker* pcWorkers );
   
   /// preparation of slice encoding (reference marking, QP and lambda)
   Void    initEncSlice        ( TComPic*  pcPic, Int pocLast, Int pocCurr, Int iNumPicRcvd,
@@ -120,7 +127,10 @@ public:
 #endif
   // compress and encode slice
   Void    precompressSlice    ( TComPic*& rpcPic                                );      ///< precompress slice for multi-loop opt.
-  Void    processTile         ( TComBitCounter bitCounter, UInt uiEncCUOrder, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice, pthread_mutex_t &lock);
+  Void    processJob          ( TEncWorker* pcWorker, UInt uiJob, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice,
+                                pthread_mutex_t &lock );                               ///< compress a tile
+  Void    processWppStep      ( UInt uiJob, UInt uiCol, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice,
+                                pthread_mutex_t &lock );                               ///< compress the LCU of a row in a wavefront step
   Void    compressSlice       ( TComPic*& rpcPic                                );      ///< analysis stage of slice
 #if RATE_CONTROL_INTRA
   Void    calCostSliceI       ( TComPic*& rpcPic );
@@ -132,6 +142,7 @@ public:
   UInt64  getTotalBits        ()  { return m_uiPicTotalBits; }
   
   TEncCu*        getCUEncoder() { return m_pcCuEncoder; }                        ///< CU encoder
+  TComTrQuant*   getTrQuant()   { return m_pcTrQuant;   }                        ///< transform & quantization
   Void    xDetermineStartAndBoundingCUAddr  ( UInt& uiStartCUAddr, UInt& uiBoundingCUAddr, TComPic*& rpcPic, Bool bEncodeSlice );
   UInt    getSliceIdx()         { return m_uiSliceIdx;                    }
   Void    setSliceIdx(UInt i)   { m_uiSliceIdx = i;                       }
@@ -140,6 +151,18 @@ public:
 
 private:
   Double  xGetQPValueAccordingToLambda ( Double lambda );
+  Bool    xIsJobStart         ( TComPic* pcPic, UInt uiCUAddr );
+  Void    xCompressLCU        ( TEncWorker* pcWorker, UInt uiJob, UInt uiCUAddr, Bool bFirst, TComPic*& rpcPic, TComSlice* pcSlice );
+  UInt    xDetermineJobs      ( TComPic*& rpcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr );
+  Void    xEncodeLCU          ( TEncEntropy* pcEntropyCoder, TEncCu* pcCuEncoder, TComPic*& rpcPic, TComSlice* pcSlice, UInt uiCUAddr );
+  Void    xEncodeSubstreams   ( TComPic*& rpcPic, TComSlice* pcSlice, TComOutputBitstream* pcSubstreams, UInt uiStartCUAddr, UInt uiBoundingCUAddr );
+  Void    xEncodeJob          ( TEncWorker* pcWorker, UInt uiJob, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice,
+                                TComOutputBitstream* pcSubstreams );
+  Void    xEncodeWppStep      ( UInt uiJob, UInt uiCol, TComPic*& rpcPic, UInt uiBoundingCUAddr, TComSlice* pcSlice,
+                                TComOutputBitstream* pcSubstreams );
+  Void    xEncodeSubstreamLCU ( TEncWorker* pcWorker, UInt uiJob, UInt uiCUAddr, Bool bFirst, TComPic*& rpcPic, TComSlice* pcSlice,
+                                TComOutputBitstream* pcSubstreams );
+  UInt    xGetSubstream       ( TComPic* pcPic, TComSlice* pcSlice, UInt uiCUAddr );
 };
 
 //! \}
@@ -71,12 +71,10 @@ TEncTop::TEncTop()
 
   m_pcSbacCoders           = NULL;
   m_pcBinCoderCABACs       = NULL;
-  m_ppppcRDSbacCoders      = NULL;
-  m_ppppcBinCodersCABAC    = NULL;
-  m_pcRDGoOnSbacCoders     = NULL;
-  m_pcRDGoOnBinCodersCABAC = NULL;
-  m_pcBitCounters          = NULL;
-  m_pcRdCosts              = NULL;
+  m_iNumWorkers            = 0;
+  m_pcWorkers              = NULL;
+  m_pcFrameSliceEncoders   = NULL;
+  m_pcFrameContexts        = NULL;
 }
 
 TEncTop::~TEncTop()
@@ -91,6 +89,14 @@ Void TEncTop::create ()
   // initialize global variables
   initROM();
   
+  // initialize partition order once, slices of several pictures may be compressed concurrently
+  UInt* piTmp = &g_auiZscanToRaster[0];
+  initZscanToRaster( g_uiMaxCUDepth + 1, 1, 0, piTmp );
+  initRasterToZscan( g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth + 1 );
+  
+  // initialize conversion matrix from partition index to pel
+  initRasterToPelXY( g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth + 1 );
+  
   // create processing unit classes
   m_cGOPEncoder.        create();
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
@@ -110,6 +116,10 @@ Void TEncTop::create ()
   }
 #endif
   m_cLoopFilter.        create( g_uiMaxCUDepth );
+  if ( m_iLookaheadDepth > 0 )
+  {
+    m_cLookahead.create( getSourceWidth(), getSourceHeight(), m_iLookaheadDepth, getUseAdaptiveQP() ? &m_cPreanalyzer : NULL );
+  }
   
 #if RATE_CONTROL_LAMBDA_DOMAIN
   if ( m_RCEnableRateControl )
@@ -151,6 +161,32 @@ Void TEncTop::create ()
       }
     }
   }
+
+  // tiles are compressed in parallel, each on its own worker context. With WPP the LCU rows of a wavefront lag
+  // two LCUs behind each other, so at most half a picture width of rows is active and the workers are reused
+  m_iNumWorkers = (m_iNumColumnsMinus1+1) * (m_iNumRowsMinus1+1);
+  if ( m_iWaveFrontSynchro )
+  {
+    Int iWidthInCU  = ( m_iSourceWidth  + g_uiMaxCUWidth  - 1 ) / g_uiMaxCUWidth;
+    Int iHeightInCU = ( m_iSourceHeight + g_uiMaxCUHeight - 1 ) / g_uiMaxCUHeight;
+    m_iNumWorkers = std::min( iHeightInCU, ( iWidthInCU + 1 ) / 2 );
+  }
+  m_pcWorkers   = new TEncWorker[m_iNumWorkers * m_iFrameParallelism];
+  for ( Int i = 0; i < m_iNumWorkers * m_iFrameParallelism; i++ )
+  {
+    m_pcWorkers[i].create( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, m_iParallelSplitDepth );
+  }
+
+  // every further frame slot compresses one picture next to the master slice encoder
+  if ( m_iFrameParallelism > 1 )
+  {
+    m_pcFrameSliceEncoders = new TEncSlice [m_iFrameParallelism-1];
+    m_pcFrameContexts      = new TEncFrameContext[m_iFrameParallelism-1];
+    for ( Int i = 0; i < m_iFrameParallelism-1; i++ )
+    {
+      m_pcFrameSliceEncoders[i].create( getSourceWidth(), getSourceHeight(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+    }
+  }
 }
 
 /**
@@ -168,43 +204,19 @@ Void TEncTop::createWPPCoders(Int iNumSubstreams)
   m_iNumSubstreams         = iNumSubstreams;
   m_pcSbacCoders           = new TEncSbac       [iNumSubstreams];
   m_pcBinCoderCABACs       = new TEncBinCABAC   [iNumSubstreams];
-  m_pcRDGoOnSbacCoders     = new TEncSbac       [iNumSubstreams];
-  m_pcRDGoOnBinCodersCABAC = new TEncBinCABAC   [iNumSubstreams];
-  m_pcBitCounters          = new TComBitCounter [iNumSubstreams];
-  m_pcRdCosts              = new TComRdCost     [iNumSubstreams];
 
+  // RD coders are owned by the worker contexts, only the coders writing the substreams are needed here
   for ( UInt ui = 0 ; ui < iNumSubstreams; ui++ )
   {
-    m_pcRDGoOnSbacCoders[ui].init( &m_pcRDGoOnBinCodersCABAC[ui] );
     m_pcSbacCoders[ui].init( &m_pcBinCoderCABACs[ui] );
   }
-  if( m_bUseSBACRD )
-  {
-    m_ppppcRDSbacCoders      = new TEncSbac***    [iNumSubstreams];
-    m_ppppcBinCodersCABAC    = new TEncBinCABAC***[iNumSubstreams];
-    for ( UInt ui = 0 ; ui < iNumSubstreams ; ui++ )
-    {
-      m_ppppcRDSbacCoders[ui]  = new TEncSbac** [g_uiMaxCUDepth+1];
-      m_ppppcBinCodersCABAC[ui]= new TEncBinCABAC** [g_uiMaxCUDepth+1];
-      
-      for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
-      {
-        m_ppppcRDSbacCoders[ui][iDepth]  = new TEncSbac*     [CI_NUM];
-        m_ppppcBinCodersCABAC[ui][iDepth]= new TEncBinCABAC* [CI_NUM];
-
-        for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
-        {
-          m_ppppcRDSbacCoders  [ui][iDepth][iCIIdx] = new TEncSbac;
-          m_ppppcBinCodersCABAC[ui][iDepth][iCIIdx] = new TEncBinCABAC;
-          m_ppppcRDSbacCoders  [ui][iDepth][iCIIdx]->init( m_ppppcBinCodersCABAC[ui][iDepth][iCIIdx] );
-        }
-      }
-    }
-  }
 }
 
 Void TEncTop::destroy ()
 {
+  // finish the analysis of the received pictures before they are freed
+  m_cLookahead.         destroy();
+  
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
   m_cSliceEncoder.      destroy();
@@ -237,35 +249,24 @@ Void TEncTop::destroy ()
     
     delete [] m_pppcRDSbacCoder;
     delete [] m_pppcBinCoderCABAC;
-
-    for ( UInt ui = 0; ui < m_iNumSubstreams; ui++ )
-    {
-      for ( iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
-      {
-        for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
-        {
-          delete m_ppppcRDSbacCoders  [ui][iDepth][iCIIdx];
-          delete m_ppppcBinCodersCABAC[ui][iDepth][iCIIdx];
-        }
-      }
-
-      for ( iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
-      {
-        delete [] m_ppppcRDSbacCoders  [ui][iDepth];
-        delete [] m_ppppcBinCodersCABAC[ui][iDepth];
-      }
-      delete[] m_ppppcRDSbacCoders  [ui];
-      delete[] m_ppppcBinCodersCABAC[ui];
-    }
-    delete[] m_ppppcRDSbacCoders;
-    delete[] m_ppppcBinCodersCABAC;
   }
+  for ( Int i = 0; i < m_iNumWorkers * m_iFrameParallelism; i++ )
+  {
+    m_pcWorkers[i].destroy();
+  }
+  delete[] m_pcWorkers;
+  m_pcWorkers   = NULL;
+  m_iNumWorkers = 0;
+  for ( Int i = 0; m_pcFrameContexts && i < m_iFrameParallelism-1; i++ )
+  {
+    m_pcFrameSliceEncoders[i].destroy();
+  }
+  delete[] m_pcFrameSliceEncoders;
+  delete[] m_pcFrameContexts;
+  m_pcFrameSliceEncoders = NULL;
+  m_pcFrameContexts      = NULL;
   delete[] m_pcSbacCoders;
   delete[] m_pcBinCoderCABACs;
-  delete[] m_pcRDGoOnSbacCoders;  
-  delete[] m_pcRDGoOnBinCodersCABAC;
-  delete[] m_pcBitCounters;
-  delete[] m_pcRdCosts;
   
   // destroy ROM
   destroyROM();
@@ -309,6 +310,17 @@ Void TEncTop::init(Bool isFieldCoding)
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_iFastSearch, 0, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
 
+  // initialize worker contexts for parallel slice compression
+  for ( Int i = 0; i < m_iNumWorkers * m_iFrameParallelism; i++ )
+  {
+    m_pcWorkers[i].init( this );
+  }
+  for ( Int i = 0; i < m_iFrameParallelism-1; i++ )
+  {
+    m_pcFrameContexts[i].init( this );
+    m_pcFrameSliceEncoders[i].initFrameSlot( this, &m_pcFrameContexts[i], &m_pcWorkers[(i+1) * m_iNumWorkers] );
+  }
+
   m_iMaxRefPicNum = 0;
 }
 
@@ -351,7 +363,11 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
     pcPicYuvOrg->copyToPic( pcPicCurr->getPicYuvOrg() );
 
     // compute image characteristics
-    if ( getUseAdaptiveQP() )
+    if ( m_iLookaheadDepth > 0 )
+    {
+      m_cLookahead.push( dynamic_cast<TEncPic*>( pcPicCurr ) );
+    }
+    else if ( getUseAdaptiveQP() )
     {
       m_cPreanalyzer.xPreanalyze( dynamic_cast<TEncPic*>( pcPicCurr ) );
     }
@@ -371,7 +387,7 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
 #endif
 
   // compress GOP
-
+  m_cLookahead.flush();
   m_cGOPEncoder.compressGOP(m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, accessUnitsOut, false, false);
 
 #if RATE_CONTROL_LAMBDA_DOMAIN
@@ -442,7 +458,7 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
     Pel * pcTopFieldV =  pcTopField->getPicYuvOrg()->getCrAddr();
     
     // compute image characteristics
-    if ( getUseAdaptiveQP() )
+    if ( getUseAdaptiveQP() && m_iLookaheadDepth == 0 )
     {
       m_cPreanalyzer.xPreanalyze( dynamic_cast<TEncPic*>( pcTopField ) );
     }
@@ -455,10 +471,15 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
     separateFields(PicBufU + nPadChroma + (nStride >> 1)*nPadChroma, pcTopFieldU, nStride >> 1, nWidth >> 1, nHeight >> 1, isTop);
     separateFields(PicBufV + nPadChroma + (nStride >> 1)*nPadChroma, pcTopFieldV, nStride >> 1, nWidth >> 1, nHeight >> 1, isTop);
     
+    if ( m_iLookaheadDepth > 0 )
+    {
+      m_cLookahead.push( dynamic_cast<TEncPic*>( pcTopField ) );
+    }
   }
   
   if (m_iPOCLast == 0) // compress field 0
   {
+    m_cLookahead.flush();
     m_cGOPEncoder.compressGOP(m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, accessUnitsOut, true, isTff);
   }
   
@@ -505,7 +526,7 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
     Pel * pcBottomFieldV =  pcBottomField->getPicYuvOrg()->getCrAddr();
     
     // Compute image characteristics
-    if ( getUseAdaptiveQP() )
+    if ( getUseAdaptiveQP() && m_iLookaheadDepth == 0 )
     {
       m_cPreanalyzer.xPreanalyze( dynamic_cast<TEncPic*>( pcBottomField ) );
     }
@@ -518,6 +539,10 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
     separateFields(PicBufU + nPadChroma + (nStride >> 1)*nPadChroma, pcBottomFieldU, nStride >> 1, nWidth >> 1, nHeight >> 1, isTop);
     separateFields(PicBufV + nPadChroma + (nStride >> 1)*nPadChroma, pcBottomFieldV, nStride >> 1, nWidth >> 1, nHeight >> 1, isTop);
     
+    if ( m_iLookaheadDepth > 0 )
+    {
+      m_cLookahead.push( dynamic_cast<TEncPic*>( pcBottomField ) );
+    }
   }
   
   if ( ( !(m_iNumPicRcvd) || (!flush && m_iPOCLast != 1 && m_iNumPicRcvd != m_iGOPSize && m_iGOPSize)) )
@@ -527,6 +552,7 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>&
   }
   
   // compress GOP
+  m_cLookahead.flush();
   m_cGOPEncoder.compressGOP(m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, accessUnitsOut, true, isTff);
   
   iNumEncoded = m_iNumPicRcvd;
@@ -564,10 +590,10 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic )
   }
   else
   {
-    if ( getUseAdaptiveQP() )
+    if ( getUseAdaptiveQP() || m_iLookaheadDepth > 0 )
     {
       TEncPic* pcEPic = new TEncPic;
-      pcEPic->create( m_iSourceWidth, m_iSourceHeight, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth, m_cPPS.getMaxCuDQPDepth()+1 ,
+      pcEPic->create( m_iSourceWidth, m_iSourceHeight, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth, getUseAdaptiveQP() ? m_cPPS.getMaxCuDQPDepth()+1 : 0,
                       m_conformanceWindow, m_defaultDisplayWindow, m_numReorderPics);
       rpcPic = pcEPic;
     }
@@ -55,7 +55,9 @@
 #include "TEncSearch.h"
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncPreanalyzer.h"
+#include "TEncLookahead.h"
 #include "TEncRateCtrl.h"
+#include "TEncWorker.h"
 //! \ingroup TLibEncoder
 //! \{
 
@@ -108,15 +110,16 @@ private:
   TEncBinCABAC            m_cRDGoOnBinCoderCABAC;         ///< going on bin coder CABAC for RD stage
 #endif
   Int                     m_iNumSubstreams;                ///< # of top-level elements allocated.
-  TComBitCounter*         m_pcBitCounters;                 ///< bit counters for RD optimization per substream
-  TComRdCost*             m_pcRdCosts;                     ///< RD cost computation class per substream
-  TEncSbac****            m_ppppcRDSbacCoders;             ///< temporal storage for RD computation per substream
-  TEncSbac*               m_pcRDGoOnSbacCoders;            ///< going on SBAC model for RD stage per substream
-  TEncBinCABAC****        m_ppppcBinCodersCABAC;           ///< temporal CABAC state storage for RD computation per substream
-  TEncBinCABAC*           m_pcRDGoOnBinCodersCABAC;        ///< going on bin coder CABAC for RD stage per substream
+
+  // parallel slice compression
+  Int                     m_iNumWorkers;                   ///< # of worker contexts allocated per frame slot
+  TEncWorker*             m_pcWorkers;                     ///< private CU encoding contexts, one per tile (per active wavefront row with WPP) and frame slot
+  TEncSlice*              m_pcFrameSliceEncoders;          ///< slice encoders of the frame slots after the first one
+  TEncFrameContext*       m_pcFrameContexts;               ///< transform, RD cost and search state of the frame slots after the first one
 
   // quality control
   TEncPreanalyzer         m_cPreanalyzer;                 ///< image characteristics analyzer for TM5-step3-like adaptive QP
+  TEncLookahead           m_cLookahead;                   ///< background analysis of the received pictures, used if LookaheadDepth > 0
 
   TComScalingList         m_scalingList;                 ///< quantization matrix information
   TEncRateCtrl            m_cRateCtrl;                    ///< Rate control class
@@ -164,10 +167,10 @@ public:
   TComRdCost*             getRdCost             () { return  &m_cRdCost;              }
   TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;       }
   TEncSbac*               getRDGoOnSbacCoder    () { return  &m_cRDGoOnSbacCoder;     }
-  TComBitCounter*         getBitCounters        () { return  m_pcBitCounters;         }
-  TComRdCost*             getRdCosts            () { return  m_pcRdCosts;             }
-  TEncSbac****            getRDSbacCoders       () { return  m_ppppcRDSbacCoders;     }
-  TEncSbac*               getRDGoOnSbacCoders   () { return  m_pcRDGoOnSbacCoders;   }
+  Int                     getNumWorkers         () { return  m_iNumWorkers;           }
+  TEncWorker*             getWorker             ( Int i ) { return &m_pcWorkers[i];   }
+  /// slice encoder of a frame slot, slot 0 is the master slice encoder
+  TEncSlice*              getFrameSliceEncoder  ( Int iSlot ) { return iSlot ? &m_pcFrameSliceEncoders[iSlot-1] : &m_cSliceEncoder; }
   TEncRateCtrl*           getRateCtrl           () { return &m_cRateCtrl;             }
   TComSPS*                getSPS                () { return  &m_cSPS;                 }
   TComPPS*                getPPS                () { return  &m_cPPS;                 }
@@ -0,0 +1,328 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncWorker.cpp
+    \brief    per-worker encoding context for parallel slice compression
+*/
+
+#include "TEncTop.h"
+#include "TEncWorker.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncWorker::TEncWorker()
+{
+  m_pppcRDSbacCoder   = NULL;
+  m_pppcBinCoderCABAC = NULL;
+  m_pcSplitWorker     = NULL;
+  m_pcEncTop          = NULL;
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+}
+
+TEncWorker::~TEncWorker()
+{
+}
+
+/**
+ - allocate CU encoder buffers and the SBAC RD coder storage once per worker
+ .
+ \param uhTotalDepth  total number of allowable depth
+ \param uiMaxWidth    largest CU width
+ \param uiMaxHeight   largest CU height
+ \param iSplitDepth   number of CU depths whose split subtree is compressed by a chain of further contexts
+ */
+Void TEncWorker::create( UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight, Int iSplitDepth )
+{
+  m_cCuEncoder.create( uhTotalDepth, uiMaxWidth, uiMaxHeight );
+
+  if ( iSplitDepth > 0 )
+  {
+    m_pcSplitWorker = new TEncWorker;
+    m_pcSplitWorker->create( uhTotalDepth, uiMaxWidth, uiMaxHeight, iSplitDepth-1 );
+  }
+
+  m_pppcRDSbacCoder = new TEncSbac** [uhTotalDepth+1];
+#if FAST_BIT_EST
+  m_pppcBinCoderCABAC = new TEncBinCABACCounter** [uhTotalDepth+1];
+#else
+  m_pppcBinCoderCABAC = new TEncBinCABAC** [uhTotalDepth+1];
+#endif
+
+  for ( Int iDepth = 0; iDepth < uhTotalDepth+1; iDepth++ )
+  {
+    m_pppcRDSbacCoder[iDepth] = new TEncSbac* [CI_NUM];
+#if FAST_BIT_EST
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABACCounter* [CI_NUM];
+#else
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABAC* [CI_NUM];
+#endif
+
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      m_pppcRDSbacCoder[iDepth][iCIIdx] = new TEncSbac;
+#if FAST_BIT_EST
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABACCounter;
+#else
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABAC;
+#endif
+      m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
+    }
+  }
+}
+
+Void TEncWorker::destroy()
+{
+  m_cCuEncoder.destroy();
+
+  if ( m_pcSplitWorker )
+  {
+    m_pcSplitWorker->destroy();
+    delete m_pcSplitWorker;
+    m_pcSplitWorker = NULL;
+  }
+
+  if ( m_pppcRDSbacCoder )
+  {
+    for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+    {
+      for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+      {
+        delete m_pppcRDSbacCoder[iDepth][iCIIdx];
+        delete m_pppcBinCoderCABAC[iDepth][iCIIdx];
+      }
+      delete [] m_pppcRDSbacCoder[iDepth];
+      delete [] m_pppcBinCoderCABAC[iDepth];
+    }
+    delete [] m_pppcRDSbacCoder;
+    delete [] m_pppcBinCoderCABAC;
+    m_pppcRDSbacCoder   = NULL;
+    m_pppcBinCoderCABAC = NULL;
+  }
+}
+
+/** wire the worker objects together, must be called after the master encoder has been initialized
+ * \param pcEncTop pointer of encoder class
+ */
+Void TEncWorker::init( TEncTop* pcEncTop )
+{
+  m_pcEncTop = pcEncTop;
+
+  m_cTrQuant.copyInit( pcEncTop->getTrQuant() );
+  m_cSearch.init( pcEncTop, &m_cTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getFastSearch(), 0,
+                  &m_cEntropyCoder, &m_cRdCost, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+  m_cSearch.createParallelContexts();
+  m_cCuEncoder.init_new( pcEncTop, &m_cSearch, &m_cTrQuant, &m_cRdCost, &m_cBitCounter, &m_cEntropyCoder, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+
+  if ( m_pcSplitWorker )
+  {
+    m_pcSplitWorker->init( pcEncTop );
+    m_cCuEncoder.setSplitEncoder( m_pcSplitWorker->getCuEncoder() );
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** copy the slice-level state of the slice encoder and reset the entropy coders, no memory is allocated here
+ * \param pcSlice   slice to be compressed
+ * \param pcTrQuant transform & quantization holding the slice QP, lambda and scaling lists
+ * \param pcRdCost  RD cost holding the slice lambda
+ * \param pcSearch  encoder search holding the adaptive search range
+ */
+Void TEncWorker::initTile( TComSlice* pcSlice, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost, TEncSearch* pcSearch )
+{
+  m_cTrQuant.copyTrQuant( pcTrQuant );
+  m_cRdCost.copyLambda( pcRdCost );
+  m_cSearch.copySearchRange( pcSearch );
+  m_cSearch.initTileContexts( pcSlice );
+  m_cBitCounter.resetBits();
+
+  m_cEntropyCoder.setEntropyCoder( &m_cRDGoOnSbacCoder, pcSlice );
+  m_cEntropyCoder.resetEntropy();
+  m_pppcRDSbacCoder[0][CI_CURR_BEST]->load( &m_cRDGoOnSbacCoder );
+
+  // the split context is only driven by m_cCuEncoder, its coders stay bound for the whole tile
+  if ( m_pcSplitWorker )
+  {
+    m_pcSplitWorker->initTile( pcSlice, pcTrQuant, pcRdCost, pcSearch );
+    m_pcSplitWorker->m_cEntropyCoder.setBitstream( &m_pcSplitWorker->m_cBitCounter );
+    m_pcSplitWorker->m_cRDGoOnBinCoderCABAC.setBinCountingEnableFlag( true );
+  }
+}
+
+// ====================================================================================================================
+// TEncFrameContext
+// ====================================================================================================================
+
+/** set up the slice-level state of a frame slot, no CU encoding buffers or RD coders are allocated
+ * \param pcEncTop pointer of encoder class
+ */
+Void TEncFrameContext::init( TEncTop* pcEncTop )
+{
+  m_cTrQuant.copyInit( pcEncTop->getTrQuant() );
+  m_cSearch.init( pcEncTop, &m_cTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getFastSearch(), 0,
+                  NULL, &m_cRdCost, NULL, NULL );
+}
+
+// ====================================================================================================================
+// TEncIntraContext
+// ====================================================================================================================
+
+TEncIntraContext::TEncIntraContext()
+{
+  m_pppcRDSbacCoder   = NULL;
+  m_pppcBinCoderCABAC = NULL;
+  m_pcPredYuv         = NULL;
+  m_pcResiYuv         = NULL;
+  m_uhTotalDepth      = 0;
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+}
+
+TEncIntraContext::~TEncIntraContext()
+{
+  destroy();
+}
+
+/** allocate the CU copy, the per-depth buffers and the SBAC RD coder storage
+ * \param uhTotalDepth total number of allowable depth
+ * \param uiMaxWidth   largest CU width
+ * \param uiMaxHeight  largest CU height
+ */
+Void TEncIntraContext::create( UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight )
+{
+  m_uhTotalDepth = uhTotalDepth;
+  m_cCU.create( 1 << ( ( uhTotalDepth - 1 ) << 1 ), uiMaxWidth, uiMaxHeight, false, uiMaxWidth >> ( uhTotalDepth - 1 ) );
+
+  m_pcPredYuv = new TComYuv[uhTotalDepth];
+  m_pcResiYuv = new TComYuv[uhTotalDepth];
+  for ( Int iDepth = 0; iDepth < uhTotalDepth; iDepth++ )
+  {
+    m_pcPredYuv[iDepth].create( uiMaxWidth >> iDepth, uiMaxHeight >> iDepth );
+    m_pcResiYuv[iDepth].create( uiMaxWidth >> iDepth, uiMaxHeight >> iDepth );
+  }
+
+  m_pppcRDSbacCoder = new TEncSbac** [uhTotalDepth+1];
+#if FAST_BIT_EST
+  m_pppcBinCoderCABAC = new TEncBinCABACCounter** [uhTotalDepth+1];
+#else
+  m_pppcBinCoderCABAC = new TEncBinCABAC** [uhTotalDepth+1];
+#endif
+
+  for ( Int iDepth = 0; iDepth < uhTotalDepth+1; iDepth++ )
+  {
+    m_pppcRDSbacCoder[iDepth] = new TEncSbac* [CI_NUM];
+#if FAST_BIT_EST
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABACCounter* [CI_NUM];
+#else
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABAC* [CI_NUM];
+#endif
+
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      m_pppcRDSbacCoder[iDepth][iCIIdx] = new TEncSbac;
+#if FAST_BIT_EST
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABACCounter;
+#else
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABAC;
+#endif
+      m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
+    }
+  }
+}
+
+Void TEncIntraContext::destroy()
+{
+  if ( m_pcPredYuv )
+  {
+    m_cCU.destroy();
+    for ( Int iDepth = 0; iDepth < m_uhTotalDepth; iDepth++ )
+    {
+      m_pcPredYuv[iDepth].destroy();
+      m_pcResiYuv[iDepth].destroy();
+    }
+    delete [] m_pcPredYuv;
+    delete [] m_pcResiYuv;
+    m_pcPredYuv = NULL;
+    m_pcResiYuv = NULL;
+  }
+
+  if ( m_pppcRDSbacCoder )
+  {
+    for ( Int iDepth = 0; iDepth < m_uhTotalDepth+1; iDepth++ )
+    {
+      for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+      {
+        delete m_pppcRDSbacCoder[iDepth][iCIIdx];
+        delete m_pppcBinCoderCABAC[iDepth][iCIIdx];
+      }
+      delete [] m_pppcRDSbacCoder[iDepth];
+      delete [] m_pppcBinCoderCABAC[iDepth];
+    }
+    delete [] m_pppcRDSbacCoder;
+    delete [] m_pppcBinCoderCABAC;
+    m_pppcRDSbacCoder   = NULL;
+    m_pppcBinCoderCABAC = NULL;
+  }
+}
+
+/** wire the context objects together
+ * \param pcEncCfg  encoder configuration
+ * \param pcTrQuant transform & quantization of the search owning the context
+ */
+Void TEncIntraContext::init( TEncCfg* pcEncCfg, TComTrQuant* pcTrQuant )
+{
+  m_cTrQuant.copyInit( pcTrQuant );
+  m_cSearch.init( pcEncCfg, &m_cTrQuant, pcEncCfg->getSearchRange(), pcEncCfg->getBipredSearchRange(), pcEncCfg->getFastSearch(), 0,
+                  &m_cEntropyCoder, &m_cRdCost, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+}
+
+/** copy the slice-level transform state and bind the entropy coder, no memory is allocated here
+ * \param pcSlice   slice to be compressed
+ * \param pcTrQuant transform & quantization holding the slice QP, lambda and scaling lists
+ */
+Void TEncIntraContext::initTile( TComSlice* pcSlice, TComTrQuant* pcTrQuant )
+{
+  m_cTrQuant.copyTrQuant( pcTrQuant );
+  m_cBitCounter.resetBits();
+  m_cEntropyCoder.setEntropyCoder( &m_cRDGoOnSbacCoder, pcSlice );
+  m_cEntropyCoder.setBitstream( &m_cBitCounter );
+}
+
+//! \}
@@ -0,0 +1,162 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncWorker.h
+    \brief    per-worker encoding context for parallel slice compression (header)
+*/
+
+#ifndef __TENCWORKER__
+#define __TENCWORKER__
+
+// Include files
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComBitCounter.h"
+#include "TEncCu.h"
+#include "TEncSearch.h"
+#include "TEncEntropy.h"
+#include "TEncSbac.h"
+#include "TEncBinCoderCABACCounter.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// private CU encoding state of one parallel worker, allocated once and reset for every tile
+class TEncWorker
+{
+private:
+  TEncCu                  m_cCuEncoder;                   ///< CU encoder
+  TEncSearch              m_cSearch;                      ///< encoder search class
+  TComTrQuant             m_cTrQuant;                     ///< transform & quantization class
+  TComRdCost              m_cRdCost;                      ///< RD cost computation class, lambda copied from the master
+  TComBitCounter          m_cBitCounter;                  ///< bit counter for RD optimization
+  TEncEntropy             m_cEntropyCoder;                ///< entropy encoder
+  TEncSbac                m_cRDGoOnSbacCoder;             ///< going on SBAC model for RD stage
+  TEncBinCABAC            m_cRDGoOnBinCoderCABAC;         ///< going on bin coder CABAC for RD stage
+  TEncSbac***             m_pppcRDSbacCoder;              ///< temporal storage for RD computation
+#if FAST_BIT_EST
+  TEncBinCABACCounter***  m_pppcBinCoderCABAC;            ///< temporal CABAC state storage for RD computation
+#else
+  TEncBinCABAC***         m_pppcBinCoderCABAC;            ///< temporal CABAC state storage for RD computation
+#endif
+  TEncWorker*             m_pcSplitWorker;                ///< context compressing the split subtrees of m_cCuEncoder concurrently, NULL if none
+  TEncTop*                m_pcEncTop;
+
+public:
+  TEncWorker();
+  virtual ~TEncWorker();
+
+  Void    create              ( UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight, Int iSplitDepth = 0 );
+  Void    destroy             ();
+  Void    init                ( TEncTop* pcEncTop );
+
+  /// refresh per-slice state from the slice encoder before compressing a tile
+  Void    initTile            ( TComSlice* pcSlice, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost, TEncSearch* pcSearch );
+
+  TEncCu*                 getCuEncoder          () { return &m_cCuEncoder;          }
+  TEncSearch*             getPredSearch         () { return &m_cSearch;             }
+  TComTrQuant*            getTrQuant            () { return &m_cTrQuant;            }
+  TEncEntropy*            getEntropyCoder       () { return &m_cEntropyCoder;       }
+  TComRdCost*             getRdCost             () { return &m_cRdCost;             }
+  TComBitCounter*         getBitCounter         () { return &m_cBitCounter;         }
+  TEncSbac***             getRDSbacCoder        () { return m_pppcRDSbacCoder;      }
+  TEncSbac*               getRDGoOnSbacCoder    () { return &m_cRDGoOnSbacCoder;    }
+};
+
+/// slice-level transform, RD cost and search state of a frame slot, copied into the workers of the slot for every tile
+class TEncFrameContext
+{
+private:
+  TComTrQuant             m_cTrQuant;                     ///< slice QP, lambda and scaling lists
+  TComRdCost              m_cRdCost;                      ///< slice lambda
+  TEncSearch              m_cSearch;                      ///< adaptive search range, never used for searching
+
+public:
+  Void    init                ( TEncTop* pcEncTop );
+
+  TEncSearch*             getPredSearch         () { return &m_cSearch;             }
+  TComTrQuant*            getTrQuant            () { return &m_cTrQuant;            }
+  TComRdCost*             getRdCost             () { return &m_cRdCost;             }
+};
+
+/// private RD state of one intra luma mode candidate, the candidates of a prediction unit are checked concurrently
+class TEncIntraContext
+{
+private:
+  TEncSearch              m_cSearch;                      ///< encoder search class, does not write the picture reconstruction
+  TComTrQuant             m_cTrQuant;                     ///< transform & quantization class, copied for every tile
+  TComRdCost              m_cRdCost;                      ///< RD cost computation class, lambda copied for every prediction unit
+  TComBitCounter          m_cBitCounter;                  ///< bit counter for RD optimization
+  TEncEntropy             m_cEntropyCoder;                ///< entropy encoder
+  TEncSbac                m_cRDGoOnSbacCoder;             ///< going on SBAC model for RD stage
+  TEncBinCABAC            m_cRDGoOnBinCoderCABAC;         ///< going on bin coder CABAC for RD stage
+  TEncSbac***             m_pppcRDSbacCoder;              ///< temporal storage for RD computation
+#if FAST_BIT_EST
+  TEncBinCABACCounter***  m_pppcBinCoderCABAC;            ///< temporal CABAC state storage for RD computation
+#else
+  TEncBinCABAC***         m_pppcBinCoderCABAC;            ///< temporal CABAC state storage for RD computation
+#endif
+  TComDataCU              m_cCU;                          ///< copy of the CU under test, at the largest CU size
+  TComYuv*                m_pcPredYuv;                    ///< prediction buffer for each CU depth
+  TComYuv*                m_pcResiYuv;                    ///< residual buffer for each CU depth
+  UChar                   m_uhTotalDepth;
+
+public:
+  TEncIntraContext();
+  virtual ~TEncIntraContext();
+
+  Void    create              ( UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight );
+  Void    destroy             ();
+  Void    init                ( TEncCfg* pcEncCfg, TComTrQuant* pcTrQuant );
+
+  /// refresh the slice-level state before compressing a tile
+  Void    initTile            ( TComSlice* pcSlice, TComTrQuant* pcTrQuant );
+
+  TEncSearch*             getPredSearch         () { return &m_cSearch;             }
+  TComRdCost*             getRdCost             () { return &m_cRdCost;             }
+  TComDataCU*             getCU                 () { return &m_cCU;                 }
+  TComYuv*                getPredYuv            ( UInt uiDepth ) { return &m_pcPredYuv[uiDepth]; }
+  TComYuv*                getResiYuv            ( UInt uiDepth ) { return &m_pcResiYuv[uiDepth]; }
+};
+
+//! \}
+
+#endif // __TENCWORKER__
@@ -0,0 +1,213 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TVideoIOYuvReader.cpp
+    \brief    prefetching YUV file reader
+*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "TVideoIOYuvReader.h"
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TVideoIOYuvReader::TVideoIOYuvReader()
+: m_pcFile(NULL)
+, m_iNumFrames(0)
+, m_iNumBuffers(0)
+, m_pcBuffers(NULL)
+, m_pbEof(NULL)
+, m_iFillIdx(0)
+, m_iPopIdx(0)
+, m_iNumFilled(0)
+, m_bExit(false)
+{
+  m_aiPad[0] = m_aiPad[1] = 0;
+}
+
+TVideoIOYuvReader::~TVideoIOYuvReader()
+{
+  destroy();
+}
+
+/** allocate the frame buffers and start the reader thread
+ * \param pcFile opened input file, skipped to the first frame
+ * \param iNumBuffers number of frames read ahead of the caller
+ * \param iNumFrames number of frames to be read
+ * \param iWidth frame width including padding
+ * \param iHeight frame height including padding
+ * \param uiMaxCUWidth maximum CU width
+ * \param uiMaxCUHeight maximum CU height
+ * \param uiMaxCUDepth maximum CU depth
+ * \param aiPad horizontal and vertical padding
+ */
+Void TVideoIOYuvReader::create( TVideoIOYuv* pcFile, Int iNumBuffers, Int iNumFrames, Int iWidth, Int iHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxCUDepth, Int aiPad[2] )
+{
+  m_pcFile      = pcFile;
+  m_aiPad[0]    = aiPad[0];
+  m_aiPad[1]    = aiPad[1];
+  m_iNumFrames  = iNumFrames;
+  m_iNumBuffers = iNumBuffers;
+  m_pcBuffers   = new TComPicYuv[m_iNumBuffers];
+  m_pbEof       = new Bool[m_iNumBuffers];
+  for ( Int i = 0; i < m_iNumBuffers; i++ )
+  {
+    m_pcBuffers[i].create( iWidth, iHeight, uiMaxCUWidth, uiMaxCUHeight, uiMaxCUDepth );
+    m_pbEof[i] = false;
+  }
+  m_iFillIdx   = 0;
+  m_iPopIdx    = 0;
+  m_iNumFilled = 0;
+  m_bExit      = false;
+
+  pthread_mutex_init( &m_mutex, NULL );
+  pthread_cond_init( &m_condFilled, NULL );
+  pthread_cond_init( &m_condReleased, NULL );
+  if ( pthread_create( &m_thread, NULL, xThreadMain, this ) != 0 )
+  {
+    fprintf( stderr, "\nfailed to start the YUV reader thread\n" );
+    exit( EXIT_FAILURE );
+  }
+}
+
+/** stop the reader thread and free the frame buffers
+ */
+Void TVideoIOYuvReader::destroy()
+{
+  if ( m_pcBuffers == NULL )
+  {
+    return;
+  }
+
+  pthread_mutex_lock( &m_mutex );
+  m_bExit = true;
+  pthread_cond_signal( &m_condReleased );
+  pthread_mutex_unlock( &m_mutex );
+  pthread_join( m_thread, NULL );
+
+  pthread_cond_destroy( &m_condReleased );
+  pthread_cond_destroy( &m_condFilled );
+  pthread_mutex_destroy( &m_mutex );
+
+  for ( Int i = 0; i < m_iNumBuffers; i++ )
+  {
+    m_pcBuffers[i].destroy();
+  }
+  delete[] m_pcBuffers;
+  delete[] m_pbEof;
+  m_pcBuffers = NULL;
+  m_pbEof     = NULL;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** wait for the next frame in file order, must not be called again before release()
+ * \param rbEof end of file was reached when reading the frame, the buffer then holds no valid frame
+ * \returns buffer holding the frame
+ */
+TComPicYuv* TVideoIOYuvReader::pop( Bool& rbEof )
+{
+  pthread_mutex_lock( &m_mutex );
+  while ( m_iNumFilled == 0 )
+  {
+    pthread_cond_wait( &m_condFilled, &m_mutex );
+  }
+  TComPicYuv* pcPicYuv = &m_pcBuffers[m_iPopIdx];
+  rbEof = m_pbEof[m_iPopIdx];
+  pthread_mutex_unlock( &m_mutex );
+
+  return pcPicYuv;
+}
+
+/** hand the buffer of the last popped frame back to the reader thread
+ */
+Void TVideoIOYuvReader::release()
+{
+  pthread_mutex_lock( &m_mutex );
+  m_iPopIdx = ( m_iPopIdx + 1 ) % m_iNumBuffers;
+  m_iNumFilled--;
+  pthread_cond_signal( &m_condReleased );
+  pthread_mutex_unlock( &m_mutex );
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void* TVideoIOYuvReader::xThreadMain( Void* pArg )
+{
+  static_cast<TVideoIOYuvReader*>( pArg )->xRun();
+  return NULL;
+}
+
+/** read loop, stops after the requested number of frames or at the end of the file
+ */
+Void TVideoIOYuvReader::xRun()
+{
+  for ( Int iFrame = 0; iFrame < m_iNumFrames; iFrame++ )
+  {
+    pthread_mutex_lock( &m_mutex );
+    while ( m_iNumFilled == m_iNumBuffers && !m_bExit )
+    {
+      pthread_cond_wait( &m_condReleased, &m_mutex );
+    }
+    Bool bExit = m_bExit;
+    pthread_mutex_unlock( &m_mutex );
+    if ( bExit )
+    {
+      return;
+    }
+
+    // the buffer is owned by this thread until it is marked as filled
+    m_pcFile->read( &m_pcBuffers[m_iFillIdx], m_aiPad );
+    Bool bEof = m_pcFile->isEof();
+
+    pthread_mutex_lock( &m_mutex );
+    m_pbEof[m_iFillIdx] = bEof;
+    m_iFillIdx = ( m_iFillIdx + 1 ) % m_iNumBuffers;
+    m_iNumFilled++;
+    pthread_cond_signal( &m_condFilled );
+    pthread_mutex_unlock( &m_mutex );
+
+    if ( bEof )
+    {
+      return;
+    }
+  }
+}
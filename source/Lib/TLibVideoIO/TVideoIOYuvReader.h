@@ -0,0 +1,88 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TVideoIOYuvReader.h
+    \brief    prefetching YUV file reader (header)
+*/
+
+#ifndef __TVIDEOIOYUVREADER__
+#define __TVIDEOIOYUVREADER__
+
+#include <pthread.h>
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPicYuv.h"
+#include "TVideoIOYuv.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reads and converts the frames of a YUV file on a background thread into a ring of picture buffers
+class TVideoIOYuvReader
+{
+private:
+  TVideoIOYuv*  m_pcFile;                                   ///< opened input file, only accessed by the reader thread
+  Int           m_aiPad[2];                                 ///< padding of the frames
+  Int           m_iNumFrames;                               ///< number of frames to be read
+  Int           m_iNumBuffers;                              ///< size of the ring
+  TComPicYuv*   m_pcBuffers;                                ///< ring of frame buffers
+  Bool*         m_pbEof;                                    ///< end of file was reached when reading the frame of a buffer
+  Int           m_iFillIdx;                                 ///< next buffer filled by the reader thread
+  Int           m_iPopIdx;                                  ///< next buffer handed to the caller
+  Int           m_iNumFilled;                               ///< buffers read and not yet released by the caller
+  Bool          m_bExit;                                    ///< reader thread is asked to terminate
+
+  pthread_t     m_thread;
+  pthread_mutex_t m_mutex;
+  pthread_cond_t  m_condFilled;                             ///< a buffer has been read
+  pthread_cond_t  m_condReleased;                           ///< a buffer has been released or the thread is asked to terminate
+
+  static Void*  xThreadMain ( Void* pArg );
+  Void          xRun        ();
+
+public:
+  TVideoIOYuvReader();
+  virtual ~TVideoIOYuvReader();
+
+  /// start reading iNumFrames frames of an opened file into iNumBuffers buffers of the given size
+  Void  create  ( TVideoIOYuv* pcFile, Int iNumBuffers, Int iNumFrames, Int iWidth, Int iHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxCUDepth, Int aiPad[2] );
+  Void  destroy ();
+
+  /// wait for the next frame, the buffer stays valid until release() is called
+  TComPicYuv* pop     ( Bool& rbEof );
+  /// hand the buffer of the last popped frame back to the reader thread
+  Void        release ();
+};
+
+#endif // __TVIDEOIOYUVREADER__